@@ -8,6 +8,8 @@
 #include <avr/interrupt.h>
 #include "Common_Macros.h"
 #include "ADC.h"
+#include "TRACE.h"
+#include "POWER.h"
 
 /***************************************************************************************
  *                                      Global Variables                               *
@@ -15,12 +17,44 @@
 
  volatile uint16 g_ADC_Value = 0;
 
+ /* Set by the ADC interrupt when the requested conversion is completed */
+ static volatile boolean g_adcConversionComplete = FALSE;
+
+ /* Scan in progress: channel list, results and index of the channel being converted */
+ static const InputChannel_Select *g_adcScanChannels = NULL_PTR;
+ static volatile uint16 *g_adcScanResults = NULL_PTR;
+ static uint8 g_adcScanCount = 0;
+ static volatile uint8 g_adcScanIndex = 0;
+ static volatile boolean g_adcScanActive = FALSE;
+
 /***************************************************************************************
  *                                  Interrupt Service Routines                         *
  ***************************************************************************************/
  ISR(ADC_vect)
  {
+	 TRACE_EVENT(TRACE_EVENT_ISR_ENTRY, TRACE_ISR_ADC);
+
 	 g_ADC_Value = ADC;
+	 g_adcConversionComplete = TRUE;
+
+	 TRACE_EVENT(TRACE_EVENT_ADC_SAMPLE, g_ADC_Value);
+
+	 if (g_adcScanActive == TRUE)
+	 {
+		 g_adcScanResults[g_adcScanIndex] = g_ADC_Value;
+		 g_adcScanIndex++;
+
+		 if (g_adcScanIndex < g_adcScanCount)
+		 {
+			 /* Chain the next channel of the scan */
+			 ADMUX = (ADMUX & 0xE0) | (g_adcScanChannels[g_adcScanIndex]);
+			 SET_BIT(ADCSRA, ADSC);
+		 }
+		 else
+		 {
+			 g_adcScanActive = FALSE;
+		 }
+	 }
  }
 
 /****************************************************************************************
@@ -35,6 +69,7 @@
  * 4. Choose the required pre-scalar to make ADC operating frequency within a range (50KHz:200KHz).
  * 5. Enable the ADATE bit in ADCSRA Register to activate ADC Auto Trigger Source.
  * 6. By the Configuration of SFIOR Register, choose the ADC Auto Trigger Source from bits ADTS2:0.
+ * 7. In Single Conversion, the ADATE bit is cleared and the Auto Trigger Source is not used.
  */
 void ADC_Init(const ADC_ConfigType *Config_Ptr)
 {
@@ -44,30 +79,84 @@ void ADC_Init(const ADC_ConfigType *Config_Ptr)
 	SET_BIT(ADCSRA, ADIE);
 	ADCSRA = (ADCSRA & 0xF8) | (Config_Ptr -> ADC_Prescalar);
 
-	SET_BIT(ADCSRA, ADATE);
-	SFIOR = (SFIOR & 0x1F) | ((Config_Ptr -> Trigger_Source) << 5);
+	if (Config_Ptr -> Trigger_Source == Single_Conversion)
+	{
+		CLEAR_BIT(ADCSRA, ADATE);
+	}
+	else
+	{
+		SET_BIT(ADCSRA, ADATE);
+		SFIOR = (SFIOR & 0x1F) | ((Config_Ptr -> Trigger_Source) << 5);
+	}
 }
 
 /*
  * Description:
  * 1. Configure the ADMUX Register and choose the required ADC Channel.
  * 2. Start Conversion of the ADC.
- * 3. Wait for conversion to be completed and ADIF flag becomes = 1
- * 4. You can clear the flag by writing "One" or automatically by Hardware.
- * 5. return the ADC value.
+ * 3. Wait in Idle sleep for the conversion to be completed, the ADC interrupt clears ADIF automatically
+ *    by Hardware and reports the end of conversion, so the Global Interrupt Enable bit must be set.
+ *    ADC Noise Reduction sleep is not used: it stops clkIO, so the UART receiver would lose the bytes
+ *    the other nodes send at any time, and the SysTick and the PWM of Timer1 would freeze.
+ * 4. return the ADC value.
  */
 uint16 ADC_ReadChannel(InputChannel_Select Channel_Select)
 {
+	uint8 SREG_Value = SREG;
+
 	/* ADMUX & 1110 0000 (MUX4:0) | (0:7) */
 	ADMUX = (ADMUX & 0xE0) | (Channel_Select);
+
+	cli();
+	g_adcConversionComplete = FALSE;
+
+	/* Start Conversion */
 	SET_BIT(ADCSRA,ADSC);
 
-	/* Wait for conversion to complete, ADIF becomes '1' */
-	while(BIT_IS_CLEAR(ADCSRA,ADIF));
+	/* Wait for conversion to complete */
+	while(g_adcConversionComplete == FALSE)
+	{
+		Power_Sleep(POWER_IDLE);
+	}
+	SREG = SREG_Value;
 
-	/* Clear ADIF by write '1' to it */
-	SET_BIT(ADCSRA,ADIF);
+	/* Read the digital value saved by the ADC interrupt */
+	return g_ADC_Value;
+}
 
-	/* Read the digital value from the data register */
-	return ADC;
+/*
+ * Description:
+ * Start converting a list of channels in the background, one after the other.
+ * The ADC interrupt saves every result in Results_Ptr (same index as the channel) and starts
+ * the next channel, the CPU is free during the whole scan (~104 us per channel with F_CPU/8).
+ * Used in Single Conversion only, ADC_ReadChannel must not be called during a scan.
+ */
+void ADC_StartScan(const InputChannel_Select *Channels_Ptr, uint8 Num_Of_Channels, volatile uint16 *Results_Ptr)
+{
+	uint8 SREG_Value = SREG;
+
+	if (Num_Of_Channels == 0)
+	{
+		return;
+	}
+
+	cli();
+	g_adcScanChannels = Channels_Ptr;
+	g_adcScanResults = Results_Ptr;
+	g_adcScanCount = Num_Of_Channels;
+	g_adcScanIndex = 0;
+	g_adcScanActive = TRUE;
+
+	ADMUX = (ADMUX & 0xE0) | (Channels_Ptr[0]);
+	SET_BIT(ADCSRA, ADSC);
+	SREG = SREG_Value;
+}
+
+/*
+ * Description:
+ * Return TRUE when the last scan is completed (or no scan was started).
+ */
+boolean ADC_IsScanComplete(void)
+{
+	return (g_adcScanActive == TRUE) ? FALSE : TRUE;
 }
@@ -0,0 +1,132 @@
+/*****************************************************************************************************************
+ * File Name: CONFIG.h
+ * Date: 19/10/2026
+ * Driver: Runtime Configuration Stored in EEPROM Header File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include "Standard_Types.h"
+
+#ifndef CONFIG_H_
+#define CONFIG_H_
+
+/******************************************************************************************
+ *                                    Macros Definitions                                  *
+ ******************************************************************************************/
+
+/*
+ * Configuration block in the EEPROM, after the history log area:
+ * VERSION, VALUES[CONFIG_NUM_OF_PARAMS] (16-bit, little endian), CRC8
+ * CRC8 (polynomial 0x07) covers VERSION and VALUES. A block with another version or a bad CRC
+ * (erased EEPROM, torn save) is ignored and the defaults are used.
+ */
+#define CONFIG_EEPROM_START                  0x03C0
+#define CONFIG_VERSION                       2
+
+/* Keep some places of the EEPROM write queue free for the other users while saving */
+#define CONFIG_QUEUE_RESERVE                 4
+
+/*
+ * Commands received as LINK_COMMAND_TOPIC frames, the answer is a LINK_REPLY_TOPIC frame
+ * {CMD, ID, VALUE (16-bit), STATUS} (ID and VALUE are 0 for SAVE and DEFAULTS):
+ * GET      {CMD, ID}
+ * SET      {CMD, ID, VALUE}   applied at once, not saved
+ * SAVE     {CMD}              written in the background
+ * DEFAULTS {CMD}              applied at once, not saved
+ */
+#define CONFIG_COMMAND_GET                   0x10
+#define CONFIG_COMMAND_SET                   0x11
+#define CONFIG_COMMAND_SAVE                  0x12
+#define CONFIG_COMMAND_DEFAULTS              0x13
+
+/* STATUS of a reply */
+#define CONFIG_STATUS_OK                     0x00
+#define CONFIG_STATUS_BAD_ID                 0x01
+#define CONFIG_STATUS_OUT_OF_RANGE           0x02
+#define CONFIG_STATUS_BAD_LENGTH             0x03
+
+/*
+ * Read a parameter, e.g. CONFIG_VALUE(CONFIG_LED_RED_TEMPERATURE).
+ * The index is a constant, so this is one load from RAM like a literal.
+ */
+#define CONFIG_VALUE(ID)                     (g_config.Values[(ID)])
+
+/******************************************************************************************
+ *                                     Types Declaration                                  *
+ ******************************************************************************************/
+
+/* The parameters of the whole system, every node uses its own part of them */
+typedef enum
+{
+	CONFIG_LED_YELLOW_TEMPERATURE,     /* MCU2: Green < YELLOW <= Yellow < RED <= Red (C)     */
+	CONFIG_LED_RED_TEMPERATURE,        /* must follow CONFIG_LED_YELLOW_TEMPERATURE            */
+	CONFIG_LED_HYSTERESIS,             /* MCU2: a LED zone is left this far below it (C)      */
+	CONFIG_FAN_SPEED_THRESHOLD,        /* MCU2: ADC value which requests the fan (70% = 716)  */
+	CONFIG_FAN_SPEED_HYSTERESIS,       /* MCU2: the fan request is released this far below it */
+	CONFIG_EMERGENCY_SPEED,            /* MCU2: motor speed in emergency (25% = 256)          */
+	CONFIG_FAN_ON_CODE,                /* both: value of LINK_TOPIC_FAN_STATE for "fan on"    */
+	CONFIG_CONFIRM_SAMPLES,            /* both: samples needed to accept a new state          */
+	CONFIG_LOGGER_SAMPLE_PERIOD_MS,    /* MCU1: time between two logged temperatures          */
+	CONFIG_RATE_OF_RISE_LIMIT,         /* MCU1: fire alarm above this rise (0.01 C/s)         */
+	CONFIG_NUM_OF_PARAMS
+}Config_ParamId;
+
+typedef struct
+{
+	uint16 Values[CONFIG_NUM_OF_PARAMS];
+}Config_Type;
+
+/* Configuration in use, read it with CONFIG_VALUE and change it with Config_Set only */
+extern Config_Type g_config;
+
+/******************************************************************************************
+ *                                    Functions Prototypes                                *
+ ******************************************************************************************/
+
+/*
+ * Description:
+ * Load the configuration block from the EEPROM into g_config (blocking, called once at startup).
+ * Return FALSE if the block is not valid, then the defaults are used and the EEPROM is not touched.
+ */
+boolean Config_Init(void);
+
+/*
+ * Description:
+ * Change one parameter in RAM after checking its range (and the order of the LED thresholds).
+ * Return one of the CONFIG_STATUS values, g_config is not changed if it is not CONFIG_STATUS_OK.
+ */
+uint8 Config_Set(Config_ParamId Id, uint16 Value);
+
+/*
+ * Description:
+ * Put the default values back in RAM.
+ */
+void Config_RestoreDefaults(void);
+
+/*
+ * Description:
+ * Start writing g_config to the EEPROM, the bytes are queued by Config_Task.
+ */
+void Config_Save(void);
+
+/*
+ * Description:
+ * Queue the next bytes of a save to the EEPROM without waiting, to be called every cycle.
+ * A parameter changed during a save restarts it, so the block always matches its CRC.
+ */
+void Config_Task(void);
+
+/*
+ * Description:
+ * Answer the configuration commands of a LINK_COMMAND_TOPIC frame with a LINK_REPLY_TOPIC frame
+ * to Source. Return FALSE if PAYLOAD[0] is not a configuration command.
+ */
+boolean Config_HandleCommand(uint8 Source, const uint8 *Payload_Ptr, uint8 Length);
+
+/*
+ * Description:
+ * Set the function called after g_config changed (SET or DEFAULTS command), the application
+ * rebuilds the settings it derived from the configuration there.
+ */
+void Config_SetCallBack(void(*a_ptr)(void));
+
+#endif /* CONFIG_H_ */
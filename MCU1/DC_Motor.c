@@ -7,6 +7,7 @@
 #include "GPIO.h"
 #include "DC_Motor.h"
 #include "TIMER1.h"
+#include "PROFILER.h"
 
 /*
  * DESCRIPTION:
@@ -32,23 +33,31 @@ void DcMotor_Init(void)
  */
 void DcMotor_Rotate(DcMotor_State state, uint16 speed)
 {
-	if (state == STOP)
+	PROF_BEGIN(PROF_DC_MOTOR_ROTATE);
+
+	/* A command out of range never reaches the driver pins or the PWM */
+	if (speed > DC_MOTOR_PWM_TOP)
+	{
+		speed = DC_MOTOR_PWM_TOP;
+	}
+
+	if ((state != CW) && (state != A_CW))
 	{
 		/* STOP MODE: A = LOW, B = LOW */
 		GPIO_WritePin(DC_MOTOR_IN1_PORT_ID,DC_MOTOR_IN1_PIN_ID,LOGIC_LOW);
-		GPIO_WritePin(DC_MOTOR_IN1_PORT_ID,DC_MOTOR_IN2_PIN_ID,LOGIC_LOW);
+		GPIO_WritePin(DC_MOTOR_IN2_PORT_ID,DC_MOTOR_IN2_PIN_ID,LOGIC_LOW);
 	}
 	else if (state == CW)
 	{
 		/* CLOCk WISE MODE: A = LOW, B = HIGH */
 		GPIO_WritePin(DC_MOTOR_IN1_PORT_ID,DC_MOTOR_IN1_PIN_ID,LOGIC_LOW);
-		GPIO_WritePin(DC_MOTOR_IN1_PORT_ID,DC_MOTOR_IN2_PIN_ID,LOGIC_HIGH);
+		GPIO_WritePin(DC_MOTOR_IN2_PORT_ID,DC_MOTOR_IN2_PIN_ID,LOGIC_HIGH);
 	}
 	else if (state == A_CW)
 	{
 		/* Anti-CLOCk WISE MODE: A = HIGH, B = LOW */
 		GPIO_WritePin(DC_MOTOR_IN1_PORT_ID,DC_MOTOR_IN1_PIN_ID,LOGIC_HIGH);
-		GPIO_WritePin(DC_MOTOR_IN1_PORT_ID,DC_MOTOR_IN2_PIN_ID,LOGIC_LOW);
+		GPIO_WritePin(DC_MOTOR_IN2_PORT_ID,DC_MOTOR_IN2_PIN_ID,LOGIC_LOW);
 	}
 
 	/* Pass the Speed of the Motor to PWM Function to calculate duty cycle and hence Timer0 Compare  Value */
@@ -57,4 +66,5 @@ void DcMotor_Rotate(DcMotor_State state, uint16 speed)
 	/* Pass the Speed of the Motor to PWM Function to calculate duty cycle and hence Timer1 Compare  Value */
 	TIMER1_PWM_Start(speed);
 
+	PROF_END(PROF_DC_MOTOR_ROTATE);
 }
@@ -0,0 +1,149 @@
+/*******************************************************************************************************************
+ * File Name: EEPROM.c
+ * Date: 19/10/2026
+ * Driver: ATmega32 Internal EEPROM Driver Source File
+ * Author: Youssef Zaki
+ ******************************************************************************************************************/
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "EEPROM.h"
+#include "POWER.h"
+#include "Common_Macros.h"
+
+/*******************************************************************************************
+ *                                      Types Declaration                                  *
+ *******************************************************************************************/
+
+typedef struct
+{
+	uint16 Address;
+	uint8 Data;
+}EEPROM_WriteType;
+
+/***************************************************************************************
+ *                                         Global Variables                            *
+ ***************************************************************************************/
+
+/* Write queue emptied by the EE_RDY interrupt */
+static volatile EEPROM_WriteType g_eepromQueue[EEPROM_WRITE_QUEUE_SIZE];
+static volatile uint8 g_eepromHead = 0;
+static volatile uint8 g_eepromTail = 0;
+
+/*******************************************************************************
+ *                       Interrupt Service Routines                            *
+ *******************************************************************************/
+
+/*
+ * EEPROM Ready: the previous write is finished (EEWE = 0), start the next queued write.
+ * Bytes which already hold the value are skipped, the interrupt is disabled when the queue is empty.
+ */
+ISR(EE_RDY_vect)
+{
+	uint16 Address;
+	uint8 Data;
+
+	while (g_eepromTail != g_eepromHead)
+	{
+		Address = g_eepromQueue[g_eepromTail].Address;
+		Data = g_eepromQueue[g_eepromTail].Data;
+		g_eepromTail = (g_eepromTail + 1) & (EEPROM_WRITE_QUEUE_SIZE - 1);
+
+		/* Read the old value first */
+		EEAR = Address;
+		SET_BIT(EECR, EERE);
+
+		if (EEDR != Data)
+		{
+			/* EEWE must be set within four cycles after EEMWE, the interrupts are already disabled here */
+			EEDR = Data;
+			SET_BIT(EECR, EEMWE);
+			SET_BIT(EECR, EEWE);
+			return;
+		}
+	}
+
+	/* Nothing left to write */
+	CLEAR_BIT(EECR, EERIE);
+}
+
+/****************************************************************************************
+ *                                     Functions Definitions                            *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Function to queue one byte to be written in the EEPROM without waiting.
+ * 1. The byte is put in the write queue and the EE_RDY interrupt (EERIE) is enabled.
+ * 2. The EE_RDY interrupt starts the writes one by one, every write takes about 8.5 ms.
+ * 3. A byte which already holds the same value is not written again to save the EEPROM cells.
+ * Return FALSE if the queue is full, the byte is not written.
+ * The Global Interrupt must be enabled.
+ */
+boolean EEPROM_WriteByte(uint16 Address, uint8 Data)
+{
+	uint8 Next_Head;
+	uint8 SREG_Value = SREG;
+
+	cli();
+	Next_Head = (g_eepromHead + 1) & (EEPROM_WRITE_QUEUE_SIZE - 1);
+
+	if (Next_Head == g_eepromTail)
+	{
+		SREG = SREG_Value;
+		return FALSE;
+	}
+
+	g_eepromQueue[g_eepromHead].Address = Address;
+	g_eepromQueue[g_eepromHead].Data = Data;
+	g_eepromHead = Next_Head;
+
+	/* The interrupt fires as soon as the EEPROM is ready */
+	SET_BIT(EECR, EERIE);
+	SREG = SREG_Value;
+
+	return TRUE;
+}
+
+/*
+ * Description:
+ * Function to read one byte from the EEPROM.
+ * The read waits (in Idle sleep) until all the queued writes are finished, so call it at startup
+ * or when EEPROM_IsBusy returns FALSE to keep the control loop running.
+ */
+uint8 EEPROM_ReadByte(uint16 Address)
+{
+	uint8 Data;
+	uint8 SREG_Value = SREG;
+
+	cli();
+	while (EEPROM_IsBusy())
+	{
+		/* The EE_RDY interrupt wakes the CPU up after every write */
+		Power_Sleep(POWER_IDLE);
+	}
+
+	EEAR = Address;
+	SET_BIT(EECR, EERE);
+	Data = EEDR;
+	SREG = SREG_Value;
+
+	return Data;
+}
+
+/*
+ * Description:
+ * Return TRUE while queued writes are not finished yet.
+ */
+boolean EEPROM_IsBusy(void)
+{
+	return ((g_eepromHead != g_eepromTail) || BIT_IS_SET(EECR, EEWE)) ? TRUE : FALSE;
+}
+
+/*
+ * Description:
+ * Return the number of free places in the write queue.
+ */
+uint8 EEPROM_GetFreeSpace(void)
+{
+	return (EEPROM_WRITE_QUEUE_SIZE - 1) - ((g_eepromHead - g_eepromTail) & (EEPROM_WRITE_QUEUE_SIZE - 1));
+}
@@ -0,0 +1,149 @@
+/*****************************************************************************************************************
+ * File Name: FSM.c
+ * Date: 19/10/2026
+ * Driver: Table-Driven Hierarchical State Machine Source File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include <avr/pgmspace.h>
+#include "FSM.h"
+#include "TRACE.h"
+
+/***************************************************************************************
+ *                                      Private Functions                              *
+ ***************************************************************************************/
+
+static uint8 Fsm_GetParent(const Fsm_ConfigType *Config_Ptr, uint8 State)
+{
+	return pgm_read_byte(&Config_Ptr -> States_Ptr[State].Parent);
+}
+
+/* Run an entry or exit action read from the flash */
+static void Fsm_RunAction(void (* const *Action_Ptr)(void))
+{
+	void (*Action)(void) = (void (*)(void))pgm_read_ptr(Action_Ptr);
+
+	if (Action != NULL_PTR)
+	{
+		(*Action)();
+	}
+}
+
+/* Leave the states from Source (FSM_NO_PARENT at startup) up to the first ancestor of Target, then enter down to Target */
+static void Fsm_Transition(Fsm_Type *Fsm_Ptr, uint8 Source, uint8 Target)
+{
+	const Fsm_ConfigType *Config_Ptr = Fsm_Ptr -> Config_Ptr;
+	uint8 Path[FSM_MAX_DEPTH];
+	uint8 Length = 0;
+	uint8 State;
+	uint8 i;
+
+	/* Path[0] is the target, then its parents up to its top state */
+	for (State = Target; (State != FSM_NO_PARENT) && (Length < FSM_MAX_DEPTH); State = Fsm_GetParent(Config_Ptr, State))
+	{
+		Path[Length] = State;
+		Length++;
+	}
+
+	/* Exit until a state which is also a parent of the target, the target itself is left and entered again */
+	i = Length;
+	State = Source;
+	while (State != FSM_NO_PARENT)
+	{
+		for (i = 1; (i < Length) && (Path[i] != State); i++);
+		if (i < Length)
+		{
+			break;
+		}
+
+		Fsm_RunAction(&Config_Ptr -> States_Ptr[State].Exit_Ptr);
+		State = Fsm_GetParent(Config_Ptr, State);
+		i = Length;
+	}
+
+	Fsm_Ptr -> State = Target;
+	TRACE_EVENT(TRACE_EVENT_STATE_CHANGE, Target);
+
+	/* Enter the states below the shared parent */
+	while (i > 0)
+	{
+		i--;
+		Fsm_RunAction(&Config_Ptr -> States_Ptr[Path[i]].Entry_Ptr);
+	}
+}
+
+/****************************************************************************************
+ *                                     Functions Definitions                            *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Save the tables and enter the initial state, the entry actions run from its top state down.
+ */
+void Fsm_Init(Fsm_Type *Fsm_Ptr, const Fsm_ConfigType *Config_Ptr)
+{
+	Fsm_Ptr -> Config_Ptr = Config_Ptr;
+	Fsm_Transition(Fsm_Ptr, FSM_NO_PARENT, Config_Ptr -> Initial_State);
+}
+
+/*
+ * Description:
+ * Look the event up in the row of the current state, then in the rows of its parents until a
+ * cell is not FSM_UNHANDLED. On a transition, the exit actions run up to the first state shared
+ * with the target, then the entry actions down to the target, and the new state is traced.
+ * Return TRUE if the state changed (or was left and entered again).
+ */
+boolean Fsm_Dispatch(Fsm_Type *Fsm_Ptr, uint8 Event)
+{
+	const Fsm_ConfigType *Config_Ptr = Fsm_Ptr -> Config_Ptr;
+	uint8 State = Fsm_Ptr -> State;
+	uint8 Target = FSM_UNHANDLED;
+	uint8 Depth;
+
+	for (Depth = 0; (State != FSM_NO_PARENT) && (Depth < FSM_MAX_DEPTH); Depth++)
+	{
+		Target = pgm_read_byte(&Config_Ptr -> Transitions_Ptr[((uint16)State * Config_Ptr -> Num_Of_Events) + Event]);
+		if (Target != FSM_UNHANDLED)
+		{
+			break;
+		}
+		State = Fsm_GetParent(Config_Ptr, State);
+	}
+
+	if ((Target == FSM_UNHANDLED) || (Target == FSM_IGNORE))
+	{
+		return FALSE;
+	}
+
+	Fsm_Transition(Fsm_Ptr, Fsm_Ptr -> State, Target);
+	return TRUE;
+}
+
+/*
+ * Description:
+ * Return the current (leaf) state.
+ */
+uint8 Fsm_GetState(const Fsm_Type *Fsm_Ptr)
+{
+	return Fsm_Ptr -> State;
+}
+
+/*
+ * Description:
+ * Return TRUE if the current state is State or one of its children.
+ */
+boolean Fsm_IsIn(const Fsm_Type *Fsm_Ptr, uint8 State)
+{
+	uint8 Current = Fsm_Ptr -> State;
+	uint8 Depth;
+
+	for (Depth = 0; (Current != FSM_NO_PARENT) && (Depth < FSM_MAX_DEPTH); Depth++)
+	{
+		if (Current == State)
+		{
+			return TRUE;
+		}
+		Current = Fsm_GetParent(Fsm_Ptr -> Config_Ptr, Current);
+	}
+
+	return FALSE;
+}
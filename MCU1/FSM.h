@@ -0,0 +1,88 @@
+/*****************************************************************************************************************
+ * File Name: FSM.h
+ * Date: 19/10/2026
+ * Driver: Table-Driven Hierarchical State Machine Header File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include "Standard_Types.h"
+
+#ifndef FSM_H_
+#define FSM_H_
+
+/******************************************************************************************
+ *                                    Macros Definitions                                  *
+ ******************************************************************************************/
+
+/*
+ * A machine is described by two tables kept in the flash (PROGMEM):
+ * 1. States: {Parent, Entry, Exit} indexed by the state id.
+ * 2. Transitions: one row per state and one column per event, the cell is the target state,
+ *    FSM_IGNORE (the event is consumed) or FSM_UNHANDLED (the parent state decides).
+ * An event is dispatched by reading one cell per level of the hierarchy, so adding a state or
+ * an event costs table rows and no code. The current state is always a leaf state, so the
+ * targets of the transitions must be leaf states too.
+ */
+#define FSM_NO_PARENT                        0xFF
+#define FSM_UNHANDLED                        0xFF
+#define FSM_IGNORE                           0xFE
+
+/* Levels of the state hierarchy (a top state and its children are 2 levels) */
+#define FSM_MAX_DEPTH                        4
+
+/******************************************************************************************
+ *                                     Types Declaration                                  *
+ ******************************************************************************************/
+
+typedef struct
+{
+	uint8 Parent;                       /* FSM_NO_PARENT for a top state         */
+	void (*Entry_Ptr)(void);            /* NULL_PTR when there is nothing to do  */
+	void (*Exit_Ptr)(void);
+}Fsm_StateType;
+
+typedef struct
+{
+	const Fsm_StateType *States_Ptr;    /* PROGMEM, indexed by the state id                      */
+	const uint8 *Transitions_Ptr;       /* PROGMEM, [State][Event] flattened row by row          */
+	uint8 Num_Of_Events;
+	uint8 Initial_State;
+}Fsm_ConfigType;
+
+typedef struct
+{
+	const Fsm_ConfigType *Config_Ptr;
+	uint8 State;
+}Fsm_Type;
+
+/******************************************************************************************
+ *                                    Functions Prototypes                                *
+ ******************************************************************************************/
+
+/*
+ * Description:
+ * Save the tables and enter the initial state, the entry actions run from its top state down.
+ */
+void Fsm_Init(Fsm_Type *Fsm_Ptr, const Fsm_ConfigType *Config_Ptr);
+
+/*
+ * Description:
+ * Look the event up in the row of the current state, then in the rows of its parents until a
+ * cell is not FSM_UNHANDLED. On a transition, the exit actions run up to the first state shared
+ * with the target, then the entry actions down to the target, and the new state is traced.
+ * Return TRUE if the state changed (or was left and entered again).
+ */
+boolean Fsm_Dispatch(Fsm_Type *Fsm_Ptr, uint8 Event);
+
+/*
+ * Description:
+ * Return the current (leaf) state.
+ */
+uint8 Fsm_GetState(const Fsm_Type *Fsm_Ptr);
+
+/*
+ * Description:
+ * Return TRUE if the current state is State or one of its children.
+ */
+boolean Fsm_IsIn(const Fsm_Type *Fsm_Ptr, uint8 State);
+
+#endif /* FSM_H_ */
@@ -20,7 +20,7 @@
 void GPIO_SetupPinDirection(uint8 Port_Num, uint8 Pin_Num, uint8 GPIO_PinDirectionType)
 {
 	/* CHECK IF THE CORRECT NUMBER OF PORT AND NUMBER OF PIN ARE ENTERED */
-	if ((Port_Num >= PORTA_ID && Port_Num <= PORTD_ID) && (Pin_Num >= PIN0_ID && Pin_Num <= PIN7_ID))
+	if ((Port_Num < NUM_OF_PORTS) && (Pin_Num < NUM_OF_PINS_PER_PORT))
 	{
 		switch (Port_Num)
 		{
@@ -84,7 +84,7 @@ void GPIO_SetupPinDirection(uint8 Port_Num, uint8 Pin_Num, uint8 GPIO_PinDirecti
 void GPIO_WritePin(uint8 Port_Num, uint8 Pin_Num, uint8 value)
 {
 	/* CHECK IF THE CORRECT NUMBER OF PORT AND NUMBER OF PIN ARE ENTERED */
-	if ((Port_Num >= PORTA_ID && Port_Num <= PORTD_ID) && (Pin_Num >= PIN0_ID && Pin_Num <= PIN7_ID))
+	if ((Port_Num < NUM_OF_PORTS) && (Pin_Num < NUM_OF_PINS_PER_PORT))
 	{
 		switch(Port_Num)
 		{
@@ -150,7 +150,7 @@ uint8 GPIO_ReadPin(uint8 Port_Num, uint8 Pin_Num)
 	uint8 Pin_Value = LOGIC_LOW;
 
 	/* CHECK IF THE CORRECT NUMBER OF PORT AND NUMBER OF PIN ARE ENTERED */
-	if ( (Port_Num >= PORTA_ID && Port_Num <= PORTD_ID) && (Pin_Num >= PIN0_ID && Pin_Num <= PIN7_ID) )
+	if ((Port_Num < NUM_OF_PORTS) && (Pin_Num < NUM_OF_PINS_PER_PORT))
 	{
 		switch(Port_Num)
 		{
@@ -214,7 +214,7 @@ uint8 GPIO_ReadPin(uint8 Port_Num, uint8 Pin_Num)
 void GPIO_SetupPortDirection(uint8 Port_Num, GPIO_PortDirectionType direction)
 {
 	/* CHECK IF THE CORRECT NUMBER OF PORT IS ENTERED */
-	if ((Port_Num >= PORTA_ID && Port_Num <= PORTD_ID))
+	if (Port_Num < NUM_OF_PORTS)
 	{
 		/* "direction" VALUE FROM 0x00 to 0xFF */
 		switch (Port_Num)
@@ -247,7 +247,7 @@ void GPIO_SetupPortDirection(uint8 Port_Num, GPIO_PortDirectionType direction)
 void GPIO_WritePORT(uint8 Port_Num, uint8 value)
 {
 	/* CHECK IF THE CORRECT NUMBER OF PORT IS ENTERED */
-	if ((Port_Num >= PORTA_ID && Port_Num <= PORTD_ID))
+	if (Port_Num < NUM_OF_PORTS)
 	{
 		switch (Port_Num)
 		{
@@ -282,7 +282,7 @@ uint8 GPIO_ReadPORT(uint8 Port_Num)
 	uint8 Port_Value = 0x00;
 
 	/* CHECK IF THE CORRECT NUMBER OF PORT IS ENTERED */
-	if ((Port_Num >= PORTA_ID && Port_Num <= PORTD_ID))
+	if (Port_Num < NUM_OF_PORTS)
 	{
 		switch (Port_Num)
 		{
@@ -0,0 +1,88 @@
+/*****************************************************************************************************************
+ * File Name: HYSTERESIS.c
+ * Date: 19/10/2026
+ * Driver: Threshold with Hysteresis and N-Sample Confirmation Source File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include "HYSTERESIS.h"
+
+/****************************************************************************************
+ *                                     Functions Definitions                            *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Attach the configuration to the object and start with HYSTERESIS_LEVEL_UNKNOWN, so the
+ * first confirmed level is always reported as a change.
+ */
+void Hysteresis_Init(Hysteresis_Type *Obj_Ptr, const Hysteresis_ConfigType *Config_Ptr)
+{
+	Obj_Ptr -> Config_Ptr = Config_Ptr;
+	Obj_Ptr -> Level = HYSTERESIS_LEVEL_UNKNOWN;
+	Obj_Ptr -> Candidate = HYSTERESIS_LEVEL_UNKNOWN;
+	Obj_Ptr -> Count = 0;
+}
+
+/*
+ * Description:
+ * Feed one sample, return TRUE only when the confirmed level changes.
+ * 1. Start from the confirmed level and move up while the value reaches the next threshold.
+ * 2. Move down while the value is more than Band below the threshold of the current level.
+ * 3. Count the consecutive samples of a new level and accept it after Confirm_Samples.
+ */
+boolean Hysteresis_Update(Hysteresis_Type *Obj_Ptr, uint16 Value)
+{
+	const Hysteresis_ConfigType *Config_Ptr = Obj_Ptr -> Config_Ptr;
+	uint8 Level = Obj_Ptr -> Level;
+
+	if (Level == HYSTERESIS_LEVEL_UNKNOWN)
+	{
+		/* No history, so no hysteresis: search from the lowest level */
+		Level = 0;
+	}
+	else
+	{
+		while ((Level > 0) && ((uint32)Value + Config_Ptr -> Band < Config_Ptr -> Thresholds[Level - 1]))
+		{
+			Level--;
+		}
+	}
+
+	while ((Level < Config_Ptr -> Num_Of_Thresholds) && (Value >= Config_Ptr -> Thresholds[Level]))
+	{
+		Level++;
+	}
+
+	if (Level == Obj_Ptr -> Level)
+	{
+		/* Still in the confirmed level, forget any candidate */
+		Obj_Ptr -> Count = 0;
+		return FALSE;
+	}
+
+	if (Level != Obj_Ptr -> Candidate)
+	{
+		Obj_Ptr -> Candidate = Level;
+		Obj_Ptr -> Count = 0;
+	}
+
+	Obj_Ptr -> Count++;
+
+	if (Obj_Ptr -> Count >= Config_Ptr -> Confirm_Samples)
+	{
+		Obj_Ptr -> Level = Level;
+		Obj_Ptr -> Count = 0;
+		return TRUE;
+	}
+
+	return FALSE;
+}
+
+/*
+ * Description:
+ * Return the confirmed level (0 .. Num_Of_Thresholds) or HYSTERESIS_LEVEL_UNKNOWN.
+ */
+uint8 Hysteresis_GetLevel(const Hysteresis_Type *Obj_Ptr)
+{
+	return Obj_Ptr -> Level;
+}
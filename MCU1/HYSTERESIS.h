@@ -0,0 +1,68 @@
+/*****************************************************************************************************************
+ * File Name: HYSTERESIS.h
+ * Date: 19/10/2026
+ * Driver: Threshold with Hysteresis and N-Sample Confirmation Header File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include "Standard_Types.h"
+
+#ifndef HYSTERESIS_H_
+#define HYSTERESIS_H_
+
+/******************************************************************************************
+ *                                    Macros Definitions                                  *
+ ******************************************************************************************/
+
+/* Level of an object which has not confirmed any level yet */
+#define HYSTERESIS_LEVEL_UNKNOWN             0xFF
+
+/******************************************************************************************
+ *                                     Types Declaration                                  *
+ ******************************************************************************************/
+
+/*
+ * Thresholds must be in ascending order. The value is in level i when it is >= Thresholds[i-1]
+ * and < Thresholds[i], so N thresholds give N+1 levels.
+ * Moving up to a level happens at its threshold, moving down needs the value to fall more
+ * than Band below it. A new level is accepted after Confirm_Samples consecutive samples.
+ */
+typedef struct
+{
+	const uint16 *Thresholds;
+	uint8 Num_Of_Thresholds;
+	uint16 Band;
+	uint8 Confirm_Samples;
+}Hysteresis_ConfigType;
+
+typedef struct
+{
+	const Hysteresis_ConfigType *Config_Ptr;
+	uint8 Level;
+	uint8 Candidate;
+	uint8 Count;
+}Hysteresis_Type;
+
+/******************************************************************************************
+ *                                    Functions Prototypes                                *
+ ******************************************************************************************/
+
+/*
+ * Description:
+ * Attach the configuration to the object and start with HYSTERESIS_LEVEL_UNKNOWN, so the
+ * first confirmed level is always reported as a change.
+ */
+void Hysteresis_Init(Hysteresis_Type *Obj_Ptr, const Hysteresis_ConfigType *Config_Ptr);
+
+/*
+ * Description:
+ * Feed one sample, return TRUE only when the confirmed level changes.
+ */
+boolean Hysteresis_Update(Hysteresis_Type *Obj_Ptr, uint16 Value);
+
+/*
+ * Description:
+ * Return the confirmed level (0 .. Num_Of_Thresholds) or HYSTERESIS_LEVEL_UNKNOWN.
+ */
+uint8 Hysteresis_GetLevel(const Hysteresis_Type *Obj_Ptr);
+
+#endif /* HYSTERESIS_H_ */
@@ -0,0 +1,69 @@
+/*******************************************************************************************************************
+ * File Name: INT0.c
+ * Date: 19/10/2026
+ * Driver: ATmega32 External Interrupt 0 Driver Source File
+ * Author: Youssef Zaki
+ ******************************************************************************************************************/
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "INT0.h"
+#include "GPIO.h"
+#include "Common_Macros.h"
+
+/***************************************************************************************
+ *                                         Global Variables                            *
+ ***************************************************************************************/
+/* Global variables to hold the address of the call back function in the application */
+static void (* volatile g_int0CallBackPtr)(void) = NULL_PTR;
+
+/*******************************************************************************
+ *                       Interrupt Service Routines                            *
+ *******************************************************************************/
+ISR(INT0_vect)
+{
+	if(g_int0CallBackPtr != NULL_PTR)
+	{
+		/* Call the Call Back function in the application after the edge is detected */
+		(*g_int0CallBackPtr)();
+	}
+}
+
+/****************************************************************************************
+ *                                      Functions Definitions                           *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * 1. Setup INT0/PD2 pin as input pin through the GPIO driver.
+ * 2. Configure the interrupt sense control by ISC01:0 bits in MCUCR Register.
+ * 3. Clear any old request flag INTF0 in GIFR and enable INT0 bit in GICR Register.
+ */
+void INT0_Init(INT0_SenseControl Sense)
+{
+	GPIO_SetupPinDirection(PORTD_ID, PIN2_ID, INPUT_PIN);
+
+	/* MCUCR & 1111 1100 (ISC01:0) | Sense */
+	MCUCR = (MCUCR & 0xFC) | Sense;
+
+	/* Clear the flag by writing '1' to it, then enable the interrupt */
+	GIFR = (1<<INTF0);
+	SET_BIT(GICR, INT0);
+}
+
+/*
+ * Description:
+ * Function to disable the External Interrupt 0.
+ */
+void INT0_DeInit(void)
+{
+	CLEAR_BIT(GICR, INT0);
+}
+
+/*
+ * Description:
+ * Function to set the Call Back function address.
+ */
+void INT0_SetCallBack(void(*a_ptr)(void))
+{
+	g_int0CallBackPtr = a_ptr;
+}
@@ -0,0 +1,46 @@
+/*******************************************************************************************************************
+ * File Name: INT0.h
+ * Date: 19/10/2026
+ * Driver: ATmega32 External Interrupt 0 Driver Header File
+ * Author: Youssef Zaki
+ ******************************************************************************************************************/
+#include "Standard_Types.h"
+
+#ifndef INT0_H_
+#define INT0_H_
+
+/*******************************************************************************************
+ *                                      Types Declaration                                  *
+ *******************************************************************************************/
+
+/* Values of ISC01:0 bits in MCUCR Register */
+typedef enum
+{
+	INT0_Low_Level, INT0_Any_Logical_Change, INT0_Falling_Edge, INT0_Rising_Edge
+}INT0_SenseControl;
+
+/*******************************************************************************
+ *                              Functions Prototypes                           *
+ *******************************************************************************/
+
+/*
+ * Description:
+ * 1. Setup INT0/PD2 pin as input pin through the GPIO driver.
+ * 2. Configure the interrupt sense control by ISC01:0 bits in MCUCR Register.
+ * 3. Clear any old request flag INTF0 in GIFR and enable INT0 bit in GICR Register.
+ */
+void INT0_Init(INT0_SenseControl Sense);
+
+/*
+ * Description:
+ * Function to disable the External Interrupt 0.
+ */
+void INT0_DeInit(void);
+
+/*
+ * Description:
+ * Function to set the Call Back function address.
+ */
+void INT0_SetCallBack(void(*a_ptr)(void));
+
+#endif /* INT0_H_ */
@@ -0,0 +1,1050 @@
+/*****************************************************************************************************************
+ * File Name: LINK.c
+ * Date: 19/10/2026
+ * Driver: Inter-MCU Publish/Subscribe Link Source File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include "LINK.h"
+#include "UART.h"
+#include "SYSTICK.h"
+#include "TRACE.h"
+
+/******************************************************************************************
+ *                                     Types Declaration                                  *
+ ******************************************************************************************/
+
+typedef enum
+{
+	LINK_WAIT_SOF, LINK_WAIT_SOURCE, LINK_WAIT_TOPIC, LINK_WAIT_LEN, LINK_WAIT_PAYLOAD, LINK_WAIT_CRC
+}Link_ParserState;
+
+/* Publisher side of a topic */
+typedef struct
+{
+	uint16 Last_Value;
+	uint16 Last_Time;
+	boolean Sent;
+	uint16 Offered_Value;          /* last value given to Link_Publish, sent in the turn of an actuator node */
+	boolean Offered;
+}Link_PublisherType;
+
+/* Subscriber side of a topic */
+typedef struct
+{
+	uint16 Value;
+	boolean Valid;
+}Link_CacheType;
+
+/***************************************************************************************
+ *                                         Global Variables                            *
+ ***************************************************************************************/
+
+static const Link_ConfigType *g_linkConfigPtr = NULL_PTR;
+
+static void (*g_linkCallBackPtr)(uint8 Source, Link_TopicId Topic, uint16 Value) = NULL_PTR;
+static void (*g_linkCommandCallBackPtr)(uint8 Source, const uint8 *Payload_Ptr, uint8 Length) = NULL_PTR;
+
+static Link_PublisherType g_linkPublishers[LINK_NUM_OF_TOPICS];
+static Link_CacheType g_linkCache[LINK_NUM_OF_TOPICS];
+static Link_StatisticsType g_linkStats;
+
+/* Zone summary: last one sent (the publisher state is the one of LINK_TOPIC_TEMPERATURE) and last one received */
+static Link_ZonesType g_linkZonesSent;
+static Link_ZonesType g_linkZones;
+static boolean g_linkZonesValid = FALSE;
+
+/* Link supervision */
+static Link_StateType g_linkState = LINK_DOWN;
+static uint16 g_linkLastRxTime;
+static uint16 g_linkDownTime;
+static uint8 g_linkSyncFrames;
+
+/* Retransmit requests */
+static boolean g_linkNakPending;
+static uint16 g_linkLastNakTime;
+
+/* Medium access: turns of the actuator nodes given by the sensor node */
+static boolean g_linkPolled;           /* actuator node: polled, the turn is taken at the end of Link_Poll */
+static uint8 g_linkPollNode;           /* sensor node: turn given last, Num_Of_Polled_Nodes is the service PC */
+static uint16 g_linkPollTime;
+static uint16 g_linkPollPeriod;
+static boolean g_linkPollAnswered;
+static uint8 g_linkAliveNodes;         /* sensor node: bit i set while actuator node i answers its turns   */
+
+/* Actuator node: frame given to Link_Send, sent in the next turn */
+static boolean g_linkTxQueued;
+static uint8 g_linkTxDestination;
+static uint8 g_linkTxTopic;
+static uint8 g_linkTxLength;
+static uint8 g_linkTxPayload[LINK_MAX_PAYLOAD];
+
+#if (LINK_BENCHMARK_ENABLE == 1)
+/* Benchmark receiver */
+static uint16 g_benchFrames;
+static uint16 g_benchLost;
+static uint16 g_benchSequence;
+static uint16 g_benchFirstTime;
+static uint16 g_benchLastTime;
+#endif
+
+/* Receive parser */
+static Link_ParserState g_rxState = LINK_WAIT_SOF;
+static uint8 g_rxSource;
+static uint8 g_rxTopic;
+static uint8 g_rxLength;
+static uint8 g_rxIndex;
+static uint8 g_rxCrc;
+static uint8 g_rxPayload[LINK_MAX_PAYLOAD];
+
+/***************************************************************************************
+ *                                      Private Functions                              *
+ ***************************************************************************************/
+
+/* CRC-8 with polynomial x^8 + x^2 + x + 1 (0x07), bit by bit to keep the flash small */
+static uint8 Link_Crc8Update(uint8 Crc, uint8 Byte)
+{
+	uint8 Bit;
+
+	Crc ^= Byte;
+	for (Bit = 0; Bit < 8; Bit++)
+	{
+		Crc = (Crc & 0x80) ? (uint8)((Crc << 1) ^ 0x07) : (uint8)(Crc << 1);
+	}
+
+	return Crc;
+}
+
+/* Send one frame: ADDRESS, SOF, SOURCE, TOPIC, LEN, PAYLOAD, CRC8 (SOURCE is another node for a relayed frame) */
+static void Link_SendFrameFrom(uint8 Source, uint8 Destination, uint8 Topic, const uint8 *Payload_Ptr, uint8 Length)
+{
+	uint8 Crc = 0;
+	uint8 i;
+
+	UART_SendAddress(Destination);
+	UART_SendByte(LINK_SOF);
+
+	UART_SendByte(Source);
+	Crc = Link_Crc8Update(Crc, Source);
+
+	UART_SendByte(Topic);
+	Crc = Link_Crc8Update(Crc, Topic);
+
+	UART_SendByte(Length);
+	Crc = Link_Crc8Update(Crc, Length);
+
+	for (i = 0; i < Length; i++)
+	{
+		UART_SendByte(Payload_Ptr[i]);
+		Crc = Link_Crc8Update(Crc, Payload_Ptr[i]);
+	}
+
+	UART_SendByte(Crc);
+
+	g_linkStats.Sent_Bytes += Length + LINK_FRAME_OVERHEAD;
+}
+
+/* Send one frame of this node, an actuator node reaches the service PC through the sensor node */
+static void Link_SendFrame(uint8 Destination, uint8 Topic, const uint8 *Payload_Ptr, uint8 Length)
+{
+	if ((Destination == LINK_SERVICE_ADDRESS) && (g_linkConfigPtr -> Node_Address != LINK_SENSOR_NODE_ADDRESS))
+	{
+		Destination = LINK_SENSOR_NODE_ADDRESS;
+	}
+
+	Link_SendFrameFrom(g_linkConfigPtr -> Node_Address, Destination, Topic, Payload_Ptr, Length);
+}
+
+/* Sensor node: address of the node which has the turn, the service PC has the turn after the last actuator node */
+static uint8 Link_PolledAddress(void)
+{
+	if (g_linkPollNode >= g_linkConfigPtr -> Num_Of_Polled_Nodes)
+	{
+		return LINK_SERVICE_ADDRESS;
+	}
+
+	return LINK_ACTUATOR_BASE_ADDRESS + g_linkPollNode;
+}
+
+/* The sensor node owns the bus, an actuator node only during its turn */
+static boolean Link_OwnsBus(void)
+{
+	return (g_linkConfigPtr -> Node_Address == LINK_SENSOR_NODE_ADDRESS) || (g_linkPolled == TRUE);
+}
+
+/* Keep a received value in the cache and give it to the application, return FALSE if it is out of range */
+static boolean Link_StoreValue(Link_TopicId Topic, uint16 Value)
+{
+	if (Value > g_linkConfigPtr -> Topics_Ptr[Topic].Max_Value)
+	{
+		g_linkStats.Bad_Values++;
+		return FALSE;
+	}
+
+	g_linkCache[Topic].Value = Value;
+	g_linkCache[Topic].Valid = TRUE;
+
+	if (g_linkCallBackPtr != NULL_PTR)
+	{
+		(*g_linkCallBackPtr)(g_rxSource, Topic, Value);
+	}
+
+	return TRUE;
+}
+
+/* Put a 16-bit or a 32-bit value in a payload (little endian), return the next index */
+static uint8 Link_PutValue(uint8 *Payload_Ptr, uint8 Index, uint32 Value, uint8 Size)
+{
+	uint8 i;
+
+	for (i = 0; i < Size; i++)
+	{
+		Payload_Ptr[Index + i] = (uint8)Value;
+		Value >>= 8;
+	}
+
+	return Index + Size;
+}
+
+/* Answer LINK_COMMAND_GET_STATISTICS with one page of the statistics */
+static void Link_ReplyStatistics(uint8 Destination, uint8 Page)
+{
+	uint8 Reply[LINK_MAX_PAYLOAD];
+	uint8 Length;
+
+	Reply[0] = LINK_COMMAND_GET_STATISTICS;
+	Reply[1] = Page;
+	Length = 2;
+
+	switch (Page)
+	{
+	case 0:
+		Length = Link_PutValue(Reply, Length, g_linkStats.Polling_Bytes, 4);
+		Length = Link_PutValue(Reply, Length, g_linkStats.Sent_Bytes, 4);
+		Length = Link_PutValue(Reply, Length, g_linkStats.Received_Frames, 2);
+		Length = Link_PutValue(Reply, Length, g_linkStats.Crc_Errors, 2);
+		break;
+
+	case 1:
+		Length = Link_PutValue(Reply, Length, g_linkStats.Link_Losses, 2);
+		Length = Link_PutValue(Reply, Length, g_linkStats.Last_Recovery_Ms, 2);
+		Length = Link_PutValue(Reply, Length, g_linkStats.Max_Recovery_Ms, 2);
+		Length = Link_PutValue(Reply, Length, g_linkStats.Naks_Sent, 2);
+		Length = Link_PutValue(Reply, Length, g_linkStats.Naks_Received, 2);
+		break;
+
+	case 2:
+		Length = Link_PutValue(Reply, Length, g_linkStats.Bad_Bytes, 2);
+		Length = Link_PutValue(Reply, Length, g_linkStats.Bad_Values, 2);
+		Length = Link_PutValue(Reply, Length, g_linkStats.Broken_Frames, 2);
+		break;
+
+	default:
+		/* Unknown page: the reply has no values */
+		break;
+	}
+
+	Link_Send(Destination, LINK_REPLY_TOPIC, Reply, Length);
+}
+
+/* A complete frame with a good CRC was received */
+static void Link_HandleFrame(void)
+{
+	uint8 Topic;
+	uint8 Zone;
+	uint8 Node;
+
+	g_linkStats.Received_Frames++;
+
+	/* A frame of a polled actuator node shows it is alive (the subtraction wraps for the other sources) */
+	Node = g_rxSource - LINK_ACTUATOR_BASE_ADDRESS;
+	if (Node < g_linkConfigPtr -> Num_Of_Polled_Nodes)
+	{
+		g_linkAliveNodes |= (1 << Node);
+
+		if ((g_rxTopic == LINK_REPLY_TOPIC) || (g_rxTopic == LINK_TRACE_TOPIC))
+		{
+			/* Sensor node: the frames of the actuator nodes to the service PC go on with their SOURCE */
+			Link_SendFrameFrom(g_rxSource, LINK_SERVICE_ADDRESS, g_rxTopic, g_rxPayload, g_rxLength);
+			return;
+		}
+	}
+
+	if ((g_rxTopic == LINK_FORWARD_TOPIC) && (g_rxSource == LINK_SERVICE_ADDRESS) && (g_rxLength >= 2) &&
+		((uint8)(g_rxPayload[0] - LINK_ACTUATOR_BASE_ADDRESS) < g_linkConfigPtr -> Num_Of_Polled_Nodes))
+	{
+		/* Sensor node: a command of the service PC to an actuator node, the reply comes back in the turn of the node */
+		Link_SendFrameFrom(LINK_SERVICE_ADDRESS, g_rxPayload[0], LINK_COMMAND_TOPIC, &g_rxPayload[1], g_rxLength - 1);
+		return;
+	}
+
+	if ((g_rxTopic == LINK_POLL_TOPIC) && (g_rxLength == 0))
+	{
+		/* Our turn, only the sensor node gives it */
+		if (g_rxSource == LINK_SENSOR_NODE_ADDRESS)
+		{
+			g_linkPolled = TRUE;
+		}
+		return;
+	}
+
+	if ((g_rxTopic == LINK_TOPIC_HEARTBEAT) && (g_rxSource == Link_PolledAddress()))
+	{
+		/* The heartbeat ends the turn of the polled node */
+		g_linkPollAnswered = TRUE;
+	}
+
+	if ((g_rxTopic == LINK_COMMAND_TOPIC) && (g_rxLength != 0))
+	{
+		if (g_rxPayload[0] == LINK_COMMAND_GET_STATISTICS)
+		{
+			if (g_rxLength == 2)
+			{
+				Link_ReplyStatistics(g_rxSource, g_rxPayload[1]);
+			}
+		}
+		else if (g_linkCommandCallBackPtr != NULL_PTR)
+		{
+			(*g_linkCommandCallBackPtr)(g_rxSource, g_rxPayload, g_rxLength);
+		}
+		return;
+	}
+
+	if ((g_rxTopic == LINK_NAK_TOPIC) && (g_rxLength == 0))
+	{
+		/* The other node lost some of our frames: send all the topics again */
+		g_linkStats.Naks_Received++;
+		for (Topic = 0; Topic < LINK_NUM_OF_TOPICS; Topic++)
+		{
+			g_linkPublishers[Topic].Sent = FALSE;
+		}
+		return;
+	}
+
+#if (LINK_BENCHMARK_ENABLE == 1)
+	if ((g_rxTopic == LINK_BENCHMARK_TOPIC) && (g_rxLength == 2))
+	{
+		uint16 Sequence = (uint16)g_rxPayload[0] | ((uint16)g_rxPayload[1] << 8);
+
+		g_benchLastTime = SysTick_GetTicks();
+		if (g_benchFrames == 0)
+		{
+			g_benchFirstTime = g_benchLastTime;
+		}
+		else
+		{
+			g_benchLost += Sequence - g_benchSequence - 1;
+		}
+		g_benchSequence = Sequence;
+		g_benchFrames++;
+		return;
+	}
+#endif
+
+	if ((g_rxTopic == LINK_ZONES_TOPIC) && (g_rxLength >= LINK_ZONES_HEADER_SIZE) &&
+		(g_rxPayload[0] <= LINK_MAX_ZONES) && (g_rxLength == (LINK_ZONES_HEADER_SIZE + g_rxPayload[0])) &&
+		(g_rxPayload[1] < g_rxPayload[0]))
+	{
+		g_linkZones.Num_Of_Zones = g_rxPayload[0];
+		g_linkZones.Max_Zone = g_rxPayload[1];
+		g_linkZones.Max = (uint16)g_rxPayload[2] | ((uint16)g_rxPayload[3] << 8);
+		g_linkZones.Mean = (uint16)g_rxPayload[4] | ((uint16)g_rxPayload[5] << 8);
+		for (Zone = 0; Zone < g_linkZones.Num_Of_Zones; Zone++)
+		{
+			g_linkZones.Zones[Zone] = g_rxPayload[LINK_ZONES_HEADER_SIZE + Zone];
+		}
+		/* The hottest zone is the temperature value of the subscribers, a summary out of range is not kept */
+		g_linkZonesValid = Link_StoreValue(LINK_TOPIC_TEMPERATURE, g_linkZones.Max / 10);
+		return;
+	}
+
+	if ((g_rxTopic == LINK_EMERGENCY_TOPIC) && (g_rxLength == 1))
+	{
+		Link_StoreValue(LINK_TOPIC_EMERGENCY, g_rxPayload[0]);
+		return;
+	}
+
+	if ((g_rxTopic < LINK_NUM_OF_TOPICS) && (g_rxLength == 2))
+	{
+		Link_StoreValue((Link_TopicId)g_rxTopic, (uint16)g_rxPayload[0] | ((uint16)g_rxPayload[1] << 8));
+		return;
+	}
+
+	/* A valid CRC but an unknown topic or a wrong length: not a frame of this protocol version */
+	g_linkStats.Bad_Values++;
+}
+
+/* Send a value if it crossed its Delta or its Keep Alive interval expired, return TRUE if it was sent */
+static boolean Link_PublishValue(Link_TopicId Topic, uint16 Value)
+{
+	Link_PublisherType *Publisher_Ptr = &g_linkPublishers[Topic];
+	const Link_TopicConfigType *Rule_Ptr = &g_linkConfigPtr -> Topics_Ptr[Topic];
+	uint16 Change;
+	uint8 Payload[2];
+
+	if (Publisher_Ptr -> Sent == TRUE)
+	{
+		Change = (Value > Publisher_Ptr -> Last_Value) ? (Value - Publisher_Ptr -> Last_Value) : (Publisher_Ptr -> Last_Value - Value);
+
+		if ((Change < Rule_Ptr -> Delta) && (SysTick_HasElapsed(Publisher_Ptr -> Last_Time, Rule_Ptr -> Keep_Alive_Ms) == FALSE))
+		{
+			/* Nothing new for the subscriber */
+			return FALSE;
+		}
+	}
+
+	Payload[0] = (uint8)Value;
+	Payload[1] = (uint8)(Value >> 8);
+	Link_SendFrame(Rule_Ptr -> Destination, Topic, Payload, 2);
+
+	Publisher_Ptr -> Last_Value = Value;
+	Publisher_Ptr -> Last_Time = SysTick_GetTicks();
+	Publisher_Ptr -> Sent = TRUE;
+
+	return TRUE;
+}
+
+/* The frame being received is corrupted: drop it and ask for a retransmission */
+static void Link_RequestRetransmit(void)
+{
+	g_rxState = LINK_WAIT_SOF;
+	g_linkNakPending = TRUE;
+}
+
+/* Change the link state and trace it */
+static void Link_SetState(Link_StateType State)
+{
+	g_linkState = State;
+	TRACE_EVENT(TRACE_EVENT_LINK_STATE, State);
+}
+
+/* Nothing valid was received for LINK_TIMEOUT_MS: start again from a clean receiver */
+static void Link_Lost(void)
+{
+	uint8 Topic;
+
+	if (g_linkState == LINK_UP)
+	{
+		g_linkStats.Link_Losses++;
+	}
+
+	/* Drop a partial frame and wait for the next address character */
+	g_rxState = LINK_WAIT_SOF;
+	UART_SetNodeAddress(g_linkConfigPtr -> Node_Address);
+
+	/* The cached values are too old to be used */
+	for (Topic = 0; Topic < LINK_NUM_OF_TOPICS; Topic++)
+	{
+		g_linkCache[Topic].Valid = FALSE;
+	}
+	g_linkZonesValid = FALSE;
+	g_linkAliveNodes = 0;
+
+	g_linkDownTime = SysTick_GetTicks();
+	Link_SetState(LINK_DOWN);
+}
+
+/* A valid frame was received: count the frames needed to trust the link again */
+static void Link_Alive(void)
+{
+	uint8 Topic;
+	uint16 Recovery_Ms;
+
+	g_linkLastRxTime = SysTick_GetTicks();
+
+	if (g_linkState == LINK_UP)
+	{
+		return;
+	}
+
+	if (g_linkState == LINK_DOWN)
+	{
+		g_linkSyncFrames = 0;
+		Link_SetState(LINK_SYNCING);
+	}
+
+	g_linkSyncFrames++;
+
+	if (g_linkSyncFrames >= LINK_SYNC_FRAMES)
+	{
+		/* Recovery times longer than 65.5 seconds wrap around with the SysTick */
+		Recovery_Ms = g_linkLastRxTime - g_linkDownTime;
+		g_linkStats.Last_Recovery_Ms = Recovery_Ms;
+		if (Recovery_Ms > g_linkStats.Max_Recovery_Ms)
+		{
+			g_linkStats.Max_Recovery_Ms = Recovery_Ms;
+		}
+
+		/* The other node may have restarted: send all the values again at the next publish */
+		for (Topic = 0; Topic < LINK_NUM_OF_TOPICS; Topic++)
+		{
+			g_linkPublishers[Topic].Sent = FALSE;
+		}
+
+		Link_SetState(LINK_UP);
+	}
+}
+
+/* Feed one received byte to the frame parser, return TRUE when a valid frame is completed */
+static boolean Link_ParseByte(uint8 Byte)
+{
+	boolean Frame_Received = FALSE;
+
+	switch (g_rxState)
+	{
+	case LINK_WAIT_SOF:
+		if (Byte == LINK_SOF)
+		{
+			g_rxCrc = 0;
+			g_rxState = LINK_WAIT_SOURCE;
+		}
+		break;
+
+	case LINK_WAIT_SOURCE:
+		g_rxSource = Byte;
+		g_rxCrc = Link_Crc8Update(g_rxCrc, Byte);
+		g_rxState = LINK_WAIT_TOPIC;
+		break;
+
+	case LINK_WAIT_TOPIC:
+		g_rxTopic = Byte;
+		g_rxCrc = Link_Crc8Update(g_rxCrc, Byte);
+		g_rxState = LINK_WAIT_LEN;
+		break;
+
+	case LINK_WAIT_LEN:
+		g_rxLength = Byte;
+		g_rxIndex = 0;
+		g_rxCrc = Link_Crc8Update(g_rxCrc, Byte);
+
+		if (Byte > LINK_MAX_PAYLOAD)
+		{
+			/* Not a frame of ours, look for the next SOF */
+			Link_RequestRetransmit();
+		}
+		else
+		{
+			g_rxState = (Byte == 0) ? LINK_WAIT_CRC : LINK_WAIT_PAYLOAD;
+		}
+		break;
+
+	case LINK_WAIT_PAYLOAD:
+		g_rxPayload[g_rxIndex] = Byte;
+		g_rxIndex++;
+		g_rxCrc = Link_Crc8Update(g_rxCrc, Byte);
+
+		if (g_rxIndex == g_rxLength)
+		{
+			g_rxState = LINK_WAIT_CRC;
+		}
+		break;
+
+	case LINK_WAIT_CRC:
+		if (Byte == g_rxCrc)
+		{
+			Link_Alive();
+			Link_HandleFrame();
+			Frame_Received = TRUE;
+		}
+		else
+		{
+			g_linkStats.Crc_Errors++;
+			Link_RequestRetransmit();
+		}
+		g_rxState = LINK_WAIT_SOF;
+		break;
+	}
+
+	return Frame_Received;
+}
+
+/* Actuator node polled: send the values which are due and the queued frame, the heartbeat ends the turn */
+static void Link_TakeTurn(void)
+{
+	uint8 Topic;
+
+	for (Topic = 0; Topic < LINK_TOPIC_HEARTBEAT; Topic++)
+	{
+		if (g_linkPublishers[Topic].Offered == TRUE)
+		{
+			Link_PublishValue((Link_TopicId)Topic, g_linkPublishers[Topic].Offered_Value);
+		}
+	}
+
+	if (g_linkTxQueued == TRUE)
+	{
+		Link_SendFrame(g_linkTxDestination, g_linkTxTopic, g_linkTxPayload, g_linkTxLength);
+		g_linkTxQueued = FALSE;
+	}
+
+	g_linkPublishers[LINK_TOPIC_HEARTBEAT].Sent = FALSE;
+	Link_PublishValue(LINK_TOPIC_HEARTBEAT, g_linkState);
+
+	g_linkPolled = FALSE;
+}
+
+/*
+ * Sensor node: give the turn to the next node once the last one ended its turn or timed out, the actuator
+ * nodes in the order of their addresses, then the service PC.
+ * An actuator node whose turn timed out is dead, it is sent a NAK before its next poll so it sends all its values again.
+ */
+static void Link_PollNextNode(void)
+{
+	uint8 Num_Of_Nodes = g_linkConfigPtr -> Num_Of_Polled_Nodes;
+
+	if ((SysTick_HasElapsed(g_linkPollTime, g_linkPollPeriod) == FALSE) ||
+		((g_linkPollAnswered == FALSE) && (SysTick_HasElapsed(g_linkPollTime, LINK_POLL_TIMEOUT_MS) == FALSE)))
+	{
+		return;
+	}
+
+	if ((g_linkPollAnswered == FALSE) && (g_linkPollNode < Num_Of_Nodes))
+	{
+		g_linkAliveNodes &= ~(1 << g_linkPollNode);
+	}
+
+	g_linkPollNode++;
+	if (g_linkPollNode > Num_Of_Nodes)
+	{
+		g_linkPollNode = 0;
+	}
+
+	if ((g_linkPollNode < Num_Of_Nodes) && ((g_linkAliveNodes & (1 << g_linkPollNode)) == 0))
+	{
+		Link_SendFrame(Link_PolledAddress(), LINK_NAK_TOPIC, NULL_PTR, 0);
+		g_linkStats.Naks_Sent++;
+	}
+
+	Link_SendFrame(Link_PolledAddress(), LINK_POLL_TOPIC, NULL_PTR, 0);
+	g_linkPollTime = SysTick_GetTicks();
+	g_linkPollAnswered = FALSE;
+}
+
+/****************************************************************************************
+ *                                     Functions Definitions                            *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Save the node address and the publishing rules, clear the cache and the statistics.
+ * The UART must be initialized with Nine_Bit_7 frames, it is put in the Multi-processor
+ * Communication Mode with the node address. The SysTick must be initialized.
+ * The link starts in LINK_DOWN until the other node is heard.
+ */
+void Link_Init(const Link_ConfigType *Config_Ptr)
+{
+	uint8 Topic;
+
+	g_linkConfigPtr = Config_Ptr;
+
+	for (Topic = 0; Topic < LINK_NUM_OF_TOPICS; Topic++)
+	{
+		g_linkPublishers[Topic].Sent = FALSE;
+		g_linkPublishers[Topic].Offered = FALSE;
+		g_linkCache[Topic].Valid = FALSE;
+	}
+
+	g_linkStats.Polling_Bytes = 0;
+	g_linkStats.Sent_Bytes = 0;
+	g_linkStats.Received_Frames = 0;
+	g_linkStats.Crc_Errors = 0;
+	g_linkStats.Link_Losses = 0;
+	g_linkStats.Last_Recovery_Ms = 0;
+	g_linkStats.Max_Recovery_Ms = 0;
+	g_linkStats.Bad_Bytes = 0;
+	g_linkStats.Naks_Sent = 0;
+	g_linkStats.Naks_Received = 0;
+	g_linkStats.Bad_Values = 0;
+	g_linkStats.Broken_Frames = 0;
+
+	g_linkNakPending = FALSE;
+	g_linkLastNakTime = SysTick_GetTicks();
+
+	g_linkPolled = FALSE;
+	g_linkTxQueued = FALSE;
+	g_linkPollTime = g_linkLastNakTime;
+	g_linkPollAnswered = TRUE;
+
+	/* Every actuator node and the service PC are polled once per heartbeat period, the first turn is the one of node 0 */
+	g_linkPollNode = Config_Ptr -> Num_Of_Polled_Nodes;
+	g_linkPollPeriod = LINK_HEARTBEAT_PERIOD_MS / (Config_Ptr -> Num_Of_Polled_Nodes + 1);
+
+	/* Start as a lost link, so the startup synchronization is measured like a recovery */
+	g_linkState = LINK_DOWN;
+	Link_Lost();
+}
+
+/*
+ * Description:
+ * Offer the current value of a topic, to be called every cycle.
+ * The frame is sent only if the value crossed its Delta or the Keep Alive interval expired.
+ * Return TRUE if a frame was sent.
+ */
+boolean Link_Publish(Link_TopicId Topic, uint16 Value)
+{
+	/* The polling design sent every value every cycle, it had no heartbeat */
+	if (Topic != LINK_TOPIC_HEARTBEAT)
+	{
+		g_linkStats.Polling_Bytes += LINK_POLLING_BYTES_PER_VALUE;
+	}
+
+	g_linkPublishers[Topic].Offered_Value = Value;
+	g_linkPublishers[Topic].Offered = TRUE;
+
+	if (Link_OwnsBus() == FALSE)
+	{
+		/* Sent in the next turn if it is still due */
+		return FALSE;
+	}
+
+	return Link_PublishValue(Topic, Value);
+}
+
+/*
+ * Description:
+ * Offer the current zone summary, to be called every cycle instead of publishing LINK_TOPIC_TEMPERATURE.
+ * The frame is sent when the zone count or the hottest zone changed, a zone moved by the Delta of
+ * LINK_TOPIC_TEMPERATURE, or its Keep Alive interval expired. Return TRUE if a frame was sent.
+ */
+boolean Link_PublishZones(const Link_ZonesType *Zones_Ptr)
+{
+	Link_PublisherType *Publisher_Ptr = &g_linkPublishers[LINK_TOPIC_TEMPERATURE];
+	const Link_TopicConfigType *Rule_Ptr = &g_linkConfigPtr -> Topics_Ptr[LINK_TOPIC_TEMPERATURE];
+	boolean Changed = FALSE;
+	uint8 Zone;
+	uint8 Change;
+	uint8 Payload[LINK_ZONES_HEADER_SIZE + LINK_MAX_ZONES];
+
+	/* The polling design sent one temperature every cycle */
+	g_linkStats.Polling_Bytes += LINK_POLLING_BYTES_PER_VALUE;
+
+	if ((Publisher_Ptr -> Sent == FALSE) || (Zones_Ptr -> Num_Of_Zones != g_linkZonesSent.Num_Of_Zones) ||
+		(Zones_Ptr -> Max_Zone != g_linkZonesSent.Max_Zone))
+	{
+		Changed = TRUE;
+	}
+
+	for (Zone = 0; (Zone < Zones_Ptr -> Num_Of_Zones) && (Changed == FALSE); Zone++)
+	{
+		Change = (Zones_Ptr -> Zones[Zone] > g_linkZonesSent.Zones[Zone]) ?
+				(Zones_Ptr -> Zones[Zone] - g_linkZonesSent.Zones[Zone]) : (g_linkZonesSent.Zones[Zone] - Zones_Ptr -> Zones[Zone]);
+		if (Change >= Rule_Ptr -> Delta)
+		{
+			Changed = TRUE;
+		}
+	}
+
+	if ((Changed == FALSE) && (SysTick_HasElapsed(Publisher_Ptr -> Last_Time, Rule_Ptr -> Keep_Alive_Ms) == FALSE))
+	{
+		/* Nothing new for the subscribers */
+		return FALSE;
+	}
+
+	Payload[0] = Zones_Ptr -> Num_Of_Zones;
+	Payload[1] = Zones_Ptr -> Max_Zone;
+	Payload[2] = (uint8)(Zones_Ptr -> Max);
+	Payload[3] = (uint8)(Zones_Ptr -> Max >> 8);
+	Payload[4] = (uint8)(Zones_Ptr -> Mean);
+	Payload[5] = (uint8)(Zones_Ptr -> Mean >> 8);
+	for (Zone = 0; Zone < Zones_Ptr -> Num_Of_Zones; Zone++)
+	{
+		Payload[LINK_ZONES_HEADER_SIZE + Zone] = Zones_Ptr -> Zones[Zone];
+	}
+	Link_SendFrame(Rule_Ptr -> Destination, LINK_ZONES_TOPIC, Payload, LINK_ZONES_HEADER_SIZE + Zones_Ptr -> Num_Of_Zones);
+
+	g_linkZonesSent = *Zones_Ptr;
+	Publisher_Ptr -> Last_Time = SysTick_GetTicks();
+	Publisher_Ptr -> Sent = TRUE;
+
+	return TRUE;
+}
+
+/*
+ * Description:
+ * Send the emergency state now in a LINK_EMERGENCY_TOPIC frame to the destination of
+ * LINK_TOPIC_EMERGENCY, without waiting for its publishing rule. The state is taken as the last
+ * published value of LINK_TOPIC_EMERGENCY, so it is not sent again as a value frame.
+ */
+void Link_SendEmergency(uint8 State)
+{
+	Link_PublisherType *Publisher_Ptr = &g_linkPublishers[LINK_TOPIC_EMERGENCY];
+
+	Link_SendFrame(g_linkConfigPtr -> Topics_Ptr[LINK_TOPIC_EMERGENCY].Destination, LINK_EMERGENCY_TOPIC, &State, 1);
+
+	Publisher_Ptr -> Last_Value = State;
+	Publisher_Ptr -> Last_Time = SysTick_GetTicks();
+	Publisher_Ptr -> Sent = TRUE;
+}
+
+/*
+ * Description:
+ * Parse all bytes waiting in the UART receive buffer without blocking and update the cache.
+ * A byte with a UART error or a frame with a bad CRC is dropped and a NAK is sent to ask the
+ * other node for its values again. An address character always starts a new frame, so a cut
+ * frame never swallows the next one. Then run the link supervision:
+ * 1. Publish the heartbeat (own link state) when it is due.
+ * 2. Move to LINK_DOWN after LINK_TIMEOUT_MS without a valid frame: the parser and the address
+ *    filter are reset and the cached values are dropped.
+ * 3. Move to LINK_UP after LINK_SYNC_FRAMES valid frames and republish all the topics.
+ * 4. Sensor node: poll the next actuator node or the service PC when it is due.
+ *    Actuator node: take the turn when it was polled.
+ * Return TRUE if at least one valid frame was received.
+ */
+boolean Link_Poll(void)
+{
+	const uint8 *Data_Ptr;
+	uint8 Status;
+	uint8 Count;
+	uint8 i;
+	boolean Frame_Received = FALSE;
+
+	while (UART_Available() != 0)
+	{
+		Status = UART_GetRxStatus();
+
+		if (Status & UART_STATUS_ERRORS)
+		{
+			/* Never parse a corrupted byte, the frame it belongs to is lost */
+			UART_Consume(1);
+			g_linkStats.Bad_Bytes++;
+			Link_RequestRetransmit();
+			continue;
+		}
+
+		if (Status & UART_STATUS_BIT8)
+		{
+			/* Our address: a new frame starts here, the end of the frame being parsed was lost */
+			UART_Consume(1);
+			if (g_rxState != LINK_WAIT_SOF)
+			{
+				g_linkStats.Broken_Frames++;
+				Link_RequestRetransmit();
+			}
+			g_rxState = LINK_WAIT_SOF;
+			continue;
+		}
+
+		/* Parse the good bytes in place inside the UART receive buffer, then release them */
+		Count = UART_Peek(&Data_Ptr);
+		for (i = 0; i < Count; i++)
+		{
+			if (Link_ParseByte(Data_Ptr[i]))
+			{
+				Frame_Received = TRUE;
+			}
+		}
+		UART_Consume(Count);
+	}
+
+	if ((g_linkNakPending == TRUE) && (Link_OwnsBus() == TRUE) && SysTick_HasElapsed(g_linkLastNakTime, LINK_NAK_HOLDOFF_MS))
+	{
+		Link_SendFrame(g_linkConfigPtr -> Topics_Ptr[LINK_TOPIC_HEARTBEAT].Destination, LINK_NAK_TOPIC, NULL_PTR, 0);
+		g_linkNakPending = FALSE;
+		g_linkLastNakTime = SysTick_GetTicks();
+		g_linkStats.Naks_Sent++;
+	}
+
+	if ((g_linkState != LINK_DOWN) && SysTick_HasElapsed(g_linkLastRxTime, LINK_TIMEOUT_MS))
+	{
+		Link_Lost();
+	}
+
+	if (g_linkPolled == TRUE)
+	{
+		/* Actuator node: the turn ends with the heartbeat */
+		Link_TakeTurn();
+	}
+	else if (Link_OwnsBus() == TRUE)
+	{
+		/* Heartbeat: sent on every state change and at least every Keep_Alive_Ms of its topic */
+		Link_Publish(LINK_TOPIC_HEARTBEAT, g_linkState);
+
+		if (g_linkConfigPtr -> Num_Of_Polled_Nodes != 0)
+		{
+			Link_PollNextNode();
+		}
+	}
+
+	return Frame_Received;
+}
+
+/*
+ * Description:
+ * Return the link state, the application falls back to its safe policy when it is not LINK_UP.
+ */
+Link_StateType Link_GetState(void)
+{
+	return g_linkState;
+}
+
+/*
+ * Description:
+ * Sensor node: return the actuator nodes which are alive, bit i for the node at
+ * LINK_ACTUATOR_BASE_ADDRESS + i. A node is dead after a turn without its heartbeat
+ * (LINK_POLL_TIMEOUT_MS) and alive again at its next valid frame. 0 on the other nodes.
+ */
+uint8 Link_GetAliveNodes(void)
+{
+	return g_linkAliveNodes;
+}
+
+/*
+ * Description:
+ * Read the last known value of a topic from the cache.
+ * Return FALSE if no value has been received for this topic yet.
+ */
+boolean Link_GetValue(Link_TopicId Topic, uint16 *Value_Ptr)
+{
+	if (g_linkCache[Topic].Valid == FALSE)
+	{
+		return FALSE;
+	}
+
+	*Value_Ptr = g_linkCache[Topic].Value;
+	return TRUE;
+}
+
+/*
+ * Description:
+ * Copy the last received zone summary.
+ * Return FALSE if no summary has been received yet.
+ */
+boolean Link_GetZones(Link_ZonesType *Zones_Ptr)
+{
+	if (g_linkZonesValid == FALSE)
+	{
+		return FALSE;
+	}
+
+	*Zones_Ptr = g_linkZones;
+	return TRUE;
+}
+
+/*
+ * Description:
+ * Set the function called by Link_Poll for every valid frame with its source node address,
+ * so a node can tell the values of several publishers of the same topic apart.
+ */
+void Link_SetCallBack(void(*a_ptr)(uint8 Source, Link_TopicId Topic, uint16 Value))
+{
+	g_linkCallBackPtr = a_ptr;
+}
+
+/*
+ * Description:
+ * Set the function called by Link_Poll for every valid LINK_COMMAND_TOPIC frame,
+ * except LINK_COMMAND_GET_STATISTICS which is answered by the link.
+ */
+void Link_SetCommandCallBack(void(*a_ptr)(uint8 Source, const uint8 *Payload_Ptr, uint8 Length))
+{
+	g_linkCommandCallBackPtr = a_ptr;
+}
+
+/*
+ * Description:
+ * Send one frame now, without the publishing rules (used for command replies).
+ * An actuator node queues the frame for its next turn, a frame is dropped while one is queued.
+ * Length must not be more than LINK_MAX_PAYLOAD.
+ */
+void Link_Send(uint8 Destination, uint8 Topic, const uint8 *Payload_Ptr, uint8 Length)
+{
+	uint8 i;
+
+	if (Length > LINK_MAX_PAYLOAD)
+	{
+		return;
+	}
+
+	if (Link_OwnsBus() == TRUE)
+	{
+		Link_SendFrame(Destination, Topic, Payload_Ptr, Length);
+	}
+	else if (g_linkTxQueued == FALSE)
+	{
+		g_linkTxDestination = Destination;
+		g_linkTxTopic = Topic;
+		g_linkTxLength = Length;
+		for (i = 0; i < Length; i++)
+		{
+			g_linkTxPayload[i] = Payload_Ptr[i];
+		}
+		g_linkTxQueued = TRUE;
+	}
+}
+
+/*
+ * Description:
+ * Return TRUE if Link_Send can take a frame now (sent or queued).
+ */
+boolean Link_CanSend(void)
+{
+	return (Link_OwnsBus() == TRUE) || (g_linkTxQueued == FALSE);
+}
+
+/*
+ * Description:
+ * Copy the link statistics. Bytes saved = Polling_Bytes - Sent_Bytes.
+ */
+void Link_GetStatistics(Link_StatisticsType *Stats_Ptr)
+{
+	*Stats_Ptr = g_linkStats;
+}
+
+#if (LINK_BENCHMARK_ENABLE == 1)
+
+/*
+ * Description:
+ * Measure the sustained frame rate and the error rates of the link at the built UART_BAUD_RATE.
+ * 1. Sender = TRUE: send benchmark frames back to back for Duration_Ms.
+ * 2. Sender = FALSE: wait up to Duration_Ms for the first benchmark frame, then receive until
+ *    the frames stop for LINK_TIMEOUT_MS. The rate is measured from the first to the last frame.
+ */
+void Link_Benchmark(boolean Sender, uint16 Duration_Ms, Link_BenchmarkType *Result_Ptr)
+{
+	UART_ErrorStatisticsType Uart_Start;
+	UART_ErrorStatisticsType Uart_End;
+	uint16 Crc_Start = g_linkStats.Crc_Errors;
+	uint16 Start = SysTick_GetTicks();
+	uint16 Elapsed;
+	uint16 Intervals;
+	uint8 Payload[2];
+
+	UART_GetErrorStatistics(&Uart_Start);
+
+	g_benchFrames = 0;
+	g_benchLost = 0;
+
+	if (Sender == TRUE)
+	{
+		while (SysTick_HasElapsed(Start, Duration_Ms) == FALSE)
+		{
+			Payload[0] = (uint8)g_benchFrames;
+			Payload[1] = (uint8)(g_benchFrames >> 8);
+			Link_SendFrame(LINK_BROADCAST_ADDRESS, LINK_BENCHMARK_TOPIC, Payload, 2);
+			g_benchFrames++;
+		}
+		Elapsed = Duration_Ms;
+		Intervals = g_benchFrames;
+	}
+	else
+	{
+		while (((g_benchFrames == 0) && (SysTick_HasElapsed(Start, Duration_Ms) == FALSE)) ||
+		       ((g_benchFrames != 0) && (SysTick_HasElapsed(g_benchLastTime, LINK_TIMEOUT_MS) == FALSE)))
+		{
+			Link_Poll();
+		}
+		Elapsed = g_benchLastTime - g_benchFirstTime;
+		Intervals = (g_benchFrames == 0) ? 0 : (g_benchFrames - 1);
+	}
+
+	UART_GetErrorStatistics(&Uart_End);
+
+	Result_Ptr -> Frames = g_benchFrames;
+	Result_Ptr -> Frames_Per_Second = (Elapsed == 0) ? 0 : (uint16)(((uint32)Intervals * 1000UL) / Elapsed);
+	Result_Ptr -> Lost_Frames = g_benchLost;
+	Result_Ptr -> Crc_Errors = g_linkStats.Crc_Errors - Crc_Start;
+	Result_Ptr -> Frame_Errors = Uart_End.Frame_Errors - Uart_Start.Frame_Errors;
+	Result_Ptr -> Data_Overruns = Uart_End.Data_Overruns - Uart_Start.Data_Overruns;
+	Result_Ptr -> Parity_Errors = Uart_End.Parity_Errors - Uart_Start.Parity_Errors;
+}
+
+#endif
@@ -0,0 +1,360 @@
+/*****************************************************************************************************************
+ * File Name: LINK.h
+ * Date: 19/10/2026
+ * Driver: Inter-MCU Publish/Subscribe Link Header File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include "Standard_Types.h"
+#include "UART.h"
+
+#ifndef LINK_H_
+#define LINK_H_
+
+/******************************************************************************************
+ *                                    Macros Definitions                                  *
+ ******************************************************************************************/
+
+/*
+ * Frame on the UART (9-bit characters): ADDRESS, SOF, SOURCE, TOPIC, LEN, PAYLOAD[LEN], CRC8
+ * ADDRESS is sent with the ninth bit set and selects the receiving node(s) in hardware (MPCM),
+ * the other characters are data. CRC8 (polynomial 0x07) covers SOURCE, TOPIC, LEN and PAYLOAD.
+ * A value is sent as 2 bytes (little endian).
+ */
+#define LINK_SOF                             0x7E
+#define LINK_MAX_PAYLOAD                     16
+#define LINK_FRAME_OVERHEAD                  6
+#define LINK_VALUE_FRAME_SIZE                (LINK_FRAME_OVERHEAD + 2)
+
+/* Highest temperature a sensor node can publish (LM35 range) */
+#define LINK_MAX_TEMPERATURE                 150
+
+/* Bytes that the old polling design spent on every value every cycle: READY, READY, value */
+#define LINK_POLLING_BYTES_PER_VALUE         3
+
+/* Node addresses on the bus: one sensor node (MCU1) and up to 8 actuator nodes (MCU2) */
+#define LINK_BROADCAST_ADDRESS               UART_BROADCAST_ADDRESS
+#define LINK_SENSOR_NODE_ADDRESS             0x01
+#define LINK_ACTUATOR_BASE_ADDRESS           0x10
+#define LINK_MAX_ACTUATOR_NODES              8
+
+/*
+ * Link supervision: every node publishes LINK_TOPIC_HEARTBEAT at least every LINK_HEARTBEAT_PERIOD_MS.
+ * The link is DOWN when no valid frame was received for LINK_TIMEOUT_MS and UP again after
+ * LINK_SYNC_FRAMES valid frames in a row.
+ */
+#define LINK_HEARTBEAT_PERIOD_MS             200
+#define LINK_TIMEOUT_MS                      600
+#define LINK_SYNC_FRAMES                     2
+
+#if (LINK_TIMEOUT_MS <= LINK_HEARTBEAT_PERIOD_MS)
+
+#error "LINK_TIMEOUT_MS should be longer than LINK_HEARTBEAT_PERIOD_MS"
+
+#endif
+
+/*
+ * Retransmit request: a node which receives a corrupted byte or frame sends an empty
+ * LINK_NAK_TOPIC frame to the destination of its heartbeat, the receivers of the NAK send all
+ * their topics again at the next Link_Publish. NAKs are sent at most every LINK_NAK_HOLDOFF_MS.
+ */
+#define LINK_NAK_TOPIC                       0x7D
+#define LINK_NAK_HOLDOFF_MS                  50
+
+/*
+ * Commands: a LINK_COMMAND_TOPIC frame carries the command id in PAYLOAD[0] and its arguments
+ * after it, it is given to the command Call Back of the application. Answers are sent back to the
+ * source as LINK_REPLY_TOPIC frames starting with the same command id.
+ * A service PC on the bus uses LINK_SERVICE_ADDRESS and sends its commands in its turn (medium access below).
+ */
+#define LINK_COMMAND_TOPIC                   0x7C
+#define LINK_REPLY_TOPIC                     0x7B
+#define LINK_SERVICE_ADDRESS                 0x7F
+
+/*
+ * The link answers this command itself on every node, the statistics are read one page at a time:
+ * {CMD, PAGE} answered with {CMD, PAGE, VALUES} (little endian), no VALUES for an unknown PAGE.
+ * PAGE 0: POLLING_BYTES (32-bit), SENT_BYTES (32-bit), RECEIVED_FRAMES, CRC_ERRORS
+ * PAGE 1: LINK_LOSSES, LAST_RECOVERY_MS, MAX_RECOVERY_MS, NAKS_SENT, NAKS_RECEIVED
+ * PAGE 2: BAD_BYTES, BAD_VALUES, BROKEN_FRAMES
+ * Bytes saved against the polling design = POLLING_BYTES - SENT_BYTES.
+ */
+#define LINK_COMMAND_GET_STATISTICS          0x30
+
+/*
+ * Commands of the service PC to an actuator node, relayed by the sensor node: the service PC sends
+ * {NODE_ADDRESS, COMMAND} as a LINK_FORWARD_TOPIC frame to the sensor node in its turn, the sensor
+ * node sends COMMAND at once to NODE_ADDRESS as a LINK_COMMAND_TOPIC frame from LINK_SERVICE_ADDRESS.
+ * An actuator node sends its frames to LINK_SERVICE_ADDRESS (command replies and trace blocks) to the
+ * sensor node, which sends the LINK_REPLY_TOPIC and LINK_TRACE_TOPIC frames of the actuator nodes on
+ * to LINK_SERVICE_ADDRESS with the SOURCE of the actuator node.
+ */
+#define LINK_FORWARD_TOPIC                   0x76
+
+/*
+ * Zone summary of a multi-sensor node, sent instead of the value frame of LINK_TOPIC_TEMPERATURE
+ * and with its publishing rule (Delta in C applies to every zone):
+ * {NUM_OF_ZONES, MAX_ZONE, MAX (16-bit, 0.1 C), MEAN (16-bit, 0.1 C), ZONE[NUM_OF_ZONES] (C)}
+ * The receivers keep MAX in C as the value of LINK_TOPIC_TEMPERATURE.
+ */
+#define LINK_ZONES_TOPIC                     0x7A
+#define LINK_MAX_ZONES                       8
+#define LINK_ZONES_HEADER_SIZE               6
+
+#if ((LINK_ZONES_HEADER_SIZE + LINK_MAX_ZONES) > LINK_MAX_PAYLOAD)
+
+#error "The zone summary does not fit in one frame"
+
+#endif
+
+/*
+ * Emergency frame {STATE}: sent at once by Link_SendEmergency, before any other traffic of the
+ * cycle, when the emergency state changes. The receivers keep STATE as the value of
+ * LINK_TOPIC_EMERGENCY and give it to the value Call Back while Link_Poll reads the frame,
+ * the keep alive of LINK_TOPIC_EMERGENCY repeats it.
+ */
+#define LINK_EMERGENCY_TOPIC                 0x79
+
+/*
+ * Trace stream of a trace build (TRACE.h): blocks of trace records sent to LINK_SERVICE_ADDRESS,
+ * so the hardware address filter of the other nodes drops them.
+ */
+#define LINK_TRACE_TOPIC                     0x78
+
+/*
+ * Medium access: the sensor node drives the receive line of the actuator nodes and of the service PC
+ * alone. The actuator nodes and the service PC share the receive line of the sensor node (open-drain),
+ * so any two of them can collide there. The sensor node transmits at any time, the others only in
+ * their turn: the sensor node sends an empty LINK_POLL_TOPIC frame to one node at a time, the actuator
+ * nodes in the order of the addresses, then LINK_SERVICE_ADDRESS, so every node is polled once per
+ * LINK_HEARTBEAT_PERIOD_MS. A polled actuator node sends its NAK, its due values and the frame queued
+ * by Link_Send, then always its heartbeat, which ends the turn. The service PC sends its commands, then
+ * a LINK_TOPIC_HEARTBEAT value {LINK_UP} to the sensor node to end its turn, it stays silent out of it.
+ * The next node is polled after that heartbeat or after LINK_POLL_TIMEOUT_MS.
+ * A node whose turn timed out is dead until its next valid frame (Link_GetAliveNodes), it is sent
+ * a NAK before its next poll, so a node which missed one turn sends all its values again.
+ * Link_PublishZones and Link_SendEmergency are for the sensor node only.
+ */
+#define LINK_POLL_TOPIC                      0x77
+#define LINK_POLL_TIMEOUT_MS                 100
+
+/*
+ * Link benchmark build (-DLINK_BENCHMARK_ENABLE=1): the applications measure the link with
+ * Link_Benchmark at startup instead of running, build once for every UART_BAUD_RATE to compare.
+ * Benchmark frames use LINK_BENCHMARK_TOPIC with a 16-bit sequence number as payload.
+ */
+#ifndef LINK_BENCHMARK_ENABLE
+#define LINK_BENCHMARK_ENABLE                0
+#endif
+
+#define LINK_BENCHMARK_TOPIC                 0x7F
+#define LINK_BENCHMARK_DURATION_MS           5000
+
+/******************************************************************************************
+ *                                     Types Declaration                                  *
+ ******************************************************************************************/
+
+typedef enum
+{
+	LINK_TOPIC_TEMPERATURE,        /* MCU1 -> MCU2: hottest zone in C (LINK_ZONES_TOPIC frame) */
+	LINK_TOPIC_EMERGENCY,          /* MCU1 -> MCU2: latched emergency state (LOGIC_HIGH/LOW)   */
+	LINK_TOPIC_FAN_STATE,          /* MCU2 -> MCU1: 70 when the motor reached 70%, otherwise 0 */
+	LINK_TOPIC_HEARTBEAT,          /* both directions: Link_StateType of the sender            */
+	LINK_NUM_OF_TOPICS
+}Link_TopicId;
+
+typedef enum
+{
+	LINK_DOWN,                     /* nothing heard for LINK_TIMEOUT_MS, use the local safe policy */
+	LINK_SYNCING,                  /* frames are arriving again, not yet LINK_SYNC_FRAMES of them  */
+	LINK_UP
+}Link_StateType;
+
+/*
+ * Publishing rule of one topic: the value is sent to Destination when it moved by Delta or more
+ * from the last sent value, or when Keep_Alive_Ms passed since the last frame of this topic
+ * (Delta = 0 sends every value). A received value above Max_Value is dropped and never reaches
+ * the cache or the Call Back.
+ */
+typedef struct
+{
+	uint8 Destination;
+	uint16 Delta;
+	uint16 Keep_Alive_Ms;
+	uint16 Max_Value;
+}Link_TopicConfigType;
+
+typedef struct
+{
+	uint8 Node_Address;                         /* own address, used as SOURCE and for MPCM filtering     */
+	const Link_TopicConfigType *Topics_Ptr;     /* one rule per topic, indexed by Link_TopicId              */
+	uint8 Num_Of_Polled_Nodes;                  /* actuator nodes polled by the sensor node, 0 on the others */
+}Link_ConfigType;
+
+typedef struct
+{
+	uint32 Polling_Bytes;          /* bytes the polling design would have sent for the same publishes */
+	uint32 Sent_Bytes;             /* bytes really sent                                               */
+	uint16 Received_Frames;
+	uint16 Crc_Errors;
+	uint16 Link_Losses;            /* number of UP -> DOWN transitions                                */
+	uint16 Last_Recovery_Ms;       /* DOWN -> UP time of the last recovery (the first one is startup) */
+	uint16 Max_Recovery_Ms;
+	uint16 Bad_Bytes;              /* bytes tagged by the UART with FE, DOR or PE                     */
+	uint16 Naks_Sent;
+	uint16 Naks_Received;
+	uint16 Bad_Values;             /* values above the Max_Value of their topic and malformed frames  */
+	uint16 Broken_Frames;          /* frames cut by the address of the next frame                     */
+}Link_StatisticsType;
+
+/* Content of a LINK_ZONES_TOPIC frame */
+typedef struct
+{
+	uint8 Num_Of_Zones;
+	uint8 Max_Zone;
+	uint16 Max;                         /* 0.1 C */
+	uint16 Mean;                        /* 0.1 C */
+	uint8 Zones[LINK_MAX_ZONES];        /* C     */
+}Link_ZonesType;
+
+/* Result of Link_Benchmark, the error counters are counted during the benchmark only */
+typedef struct
+{
+	uint16 Frames;                 /* frames sent (sender) or valid frames received (receiver) */
+	uint16 Frames_Per_Second;
+	uint16 Lost_Frames;            /* gaps in the sequence numbers (receiver)                 */
+	uint16 Crc_Errors;
+	uint16 Frame_Errors;
+	uint16 Data_Overruns;
+	uint16 Parity_Errors;
+}Link_BenchmarkType;
+
+/******************************************************************************************
+ *                                    Functions Prototypes                                *
+ ******************************************************************************************/
+
+/*
+ * Description:
+ * Save the node address and the publishing rules, clear the cache and the statistics.
+ * The UART must be initialized with Nine_Bit_7 frames, it is put in the Multi-processor
+ * Communication Mode with the node address. The SysTick must be initialized.
+ * The link starts in LINK_DOWN until the other node is heard.
+ */
+void Link_Init(const Link_ConfigType *Config_Ptr);
+
+/*
+ * Description:
+ * Offer the current value of a topic, to be called every cycle.
+ * The frame is sent only if the value crossed its Delta or the Keep Alive interval expired.
+ * An actuator node keeps the value and applies the rule in its next turn.
+ * Return TRUE if a frame was sent.
+ */
+boolean Link_Publish(Link_TopicId Topic, uint16 Value);
+
+/*
+ * Description:
+ * Offer the current zone summary, to be called every cycle instead of publishing LINK_TOPIC_TEMPERATURE.
+ * The frame is sent when the zone count or the hottest zone changed, a zone moved by the Delta of
+ * LINK_TOPIC_TEMPERATURE, or its Keep Alive interval expired. Return TRUE if a frame was sent.
+ */
+boolean Link_PublishZones(const Link_ZonesType *Zones_Ptr);
+
+/*
+ * Description:
+ * Send the emergency state now in a LINK_EMERGENCY_TOPIC frame to the destination of
+ * LINK_TOPIC_EMERGENCY, without waiting for its publishing rule. The state is taken as the last
+ * published value of LINK_TOPIC_EMERGENCY, so it is not sent again as a value frame.
+ */
+void Link_SendEmergency(uint8 State);
+
+/*
+ * Description:
+ * Parse all bytes waiting in the UART receive buffer without blocking and update the cache.
+ * A byte with a UART error or a frame with a bad CRC is dropped and a NAK is sent to ask the
+ * other node for its values again. An address character always starts a new frame, so a cut
+ * frame never swallows the next one. Then run the link supervision:
+ * 1. Publish the heartbeat (own link state) when it is due.
+ * 2. Move to LINK_DOWN after LINK_TIMEOUT_MS without a valid frame: the parser and the address
+ *    filter are reset and the cached values are dropped.
+ * 3. Move to LINK_UP after LINK_SYNC_FRAMES valid frames and republish all the topics.
+ * 4. Sensor node: poll the next actuator node or the service PC when it is due.
+ *    Actuator node: take the turn when it was polled.
+ * Return TRUE if at least one valid frame was received.
+ */
+boolean Link_Poll(void);
+
+/*
+ * Description:
+ * Return the link state, the application falls back to its safe policy when it is not LINK_UP.
+ */
+Link_StateType Link_GetState(void);
+
+/*
+ * Description:
+ * Sensor node: return the actuator nodes which are alive, bit i for the node at
+ * LINK_ACTUATOR_BASE_ADDRESS + i. A node is dead after a turn without its heartbeat
+ * (LINK_POLL_TIMEOUT_MS) and alive again at its next valid frame. 0 on the other nodes.
+ */
+uint8 Link_GetAliveNodes(void);
+
+/*
+ * Description:
+ * Read the last known value of a topic from the cache.
+ * Return FALSE if no value has been received for this topic yet.
+ */
+boolean Link_GetValue(Link_TopicId Topic, uint16 *Value_Ptr);
+
+/*
+ * Description:
+ * Copy the last received zone summary.
+ * Return FALSE if no summary has been received yet.
+ */
+boolean Link_GetZones(Link_ZonesType *Zones_Ptr);
+
+/*
+ * Description:
+ * Set the function called by Link_Poll for every valid frame with its source node address,
+ * so a node can tell the values of several publishers of the same topic apart.
+ */
+void Link_SetCallBack(void(*a_ptr)(uint8 Source, Link_TopicId Topic, uint16 Value));
+
+/*
+ * Description:
+ * Set the function called by Link_Poll for every valid LINK_COMMAND_TOPIC frame,
+ * except LINK_COMMAND_GET_STATISTICS which is answered by the link.
+ */
+void Link_SetCommandCallBack(void(*a_ptr)(uint8 Source, const uint8 *Payload_Ptr, uint8 Length));
+
+/*
+ * Description:
+ * Send one frame now, without the publishing rules (used for command replies).
+ * An actuator node queues the frame for its next turn, a frame is dropped while one is queued.
+ * Length must not be more than LINK_MAX_PAYLOAD.
+ */
+void Link_Send(uint8 Destination, uint8 Topic, const uint8 *Payload_Ptr, uint8 Length);
+
+/*
+ * Description:
+ * Return TRUE if Link_Send can take a frame now (sent or queued).
+ */
+boolean Link_CanSend(void);
+
+/*
+ * Description:
+ * Copy the link statistics. Bytes saved = Polling_Bytes - Sent_Bytes.
+ */
+void Link_GetStatistics(Link_StatisticsType *Stats_Ptr);
+
+#if (LINK_BENCHMARK_ENABLE == 1)
+
+/*
+ * Description:
+ * Measure the sustained frame rate and the error rates of the link at the built UART_BAUD_RATE.
+ * 1. Sender = TRUE: send benchmark frames back to back for Duration_Ms.
+ * 2. Sender = FALSE: wait up to Duration_Ms for the first benchmark frame, then receive until
+ *    the frames stop for LINK_TIMEOUT_MS. The rate is measured from the first to the last frame.
+ */
+void Link_Benchmark(boolean Sender, uint16 Duration_Ms, Link_BenchmarkType *Result_Ptr);
+
+#endif
+
+#endif /* LINK_H_ */
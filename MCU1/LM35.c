@@ -6,6 +6,37 @@
  ****************************************************************************************************************/
 #include "LM35.h"
 #include "ADC.h"
+#include "GPIO.h"
+#include "PROFILER.h"
+
+#if (LM35_MAX_SENSORS > 8)
+
+#error "LM35_MAX_SENSORS should not be more than the 8 ADC channels"
+
+#endif
+
+/***************************************************************************************
+ *                                         Global Variables                            *
+ ***************************************************************************************/
+
+static const LM35_ConfigType *g_lm35ConfigPtr = NULL_PTR;
+
+/* Written by the ADC interrupt during a scan */
+static volatile uint16 g_lm35Counts[LM35_MAX_SENSORS];
+
+/* Zone temperatures (0.1 C) and their summary from the last completed scan */
+static uint16 g_lm35Tenths[LM35_MAX_SENSORS];
+static LM35_SummaryType g_lm35Summary;
+
+/***************************************************************************************
+ *                                      Private Functions                              *
+ ***************************************************************************************/
+
+/* ADC counts to 0.1 C */
+static uint16 LM35_CountsToTenths(uint16 Digital_Value)
+{
+	return (uint16)(((uint32)Digital_Value * LM35_TENTHS_FULL_SCALE) / ADC_MAX_DIGITAL_VALUE);
+}
 
 /****************************************************************************************
  *                                     Functions Definitions                            *
@@ -17,13 +48,117 @@
  */
 uint8 LM35_GetTemperature(void)
 {
-	uint8 Temperature = 0;
+	return (uint8)(LM35_GetTemperatureTenths() / 10);
+}
+
+/*
+ * Description:
+ * Calculation of the Temperature Sensor, then return the temperature in 0.1 C
+ * (integer math only, for the rate-of-rise detector).
+ */
+uint16 LM35_GetTemperatureTenths(void)
+{
+	uint16 Temperature = 0;
 
 	uint16 Digital_Value = 0;
 
+	PROF_BEGIN(PROF_LM35_GET_TEMPERATURE);
+
 	Digital_Value = ADC_ReadChannel(LM35_SENSOR_READ_CHANNEL);
 
-	Temperature = ( ((uint32)Digital_Value  * MAX_VOLTAGE_REFERENCE * MAX_LM35_TEMPERATURE) / ( MAX_VOLTAGE_SENSOR * ADC_MAX_DIGITAL_VALUE) );
+	Temperature = LM35_CountsToTenths(Digital_Value);
+
+	PROF_END(PROF_LM35_GET_TEMPERATURE);
 
 	return Temperature;
 }
+
+/*
+ * Description:
+ * Setup the pins of the zone sensors as inputs and start the first scan of their channels.
+ * The ADC must be initialized in Single Conversion and the Global Interrupt Enable bit set.
+ * The blocking functions above must not be used with a multi-sensor set.
+ */
+void LM35_Init(const LM35_ConfigType *Config_Ptr)
+{
+	uint8 Zone;
+
+	g_lm35ConfigPtr = Config_Ptr;
+
+	for (Zone = 0; Zone < Config_Ptr -> Num_Of_Sensors; Zone++)
+	{
+		GPIO_SetupPinDirection(PORTA_ID, Config_Ptr -> Channels_Ptr[Zone], INPUT_PIN);
+		g_lm35Tenths[Zone] = 0;
+	}
+
+	g_lm35Summary.Max = 0;
+	g_lm35Summary.Mean = 0;
+	g_lm35Summary.Max_Zone = 0;
+
+	ADC_StartScan(Config_Ptr -> Channels_Ptr, Config_Ptr -> Num_Of_Sensors, g_lm35Counts);
+}
+
+/*
+ * Description:
+ * To be called every cycle: when the scan is completed, convert all the zones, compute the
+ * max, the mean and the zone of the max, then start the next scan.
+ * Return TRUE when a new summary is available.
+ */
+boolean LM35_Task(void)
+{
+	uint8 Zone;
+	uint16 Sum_Counts = 0;
+	uint16 Max_Counts = 0;
+	uint8 Max_Zone = 0;
+	uint16 Counts;
+
+	if ((g_lm35ConfigPtr == NULL_PTR) || (ADC_IsScanComplete() == FALSE))
+	{
+		return FALSE;
+	}
+
+	PROF_BEGIN(PROF_LM35_GET_TEMPERATURE);
+
+	/* The scan is over, the ADC interrupt does not write the results any more */
+	for (Zone = 0; Zone < g_lm35ConfigPtr -> Num_Of_Sensors; Zone++)
+	{
+		Counts = g_lm35Counts[Zone];
+		g_lm35Tenths[Zone] = LM35_CountsToTenths(Counts);
+		Sum_Counts += Counts;
+
+		if (Counts > Max_Counts)
+		{
+			Max_Counts = Counts;
+			Max_Zone = Zone;
+		}
+	}
+
+	/* 8 sensors * 1023 fit in 16 bits, the mean is converted once instead of every zone added */
+	g_lm35Summary.Max = g_lm35Tenths[Max_Zone];
+	g_lm35Summary.Mean = LM35_CountsToTenths(Sum_Counts / g_lm35ConfigPtr -> Num_Of_Sensors);
+	g_lm35Summary.Max_Zone = Max_Zone;
+
+	ADC_StartScan(g_lm35ConfigPtr -> Channels_Ptr, g_lm35ConfigPtr -> Num_Of_Sensors, g_lm35Counts);
+
+	PROF_END(PROF_LM35_GET_TEMPERATURE);
+
+	return TRUE;
+}
+
+/*
+ * Description:
+ * Copy the summary of the last completed scan.
+ */
+void LM35_GetSummary(LM35_SummaryType *Summary_Ptr)
+{
+	*Summary_Ptr = g_lm35Summary;
+}
+
+/*
+ * Description:
+ * Return the temperature of one zone in 0.1 C from the last completed scan.
+ */
+uint16 LM35_GetZoneTemperatureTenths(uint8 Zone)
+{
+	return g_lm35Tenths[Zone];
+}
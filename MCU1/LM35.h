@@ -5,6 +5,7 @@
  * Author: Youssef Zaki
  ****************************************************************************************************************/
 #include "Standard_Types.h"
+#include "ADC.h"
 
 #ifndef LM35_H_
 #define LM35_H_
@@ -21,6 +22,31 @@
 
 #define LM35_SENSOR_READ_CHANNEL             2
 
+/* 0.1 C per ADC step times ADC_MAX_DIGITAL_VALUE: (MAX_VOLTAGE_REFERENCE / MAX_VOLTAGE_SENSOR) * MAX_LM35_TEMPERATURE * 10 */
+#define LM35_TENTHS_FULL_SCALE               5000
+
+/* Sensors (zones) of one multi-sensor set, all of them on PORTA (ADC0:7) */
+#define LM35_MAX_SENSORS                     8
+
+/******************************************************************************************
+ *                                     Types Declaration                                  *
+ ******************************************************************************************/
+
+/* One LM35 per zone, zone i is read from Channels_Ptr[i] */
+typedef struct
+{
+	const InputChannel_Select *Channels_Ptr;
+	uint8 Num_Of_Sensors;
+}LM35_ConfigType;
+
+/* Aggregate of the last scan, temperatures in 0.1 C */
+typedef struct
+{
+	uint16 Max;
+	uint16 Mean;
+	uint8 Max_Zone;
+}LM35_SummaryType;
+
 /******************************************************************************************
  *                                    Functions Prototypes                                *
  ******************************************************************************************/
@@ -31,4 +57,39 @@
  */
 uint8 LM35_GetTemperature(void);
 
+/*
+ * Description:
+ * Calculation of the Temperature Sensor, then return the temperature in 0.1 C
+ * (integer math only, for the rate-of-rise detector).
+ */
+uint16 LM35_GetTemperatureTenths(void);
+
+/*
+ * Description:
+ * Setup the pins of the zone sensors as inputs and start the first scan of their channels.
+ * The ADC must be initialized in Single Conversion and the Global Interrupt Enable bit set.
+ * The blocking functions above must not be used with a multi-sensor set.
+ */
+void LM35_Init(const LM35_ConfigType *Config_Ptr);
+
+/*
+ * Description:
+ * To be called every cycle: when the scan is completed, convert all the zones, compute the
+ * max, the mean and the zone of the max, then start the next scan.
+ * Return TRUE when a new summary is available.
+ */
+boolean LM35_Task(void);
+
+/*
+ * Description:
+ * Copy the summary of the last completed scan.
+ */
+void LM35_GetSummary(LM35_SummaryType *Summary_Ptr);
+
+/*
+ * Description:
+ * Return the temperature of one zone in 0.1 C from the last completed scan.
+ */
+uint16 LM35_GetZoneTemperatureTenths(uint8 Zone);
+
 #endif /* LM35_H_ */
@@ -0,0 +1,243 @@
+/*****************************************************************************************************************
+ * File Name: LOGGER.c
+ * Date: 19/10/2026
+ * Driver: Wear-Levelled EEPROM History Log Source File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include "LOGGER.h"
+#include "EEPROM.h"
+#include "SYSTICK.h"
+
+/***************************************************************************************
+ *                                         Global Variables                            *
+ ***************************************************************************************/
+
+static const Logger_ConfigType *g_loggerConfigPtr = NULL_PTR;
+
+/* Place of the next record and its sequence number */
+static uint16 g_loggerHead = 0;
+static uint16 g_loggerCount = 0;
+static uint8 g_loggerSequence = 0;
+
+/* Delta encoding state */
+static boolean g_loggerHaveReference = FALSE;
+static uint8 g_loggerReference;
+static uint8 g_loggerPendingDelta = LOGGER_DELTA_NONE;
+static uint8 g_loggerSinceAbsolute = 0;
+
+static uint16 g_loggerLastSampleTime;
+static uint16 g_loggerDropped = 0;
+
+/***************************************************************************************
+ *                                      Private Functions                              *
+ ***************************************************************************************/
+
+/* EEPROM address of a record place */
+static uint16 Logger_Address(uint16 Place)
+{
+	return LOGGER_EEPROM_START + (Place * LOGGER_RECORD_SIZE);
+}
+
+/*
+ * Queue one record: DATA first, then TAG which makes it valid.
+ * A dropped record breaks the delta chain: the pending delta is discarded and the next sample is
+ * logged as an absolute value, so no delta is decoded from a sample which is not in the log.
+ */
+static void Logger_Write(uint8 Type, uint8 Data)
+{
+	uint16 Address = Logger_Address(g_loggerHead);
+
+	if (EEPROM_GetFreeSpace() < LOGGER_RECORD_SIZE)
+	{
+		g_loggerDropped++;
+		g_loggerHaveReference = FALSE;
+		g_loggerPendingDelta = LOGGER_DELTA_NONE;
+		return;
+	}
+
+	EEPROM_WriteByte(Address + 1, Data);
+	EEPROM_WriteByte(Address, Type | g_loggerSequence);
+
+	g_loggerSequence = (g_loggerSequence + 1) & LOGGER_SEQUENCE_MASK;
+	g_loggerHead++;
+	if (g_loggerHead == LOGGER_NUM_OF_RECORDS)
+	{
+		g_loggerHead = 0;
+	}
+	if (g_loggerCount < LOGGER_NUM_OF_RECORDS)
+	{
+		g_loggerCount++;
+	}
+
+	if (Type == LOGGER_TYPE_ABSOLUTE)
+	{
+		g_loggerSinceAbsolute = 0;
+	}
+	else
+	{
+		g_loggerSinceAbsolute++;
+	}
+}
+
+/* Write a half filled delta record so the records stay in time order */
+static void Logger_FlushDelta(void)
+{
+	if (g_loggerPendingDelta != LOGGER_DELTA_NONE)
+	{
+		Logger_Write(LOGGER_TYPE_DELTA, (uint8)(g_loggerPendingDelta << 4) | LOGGER_DELTA_NONE);
+		g_loggerPendingDelta = LOGGER_DELTA_NONE;
+	}
+}
+
+/****************************************************************************************
+ *                                     Functions Definitions                            *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Find the oldest and the newest record by reading the sequence numbers of the whole log area
+ * (blocking, called once at startup) and log LOGGER_EVENT_BOOT.
+ * The SysTick must be initialized and the Global Interrupt enabled.
+ */
+void Logger_Init(const Logger_ConfigType *Config_Ptr)
+{
+	uint16 Place;
+	uint8 Previous;
+	uint8 Tag;
+
+	g_loggerConfigPtr = Config_Ptr;
+
+	Previous = EEPROM_ReadByte(Logger_Address(0));
+	g_loggerHead = 0;
+	g_loggerCount = 0;
+	g_loggerSequence = 0;
+
+	if ((Previous & LOGGER_TYPE_MASK) != LOGGER_TYPE_INVALID)
+	{
+		/* The newest record is the last one before the sequence breaks */
+		for (Place = 1; Place < LOGGER_NUM_OF_RECORDS; Place++)
+		{
+			Tag = EEPROM_ReadByte(Logger_Address(Place));
+
+			if (((Tag & LOGGER_TYPE_MASK) == LOGGER_TYPE_INVALID) ||
+			    ((Tag & LOGGER_SEQUENCE_MASK) != ((Previous + 1) & LOGGER_SEQUENCE_MASK)))
+			{
+				break;
+			}
+			Previous = Tag;
+		}
+
+		g_loggerHead = (Place == LOGGER_NUM_OF_RECORDS) ? 0 : Place;
+		g_loggerSequence = (Previous + 1) & LOGGER_SEQUENCE_MASK;
+
+		/* The log is full when the place after the newest record is already used */
+		Tag = EEPROM_ReadByte(Logger_Address(g_loggerHead));
+		g_loggerCount = ((Tag & LOGGER_TYPE_MASK) == LOGGER_TYPE_INVALID) ? g_loggerHead : LOGGER_NUM_OF_RECORDS;
+	}
+
+	g_loggerHaveReference = FALSE;
+	g_loggerPendingDelta = LOGGER_DELTA_NONE;
+	g_loggerDropped = 0;
+
+	/* Take the first sample in the first call of Logger_Sample */
+	g_loggerLastSampleTime = SysTick_GetTicks() - Config_Ptr -> Sample_Period_Ms;
+
+	Logger_Event(LOGGER_EVENT_BOOT);
+}
+
+/*
+ * Description:
+ * Offer the current temperature, to be called every cycle.
+ * A sample is logged every Sample_Period_Ms as a delta from the previous one when it fits in
+ * 4 bits (two deltas per record), otherwise as an absolute value. Never waits for the EEPROM.
+ */
+void Logger_Sample(uint8 Temperature)
+{
+	sint16 Delta;
+
+	if (SysTick_HasElapsed(g_loggerLastSampleTime, g_loggerConfigPtr -> Sample_Period_Ms) == FALSE)
+	{
+		return;
+	}
+	g_loggerLastSampleTime += g_loggerConfigPtr -> Sample_Period_Ms;
+
+	Delta = (sint16)Temperature - (sint16)g_loggerReference;
+
+	if ((g_loggerHaveReference == FALSE) || (g_loggerSinceAbsolute >= LOGGER_ABSOLUTE_EVERY) ||
+	    (Delta > LOGGER_DELTA_MAX) || (Delta < -LOGGER_DELTA_MAX))
+	{
+		/* Set before the write, which clears it again if the record is dropped */
+		g_loggerHaveReference = TRUE;
+		Logger_FlushDelta();
+		Logger_Write(LOGGER_TYPE_ABSOLUTE, Temperature);
+	}
+	else if (g_loggerPendingDelta == LOGGER_DELTA_NONE)
+	{
+		/* Keep the first delta of the pair in RAM */
+		g_loggerPendingDelta = (uint8)Delta & 0x0F;
+	}
+	else
+	{
+		Logger_Write(LOGGER_TYPE_DELTA, (uint8)(g_loggerPendingDelta << 4) | ((uint8)Delta & 0x0F));
+		g_loggerPendingDelta = LOGGER_DELTA_NONE;
+	}
+
+	g_loggerReference = Temperature;
+}
+
+/*
+ * Description:
+ * Log an event record, never waits for the EEPROM.
+ */
+void Logger_Event(Logger_EventId Event)
+{
+	Logger_FlushDelta();
+	Logger_Write(LOGGER_TYPE_EVENT, Event);
+}
+
+/*
+ * Description:
+ * Return the number of valid records (0 .. LOGGER_NUM_OF_RECORDS).
+ */
+uint16 Logger_GetCount(void)
+{
+	return g_loggerCount;
+}
+
+/*
+ * Description:
+ * Read the record number Index (0 = oldest) into Record_Ptr[0] = TAG and Record_Ptr[1] = DATA.
+ * The read waits for the queued EEPROM writes, call it while EEPROM_IsBusy returns FALSE to keep
+ * the control loop running. Return FALSE if Index is not a valid record.
+ */
+boolean Logger_ReadRecord(uint16 Index, uint8 *Record_Ptr)
+{
+	uint16 Place;
+
+	if (Index >= g_loggerCount)
+	{
+		return FALSE;
+	}
+
+	/* The oldest record is at the head when the log is full, otherwise at place 0 */
+	Place = (g_loggerCount == LOGGER_NUM_OF_RECORDS) ? (g_loggerHead + Index) : Index;
+	if (Place >= LOGGER_NUM_OF_RECORDS)
+	{
+		Place -= LOGGER_NUM_OF_RECORDS;
+	}
+
+	Record_Ptr[0] = EEPROM_ReadByte(Logger_Address(Place));
+	Record_Ptr[1] = EEPROM_ReadByte(Logger_Address(Place) + 1);
+
+	return TRUE;
+}
+
+/*
+ * Description:
+ * Return the number of records which were not logged because the EEPROM write queue was full.
+ * The sample after a dropped record is logged as an absolute value.
+ */
+uint16 Logger_GetDropped(void)
+{
+	return g_loggerDropped;
+}
@@ -0,0 +1,118 @@
+/*****************************************************************************************************************
+ * File Name: LOGGER.h
+ * Date: 19/10/2026
+ * Driver: Wear-Levelled EEPROM History Log Header File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include "Standard_Types.h"
+
+#ifndef LOGGER_H_
+#define LOGGER_H_
+
+/******************************************************************************************
+ *                                    Macros Definitions                                  *
+ ******************************************************************************************/
+
+/*
+ * The log is a circular array of 2-byte records {TAG, DATA} in the EEPROM. Records are written
+ * one after the other around the whole area, so every cell is written once per lap (wear levelling).
+ * TAG = TYPE (bits 7..6) | SEQUENCE (bits 5..0). The sequence counts modulo 64, the place where it
+ * breaks is the oldest record, so no head pointer is stored in the EEPROM. TAG is written after
+ * DATA, so a record torn by a reset is never taken as valid.
+ */
+#define LOGGER_EEPROM_START                  0x0000
+#define LOGGER_NUM_OF_RECORDS                480
+#define LOGGER_RECORD_SIZE                   2
+
+/* Record types, an erased record (0xFF) has the invalid type */
+#define LOGGER_TYPE_ABSOLUTE                 0x00      /* DATA = temperature in C                          */
+#define LOGGER_TYPE_DELTA                    0x40      /* DATA = two 4-bit signed deltas, high nibble first */
+#define LOGGER_TYPE_EVENT                    0x80      /* DATA = Logger_EventId                            */
+#define LOGGER_TYPE_INVALID                  0xC0
+#define LOGGER_TYPE_MASK                     0xC0
+#define LOGGER_SEQUENCE_MASK                 0x3F
+
+/* Delta nibble which means "no sample" (used when only one delta is left) */
+#define LOGGER_DELTA_NONE                    0x08
+#define LOGGER_DELTA_MAX                     7
+
+/* An absolute sample is written at least every LOGGER_ABSOLUTE_EVERY records to decode any part of the log */
+#define LOGGER_ABSOLUTE_EVERY                32
+
+#if ((LOGGER_NUM_OF_RECORDS % (LOGGER_SEQUENCE_MASK + 1)) == 0)
+
+#error "LOGGER_NUM_OF_RECORDS should not be a multiple of the sequence period, the oldest record can not be found"
+
+#endif
+
+/******************************************************************************************
+ *                                     Types Declaration                                  *
+ ******************************************************************************************/
+
+typedef enum
+{
+	LOGGER_EVENT_BOOT,
+	LOGGER_EVENT_FAN_OFF,
+	LOGGER_EVENT_FAN_ON,
+	LOGGER_EVENT_EMERGENCY_OFF,
+	LOGGER_EVENT_EMERGENCY_ON,
+	LOGGER_EVENT_LINK_DOWN,
+	LOGGER_EVENT_LINK_UP,
+	LOGGER_EVENT_WATCHDOG_RESET,
+	LOGGER_EVENT_RATE_ALARM_OFF,
+	LOGGER_EVENT_RATE_ALARM_ON
+}Logger_EventId;
+
+typedef struct
+{
+	uint16 Sample_Period_Ms;       /* time between two logged temperature samples */
+}Logger_ConfigType;
+
+/******************************************************************************************
+ *                                    Functions Prototypes                                *
+ ******************************************************************************************/
+
+/*
+ * Description:
+ * Find the oldest and the newest record by reading the sequence numbers of the whole log area
+ * (blocking, called once at startup) and log LOGGER_EVENT_BOOT.
+ * The SysTick must be initialized and the Global Interrupt enabled.
+ */
+void Logger_Init(const Logger_ConfigType *Config_Ptr);
+
+/*
+ * Description:
+ * Offer the current temperature, to be called every cycle.
+ * A sample is logged every Sample_Period_Ms as a delta from the previous one when it fits in
+ * 4 bits (two deltas per record), otherwise as an absolute value. Never waits for the EEPROM.
+ */
+void Logger_Sample(uint8 Temperature);
+
+/*
+ * Description:
+ * Log an event record, never waits for the EEPROM.
+ */
+void Logger_Event(Logger_EventId Event);
+
+/*
+ * Description:
+ * Return the number of valid records (0 .. LOGGER_NUM_OF_RECORDS).
+ */
+uint16 Logger_GetCount(void);
+
+/*
+ * Description:
+ * Read the record number Index (0 = oldest) into Record_Ptr[0] = TAG and Record_Ptr[1] = DATA.
+ * The read waits for the queued EEPROM writes, call it while EEPROM_IsBusy returns FALSE to keep
+ * the control loop running. Return FALSE if Index is not a valid record.
+ */
+boolean Logger_ReadRecord(uint16 Index, uint8 *Record_Ptr);
+
+/*
+ * Description:
+ * Return the number of records which were not logged because the EEPROM write queue was full.
+ * The sample after a dropped record is logged as an absolute value.
+ */
+uint16 Logger_GetDropped(void);
+
+#endif /* LOGGER_H_ */
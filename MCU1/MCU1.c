@@ -2,35 +2,514 @@
  * [File]: MCU1.c
  * [Date]: 2/9/2023
  * [Objective]: Developing a Smart Fire Fighting System - MCU1.
- * [Drivers]: GPIO - Timer1 - ADC - UART - DC_Motor - LM35 Temperature Sensor - LCD
+ * [Drivers]: GPIO - Timer0 - Timer1 - ADC - UART - DC_Motor - LM35 Temperature Sensors - LCD - INT0 - Power - SysTick - Hysteresis - Link - EEPROM - Config - Logger - Rate-of-Rise - State Machine - Watchdog - Supervisor - Trace - Profiler
  * [Author]: Youssef Ahmed Zaki
  *************************************************************************************************************************/
 #include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
 
 /* MCAL Layer */
 #include "GPIO.h"
 #include "TIMER1.h"
 #include "ADC.h"
 #include "UART.h"
+#include "INT0.h"
+#include "POWER.h"
+#include "EEPROM.h"
+#include "WDG.h"
 
 /* HAL Layer */
 #include "DC_Motor.h"
 #include "LM35.h"
 #include "LCD.h"
 
-#define MCU1_READY                   0x01
-#define MCU2_READY                   0X02
+/* Services */
+#include "SYSTICK.h"
+#include "TRACE.h"
+#include "PROFILER.h"
+#include "HYSTERESIS.h"
+#include "LINK.h"
+#include "CONFIG.h"
+#include "LOGGER.h"
+#include "RATE.h"
+#include "SUPERVISOR.h"
+#include "FSM.h"
 
-/* MCU1 Cases */
-#define SENDING_TEMPERATURE          0
-#define RECEIVING_MOTOR_SPEED        1
+/* Period of the MCU1 control cycle, the CPU sleeps for the rest of the period */
+#define MCU1_CYCLE_PERIOD_MS         50
+
+/* MCU1 is the only sensor node of the bus */
+#define MCU1_NODE_ADDRESS            LINK_SENSOR_NODE_ADDRESS
+
+/* Actuator nodes on the bus, polled in turn at the addresses LINK_ACTUATOR_BASE_ADDRESS + 0 .. N - 1 */
+#define MCU1_NUM_OF_ACTUATOR_NODES   1
+
+#if ((MCU1_NUM_OF_ACTUATOR_NODES == 0) || (MCU1_NUM_OF_ACTUATOR_NODES > LINK_MAX_ACTUATOR_NODES))
+
+#error "MCU1_NUM_OF_ACTUATOR_NODES should be from 1 to LINK_MAX_ACTUATOR_NODES"
+
+#endif
+
+/* A published value is sent again after this time even if it did not change */
+#define LINK_KEEP_ALIVE_MS           1000
+
+/*
+ * The runtime configuration (CONFIG.h) is stored in the EEPROM and changed over the link:
+ * MCU2 sends 70 when its motor reached 70% of the max speed, otherwise 0.
+ * One temperature sample is kept in the EEPROM history every 10 seconds.
+ * An emergency is raised by the button or while the temperature rises faster than 0.15 C/s (RATE.h).
+ * It is latched: it stays on after its cause is gone until a service PC clears it.
+ */
+
+/* Every task must check in at least every 250 ms (5 cycles), the watchdog resets the MCU 520 ms after the last feed */
+#define MCU1_TASK_DEADLINE_MS        250
+
+/* Commands received from a service PC on the bus (PAYLOAD[0] of LINK_COMMAND_TOPIC) */
+#define MCU1_COMMAND_DUMP_LOG        0x01
+
+/* {MCU1_COMMAND_CLEAR_EMERGENCY}, answered with {MCU1_COMMAND_CLEAR_EMERGENCY, STATUS} */
+#define MCU1_COMMAND_CLEAR_EMERGENCY 0x02
+#define MCU1_CLEAR_DONE              0x00
+#define MCU1_CLEAR_REFUSED           0x01         /* the button is still pressed or the temperature still rises fast */
+
+/* {MCU1_COMMAND_GET_AWAKE}, answered with {MCU1_COMMAND_GET_AWAKE, AWAKE %} of the last measurement window */
+#define MCU1_COMMAND_GET_AWAKE       0x03
+
+/* The awake duty of the CPU is measured over windows of this length */
+#define MCU1_AWAKE_WINDOW_MS         1000
+
+/*
+ * The log dump is sent as LINK_REPLY_TOPIC frames {MCU1_COMMAND_DUMP_LOG, INDEX (16-bit), RECORDS},
+ * one frame per cycle to keep the control running: a full frame is 21 characters of 11 bits, about
+ * 24 ms of the 50 ms cycle at 9600 baud. The last frame carries the number of records instead of
+ * the index and no records.
+ */
+#define LOG_DUMP_RECORDS_PER_FRAME   6
+#define LOG_DUMP_FRAMES_PER_CYCLE    1
+
+/*
+ * One LM35 per zone, the hottest zone is the temperature of the system.
+ * Bit i of MCU1_ZONE_CHANNELS selects the ADC channel i (pin i of PORTA), the zones are numbered
+ * from the lowest channel. The board has one sensor, on ADC2.
+ */
+#define MCU1_ZONE_CHANNELS           (1 << 2)
+
+#define MCU1_NUM_OF_ZONES            (((MCU1_ZONE_CHANNELS >> 0) & 1) + ((MCU1_ZONE_CHANNELS >> 1) & 1) + \
+		((MCU1_ZONE_CHANNELS >> 2) & 1) + ((MCU1_ZONE_CHANNELS >> 3) & 1) + ((MCU1_ZONE_CHANNELS >> 4) & 1) + \
+		((MCU1_ZONE_CHANNELS >> 5) & 1) + ((MCU1_ZONE_CHANNELS >> 6) & 1) + ((MCU1_ZONE_CHANNELS >> 7) & 1))
+
+#if ((MCU1_ZONE_CHANNELS == 0) || ((MCU1_ZONE_CHANNELS & ~0xFF) != 0))
+
+#error "MCU1_ZONE_CHANNELS should select from 1 to 8 of the ADC channels 0:7"
+
+#endif
+
+#if ((MCU1_NUM_OF_ZONES > LINK_MAX_ZONES) || (MCU1_NUM_OF_ZONES > LM35_MAX_SENSORS))
+
+#error "MCU1_NUM_OF_ZONES does not fit in the zone summary"
+
+#endif
+
+/* An unconnected input floats and would become the hottest zone, so a zone must not share a pin with the LCD */
+#if ((LCD_BIT_MODE == 8) && (LCD_DATA_PORT == PORTA_ID))
+
+#error "The LCD data port is PORTA, there is no ADC channel left for the zones"
+
+#elif ((LCD_BIT_MODE == 4) && (LCD_DATA_PORT == PORTA_ID) && ((MCU1_ZONE_CHANNELS & ((1 << LCD_DB4_PIN_ID) | \
+		(1 << LCD_DB5_PIN_ID) | (1 << LCD_DB6_PIN_ID) | (1 << LCD_DB7_PIN_ID))) != 0))
+
+#error "MCU1_ZONE_CHANNELS uses a pin of the LCD data bus"
+
+#endif
+
+/*
+ * Fan state machine: the fan runs in FAN_ON only. LINKED is the parent of FAN_OFF and FAN_ON, it is left
+ * when the link is lost (safe local policy: the fan stops and the requests are ignored until it is back).
+ */
+typedef enum
+{
+	MCU1_STATE_LINKED,
+	MCU1_STATE_FAN_OFF,
+	MCU1_STATE_FAN_ON,
+	MCU1_STATE_LINK_LOST,
+	MCU1_NUM_OF_STATES
+}MCU1_StateId;
+
+/* Dispatched every cycle, an event which does not change the state is ignored by the tables */
+typedef enum
+{
+	MCU1_EVENT_LINK_DOWN,
+	MCU1_EVENT_LINK_UP,
+	MCU1_EVENT_FAN_REQUEST,
+	MCU1_EVENT_FAN_RELEASE,
+	MCU1_NUM_OF_EVENTS
+}MCU1_EventId;
+
+/* Emergency state machine: a trigger latches the emergency, only the clear command releases it */
+typedef enum
+{
+	EMERGENCY_STATE_CLEAR,
+	EMERGENCY_STATE_LATCHED,
+	EMERGENCY_NUM_OF_STATES
+}Emergency_StateId;
+
+typedef enum
+{
+	EMERGENCY_EVENT_TRIGGER,       /* dispatched every cycle while the button is pressed or the rate alarm is on */
+	EMERGENCY_EVENT_CLEAR,         /* dispatched by the clear command when there is no trigger any more       */
+	EMERGENCY_NUM_OF_EVENTS
+}Emergency_EventId;
 /********************************************************************************************************
  *                                                                                                      *
  *                                             * Global Variables *                                     *
  *                                                                                                      *
  ********************************************************************************************************/
 
-uint8 MCU1_Sequence = 0;
+/* One bit per actuator node which reported that its motor reached 70% */
+static uint8 g_fanRequests = 0;
+
+/* The fan threshold is read in place from the configuration, the confirmation is copied by MCU1_ApplyConfig */
+static Hysteresis_ConfigType g_fanStateConfig = {&CONFIG_VALUE(CONFIG_FAN_ON_CODE), 1, 0, 0};
+
+static const uint16 g_buttonThresholds[] = {LOGIC_HIGH};
+static Hysteresis_ConfigType g_buttonConfig = {g_buttonThresholds, 1, 0, 0};
+
+/*
+ * Publishing rules indexed by Link_TopicId {Destination, Delta, Keep Alive, Max Value}:
+ * The zone summary (LINK_ZONES_TOPIC) and the emergency state are broadcast to all the actuator nodes,
+ * the summary on every 1 C change of a zone and the emergency state on every change.
+ * The heartbeat keeps the actuator nodes from falling back to their safe policy.
+ */
+static const Link_TopicConfigType g_linkTopics[LINK_NUM_OF_TOPICS] =
+{
+	{LINK_BROADCAST_ADDRESS,   1, LINK_KEEP_ALIVE_MS,       LINK_MAX_TEMPERATURE},   /* LINK_TOPIC_TEMPERATURE */
+	{LINK_BROADCAST_ADDRESS,   1, LINK_KEEP_ALIVE_MS,       LOGIC_HIGH},             /* LINK_TOPIC_EMERGENCY   */
+	{LINK_SENSOR_NODE_ADDRESS, 1, LINK_KEEP_ALIVE_MS,       0xFF},                   /* LINK_TOPIC_FAN_STATE   */
+	{LINK_BROADCAST_ADDRESS,   1, LINK_HEARTBEAT_PERIOD_MS, LINK_UP}                 /* LINK_TOPIC_HEARTBEAT   */
+};
+
+static const Link_ConfigType g_linkConfig = {MCU1_NODE_ADDRESS, g_linkTopics, MCU1_NUM_OF_ACTUATOR_NODES};
+
+/* Temperature bar graph on the whole second line of the LCD, full at the max LM35 temperature */
+static const LCD_BarGraphConfigType g_tempBarConfig = {1, 0, 16, MAX_LM35_TEMPERATURE};
+static LCD_BarGraphType g_tempBar;
+
+/* Zone i is read from the ADC channel g_zoneChannels[i], filled from MCU1_ZONE_CHANNELS, all of them are converted in one scan */
+static InputChannel_Select g_zoneChannels[MCU1_NUM_OF_ZONES];
+static const LM35_ConfigType g_lm35Config = {g_zoneChannels, MCU1_NUM_OF_ZONES};
+
+/* The screen is drawn once the LCD finished its initialization in the background */
+static boolean g_displayReady = FALSE;
+
+static Logger_ConfigType g_loggerConfig;
+
+/* Deadlines of the supervised tasks indexed by Supervisor_TaskId */
+static const uint16 g_taskDeadlines[SUPERVISOR_NUM_OF_TASKS] =
+{
+	MCU1_TASK_DEADLINE_MS,         /* SUPERVISOR_TASK_SENSOR   */
+	MCU1_TASK_DEADLINE_MS,         /* SUPERVISOR_TASK_LINK     */
+	MCU1_TASK_DEADLINE_MS,         /* SUPERVISOR_TASK_ACTUATOR */
+	MCU1_TASK_DEADLINE_MS          /* SUPERVISOR_TASK_DISPLAY  */
+};
+
+static const Supervisor_ConfigType g_supervisorConfig = {g_taskDeadlines, WDG_TIMEOUT_520_MS};
+
+/* Awake duty of the CPU in the last measurement window */
+static uint8 g_awakePercent = 100;
+
+/* Log dump in progress */
+static boolean g_logDumpActive = FALSE;
+static uint16 g_logDumpIndex;
+static uint8 g_logDumpDestination;
+
+/*
+ * Timer1 PWM Mode Configuration (the timer runs only while the fan is on):
+ * 1. TCNT1 = 0 -> Starting Value of Timer is Zero.
+ * 2. OCR1A = 0 -> It is based on the Duty_Cycle of the PWM Signal.
+ * 3. Pre-scalar = F_CPU/8 -> To control DC motor using 500Hz PWM Signal.
+ * 4. Timer1 Mode -> Fast PWM Mode - 8-bit.
+ */
+static const Timer1_ConfigType g_timer1Config = {0, 0, TIMER1_Prescaler_8, TIMER1_Fast_Pwm_10_Bit_7};
+
+/* The emergency is also cleared by the command handler, the trigger is evaluated every cycle */
+static Fsm_Type g_emergencyMachine;
+static boolean g_emergencyTrigger = FALSE;
+
+/********************************************************************************************************
+ *                                                                                                      *
+ *                                          * State Machine Tables *                                    *
+ *                                                                                                      *
+ ********************************************************************************************************/
+
+static void MCU1_FanOnEntry(void);
+static void MCU1_FanOnExit(void);
+static void MCU1_LinkedExit(void);
+static void MCU1_LinkLostExit(void);
+static void MCU1_EmergencyEntry(void);
+static void MCU1_EmergencyExit(void);
+
+/* Fan states {Parent, Entry, Exit} */
+static const Fsm_StateType g_fanStates[MCU1_NUM_OF_STATES] PROGMEM =
+{
+	{FSM_NO_PARENT,     NULL_PTR,        MCU1_LinkedExit},       /* MCU1_STATE_LINKED    */
+	{MCU1_STATE_LINKED, NULL_PTR,        NULL_PTR},              /* MCU1_STATE_FAN_OFF   */
+	{MCU1_STATE_LINKED, MCU1_FanOnEntry, MCU1_FanOnExit},        /* MCU1_STATE_FAN_ON    */
+	{FSM_NO_PARENT,     NULL_PTR,        MCU1_LinkLostExit}      /* MCU1_STATE_LINK_LOST */
+};
+
+/* Fan transitions [State][Event]: LINK_DOWN, LINK_UP, FAN_REQUEST, FAN_RELEASE */
+static const uint8 g_fanTransitions[MCU1_NUM_OF_STATES][MCU1_NUM_OF_EVENTS] PROGMEM =
+{
+	{MCU1_STATE_LINK_LOST, FSM_IGNORE,         FSM_IGNORE,         FSM_IGNORE},          /* LINKED    */
+	{FSM_UNHANDLED,        FSM_UNHANDLED,      MCU1_STATE_FAN_ON,  FSM_UNHANDLED},       /* FAN_OFF   */
+	{FSM_UNHANDLED,        FSM_UNHANDLED,      FSM_UNHANDLED,      MCU1_STATE_FAN_OFF},  /* FAN_ON    */
+	{FSM_IGNORE,           MCU1_STATE_FAN_OFF, FSM_IGNORE,         FSM_IGNORE}           /* LINK_LOST */
+};
+
+/* The link is down at startup and the fan is stopped by DcMotor_Init */
+static const Fsm_ConfigType g_fanConfig = {g_fanStates, &g_fanTransitions[0][0], MCU1_NUM_OF_EVENTS, MCU1_STATE_LINK_LOST};
+
+/* Emergency states {Parent, Entry, Exit} */
+static const Fsm_StateType g_emergencyStates[EMERGENCY_NUM_OF_STATES] PROGMEM =
+{
+	{FSM_NO_PARENT, NULL_PTR,            NULL_PTR},              /* EMERGENCY_STATE_CLEAR   */
+	{FSM_NO_PARENT, MCU1_EmergencyEntry, MCU1_EmergencyExit}     /* EMERGENCY_STATE_LATCHED */
+};
+
+/* Emergency transitions [State][Event]: TRIGGER, CLEAR */
+static const uint8 g_emergencyTransitions[EMERGENCY_NUM_OF_STATES][EMERGENCY_NUM_OF_EVENTS] PROGMEM =
+{
+	{EMERGENCY_STATE_LATCHED, FSM_IGNORE},                       /* CLEAR   */
+	{FSM_IGNORE,              EMERGENCY_STATE_CLEAR}             /* LATCHED */
+};
+
+static const Fsm_ConfigType g_emergencyConfig = {g_emergencyStates, &g_emergencyTransitions[0][0], EMERGENCY_NUM_OF_EVENTS, EMERGENCY_STATE_CLEAR};
+
+/********************************************************************************************************
+ *                                                                                                      *
+ *                                            * Link Call Back Function *                               *
+ *                                                                                                      *
+ ********************************************************************************************************/
+
+/* Called by Link_Poll for every frame: keep the fan request of every actuator node */
+static void MCU1_LinkHandler(uint8 Source, Link_TopicId Topic, uint16 Value)
+{
+	uint8 Node = Source - LINK_ACTUATOR_BASE_ADDRESS;
+
+	if ((Topic == LINK_TOPIC_FAN_STATE) && (Node < LINK_MAX_ACTUATOR_NODES))
+	{
+		if (Value == CONFIG_VALUE(CONFIG_FAN_ON_CODE))
+		{
+			g_fanRequests |= (1 << Node);
+		}
+		else
+		{
+			g_fanRequests &= ~(1 << Node);
+		}
+	}
+}
+
+/* Take the configuration values which are copied in the settings of the services, called at startup and on every change */
+static void MCU1_ApplyConfig(void)
+{
+	g_fanStateConfig.Confirm_Samples = CONFIG_VALUE(CONFIG_CONFIRM_SAMPLES);
+	g_buttonConfig.Confirm_Samples = CONFIG_VALUE(CONFIG_CONFIRM_SAMPLES);
+	g_loggerConfig.Sample_Period_Ms = CONFIG_VALUE(CONFIG_LOGGER_SAMPLE_PERIOD_MS);
+	Rate_SetLimit(CONFIG_VALUE(CONFIG_RATE_OF_RISE_LIMIT));
+}
+
+/* Called by Link_Poll for every command frame */
+static void MCU1_CommandHandler(uint8 Source, const uint8 *Payload_Ptr, uint8 Length)
+{
+	uint8 Reply[2];
+
+	switch (Payload_Ptr[0])
+	{
+	case MCU1_COMMAND_DUMP_LOG:
+		if (Length != 1)
+		{
+			/* Malformed command, there is nothing to answer */
+			break;
+		}
+
+		/* Start (or restart) sending the whole log to the requester */
+		g_logDumpActive = TRUE;
+		g_logDumpIndex = 0;
+		g_logDumpDestination = Source;
+		break;
+
+	case MCU1_COMMAND_CLEAR_EMERGENCY:
+		if (Length != 1)
+		{
+			break;
+		}
+
+		/* An emergency whose cause is still there cannot be cleared */
+		Reply[0] = MCU1_COMMAND_CLEAR_EMERGENCY;
+		Reply[1] = MCU1_CLEAR_DONE;
+		if (g_emergencyTrigger == TRUE)
+		{
+			Reply[1] = MCU1_CLEAR_REFUSED;
+		}
+		else
+		{
+			Fsm_Dispatch(&g_emergencyMachine, EMERGENCY_EVENT_CLEAR);
+		}
+		Link_Send(Source, LINK_REPLY_TOPIC, Reply, 2);
+		break;
+
+	case MCU1_COMMAND_GET_AWAKE:
+		if (Length != 1)
+		{
+			break;
+		}
+
+		Reply[0] = MCU1_COMMAND_GET_AWAKE;
+		Reply[1] = g_awakePercent;
+		Link_Send(Source, LINK_REPLY_TOPIC, Reply, 2);
+		break;
+
+	default:
+		/* The services answer their own commands */
+		if (Profiler_HandleCommand(Source, Payload_Ptr, Length) == FALSE)
+		{
+			Config_HandleCommand(Source, Payload_Ptr, Length);
+		}
+		break;
+	}
+}
+
+/*
+ * Send the next part of the log dump, oldest record first.
+ * An EEPROM read waits for the queued writes, so the dump waits for a cycle with no write pending.
+ */
+static void MCU1_LogDumpTask(void)
+{
+	uint8 Frame[3 + (LOG_DUMP_RECORDS_PER_FRAME * LOGGER_RECORD_SIZE)];
+	uint8 Frames;
+	uint8 Length;
+	uint8 Records;
+
+	if (EEPROM_IsBusy() == TRUE)
+	{
+		return;
+	}
+
+	for (Frames = 0; (Frames < LOG_DUMP_FRAMES_PER_CYCLE) && (g_logDumpActive == TRUE); Frames++)
+	{
+		Frame[0] = MCU1_COMMAND_DUMP_LOG;
+		Frame[1] = (uint8)g_logDumpIndex;
+		Frame[2] = (uint8)(g_logDumpIndex >> 8);
+		Length = 3;
+
+		for (Records = 0; Records < LOG_DUMP_RECORDS_PER_FRAME; Records++)
+		{
+			if (Logger_ReadRecord(g_logDumpIndex, &Frame[Length]) == FALSE)
+			{
+				break;
+			}
+			Length += LOGGER_RECORD_SIZE;
+			g_logDumpIndex++;
+		}
+
+		if (Records == 0)
+		{
+			/* End of the log: the index field carries the number of records */
+			g_logDumpActive = FALSE;
+		}
+
+		Link_Send(g_logDumpDestination, LINK_REPLY_TOPIC, Frame, Length);
+	}
+}
+
+/********************************************************************************************************
+ *                                                                                                      *
+ *                                          * State Entry/Exit Functions *                              *
+ *                                                                                                      *
+ ********************************************************************************************************/
+
+static void MCU1_FanOnEntry(void)
+{
+	Logger_Event(LOGGER_EVENT_FAN_ON);
+
+	/* Initialize the Timer1 in PWM mode */
+	Timer1_PWM_Mode_Init(&g_timer1Config);
+
+	/* Start the fan */
+	DcMotor_Rotate(CW, 100);
+}
+
+static void MCU1_FanOnExit(void)
+{
+	/* Stop the fan */
+	DcMotor_Rotate(STOP, 0);
+
+	/* Stop the timer */
+	Timer1_DeInit();
+
+	Logger_Event(LOGGER_EVENT_FAN_OFF);
+}
+
+/* Log the link losses and recoveries */
+static void MCU1_LinkedExit(void)
+{
+	Logger_Event(LOGGER_EVENT_LINK_DOWN);
+}
+
+static void MCU1_LinkLostExit(void)
+{
+	Logger_Event(LOGGER_EVENT_LINK_UP);
+}
+
+/* The actuator nodes are told at once, before the other frames of the cycle */
+static void MCU1_EmergencyEntry(void)
+{
+	Link_SendEmergency(LOGIC_HIGH);
+	Logger_Event(LOGGER_EVENT_EMERGENCY_ON);
+}
+
+static void MCU1_EmergencyExit(void)
+{
+	Link_SendEmergency(LOGIC_LOW);
+	Logger_Event(LOGGER_EVENT_EMERGENCY_OFF);
+}
+
+/********************************************************************************************************
+ *                                                                                                      *
+ *                                             * Display Function *                                     *
+ *                                                                                                      *
+ ********************************************************************************************************/
+
+/* Show the temperature of the hottest zone and its bar, nothing is displayed until the LCD is initialized */
+static void MCU1_DisplayTask(uint8 Temp, uint8 Zone)
+{
+	if (LCD_InitTask() == FALSE)
+	{
+		return;
+	}
+
+	if (g_displayReady == FALSE)
+	{
+		/* Display this message always on the LCD Screen */
+		LCD_DisplayString_P(PSTR("Temp =    C  Z"));
+		LCD_BarGraphInit(&g_tempBar, &g_tempBarConfig);
+		g_displayReady = TRUE;
+	}
+
+	/* Move the cursor to write the read temperature */
+	LCD_MoveCursor(0,7);
+
+	/* Display the temperature on LCD, right aligned in 3 places so a shorter value leaves no old digits */
+	LCD_DisplayNumber(Temp, 3);
+
+	/* Zones are numbered from 1 on the screen */
+	LCD_MoveCursor(0,14);
+	LCD_DisplayNumber(Zone + 1, 1);
+
+	/* Redraw only the cells of the temperature bar which changed */
+	LCD_BarGraphUpdate(&g_tempBar, Temp);
+}
 
 /********************************************************************************************************
  *                                                                                                      *
@@ -40,7 +519,19 @@ uint8 MCU1_Sequence = 0;
 int main(void)
 {
 	uint8 Temp = 0;
-	uint8 Receive_Speed;
+	uint16 Temp_Tenths = 0;
+	uint8 Zone;
+	InputChannel_Select Channel;
+	LM35_SummaryType Summary;
+	Link_ZonesType Zones;
+	uint16 Cycle_Start;
+	uint16 Awake_Window_Start = 0;
+	Fsm_Type Fan_Machine;
+	Hysteresis_Type Fan_State;
+	Hysteresis_Type Emergency_Button;
+#if (LINK_BENCHMARK_ENABLE == 1)
+	Link_BenchmarkType Benchmark;
+#endif
 	/********************************************************************************************************
 	 *                                                                                                      *
 	 *                                         * Drivers Configurations *                                   *
@@ -51,28 +542,18 @@ int main(void)
 	 * ADC Configuration:
 	 * Voltage Reference = AREF
 	 * Pre-scaler = F_CPU/8
-	 * Free Running Mode
+	 * Single Conversion Mode -> Every reading starts its own conversion and waits for the ADC interrupt.
 	 */
-	ADC_ConfigType ADC_Config = {ADC_AREF, CLK_8, Free_Running};
-
-	/*
-	 * Timer1 PWM Mode Configuration:
-	 * 1. TCNT1 = 0 -> Starting Value of Timer is Zero.
-	 * 2. OCR1A = 0 -> It is based on the Duty_Cycle of the PWM Signal.
-	 * 3. Pre-scalar = F_CPU/8 -> To control DC motor using 500Hz PWM Signal.
-	 * 4. Timer1 Mode -> Fast PWM Mode - 8-bit.
-	 */
-	Timer1_ConfigType Timer1_Config = {0, 0, TIMER1_Prescaler_8, TIMER1_Fast_Pwm_10_Bit_7};
+	ADC_ConfigType ADC_Config = {ADC_AREF, CLK_8, Single_Conversion};
 
 	/*
 	 * UART Configuration:
 	 * 1. UART Mode -> Asynchronous Mode.
-	 * 2. Data Transmission Speed Mode -> Double Speed Mode.
-	 * 3. Parity Bit State -> Disabled.
-	 * 4. Data Size in Bits -> Eight bits.
-	 * 5. Baud Rate -> 9600.
+	 * 2. Parity Bit State -> Disabled.
+	 * 3. Data Size in Bits -> Nine bits, the ninth bit marks the node address of the multi-drop bus.
+	 * 4. Baud Rate -> UART_BAUD_RATE (9600), the speed mode is selected at compile time.
 	 */
-	UART_ConfigType UART_Config = {Asynchronous, Double_Speed, Disabled, 0, Eight_Bit_3, 9600};
+	UART_ConfigType UART_Config = {Asynchronous, Disabled, One_Bit, Nine_Bit_7};
 
 	/********************************************************************************************************
 	 *                                                                                                      *
@@ -80,23 +561,87 @@ int main(void)
 	 *                                                                                                      *
 	 ********************************************************************************************************/\
 
-	 ADC_Init(&ADC_Config);
-	 UART_Init(&UART_Config);
+	 SysTick_Init();
+	 Trace_Init();
+
+	 /* Enable the Global Interrupts for the system tick and the ADC conversion complete interrupt */
+	 sei();
 
+	 /* Staged boot, stage 1 - safety: the fan stopped in less than a millisecond after a reset */
 	 DcMotor_Init();
-	 LCD_Init();
 
-	 /* let the pin 2 in in PORTD as input pin to be connected with push button */
-	 GPIO_SetupPinDirection(PORTD_ID, PIN2_ID, INPUT_PIN);
+	 /* Calibrate the profiler after the interrupts are enabled, the SysTick must be running */
+	 Profiler_Init();
 
-	 /* let the pin 2 in in PORTA (ADC channel 0) as input pin to be connected with LM35 Temperature Sensor */
-	 GPIO_SetupPinDirection(PORTA_ID, PIN0_ID, INPUT_PIN);
+	 /* Stage 2 - control: the sensor and the link */
+	 ADC_Init(&ADC_Config);
+	 UART_Init(&UART_Config);
 
-	 /* Display this message always on the LCD Screen */
-	 LCD_DisplayString("Temp =    C");
+	 /* Stage 3 - display: the LCD power-on delay and commands run in the background, see MCU1_DisplayTask */
+	 LCD_StartInit();
+
+	 /*
+	  * let the pin 2 in in PORTD (INT0) as input pin to be connected with push button.
+	  * The interrupt has no Call Back, it only wakes the CPU up from the sleep in the UART waits.
+	  */
+	 INT0_Init(INT0_Any_Logical_Change);
+
+	 /*
+	  * let the pins of MCU1_ZONE_CHANNELS in PORTA (pin 2, ADC channel 2) as input pins to be connected with the LM35 of every zone,
+	  * then wait for the first scan (less than 1 ms) so the control starts with real temperatures.
+	  */
+	 Zone = 0;
+	 for (Channel = ADC0; Channel <= ADC7; Channel++)
+	 {
+		 if ((MCU1_ZONE_CHANNELS & (1 << Channel)) != 0)
+		 {
+			 g_zoneChannels[Zone] = Channel;
+			 Zone++;
+		 }
+	 }
+	 LM35_Init(&g_lm35Config);
+	 while (LM35_Task() == FALSE);
+
+	 /* Load the configuration from the EEPROM, the defaults are used when the block is not valid */
+	 Config_Init();
+	 Rate_Init(CONFIG_VALUE(CONFIG_RATE_OF_RISE_LIMIT));
+	 MCU1_ApplyConfig();
+	 Config_SetCallBack(MCU1_ApplyConfig);
+
+	 /* The fan and the emergency button change only on confirmed transitions */
+	 Hysteresis_Init(&Fan_State, &g_fanStateConfig);
+	 Hysteresis_Init(&Emergency_Button, &g_buttonConfig);
+
+	 /* The behaviour of the fan and of the emergency is in the state machine tables */
+	 Fsm_Init(&Fan_Machine, &g_fanConfig);
+	 Fsm_Init(&g_emergencyMachine, &g_emergencyConfig);
+
+	 /* Join the bus as the sensor node, the actuator nodes report their fan requests to MCU1_LinkHandler */
+	 Link_Init(&g_linkConfig);
+	 Link_SetCallBack(MCU1_LinkHandler);
+	 Link_SetCommandCallBack(MCU1_CommandHandler);
+
+	 /* Find the end of the temperature history in the EEPROM and log the boot */
+	 Logger_Init(&g_loggerConfig);
+
+#if (LINK_BENCHMARK_ENABLE == 1)
+	 /* Benchmark build: MCU1 sends benchmark frames, then shows its sending rate and stops */
+	 Link_Benchmark(TRUE, LINK_BENCHMARK_DURATION_MS, &Benchmark);
+	 while (LCD_InitTask() == FALSE);
+	 LCD_DisplayStringRowColumn_P(1, 0, PSTR("TX FPS = "));
+	 LCD_IntegerToString(Benchmark.Frames_Per_Second);
+	 while (1);
+#endif
+
+	 /* Keep the reset cause in the EEPROM and start the watchdog, the blocking startup steps are over */
+	 Supervisor_Init(&g_supervisorConfig);
+	 if (Supervisor_GetResetCause() & WDG_RESET_WATCHDOG)
+	 {
+		 Logger_Event(LOGGER_EVENT_WATCHDOG_RESET);
+	 }
 
-	 /* Wait until MCU2 is ready */
-	 while (UART_ReceiveByte() != MCU2_READY);
+	 /* End of the boot: the argument is the boot-to-control time in ms (from SysTick_Init, the first statement) */
+	 TRACE_EVENT(TRACE_EVENT_BOOT_DONE, SysTick_GetTicks());
 
 	 /********************************************************************************************************
 	  *                                                                                                      *
@@ -106,78 +651,108 @@ int main(void)
 
 	 while (1)
 	 {
-		 /* Read the temperature from the sensor */
-		 Temp = LM35_GetTemperature();
+		 Cycle_Start = SysTick_GetTicks();
 
-		 /* Move the cursor to write the read temperature */
-		 LCD_MoveCursor(0,7);
+		 /* Take the zones converted in the background since the last cycle and start the next scan */
+		 LM35_Task();
+		 LM35_GetSummary(&Summary);
+		 Temp_Tenths = Summary.Max;
+		 Temp = (uint8)(Temp_Tenths / 10);
 
-		 if (Temp >= 100)
+		 /* A fire is detected early by a fast rise, before the temperature itself is high */
+		 PROF_BEGIN(PROF_RATE_UPDATE);
+		 if (Rate_Update(Temp_Tenths))
 		 {
-			 /* Display the temperature on LCD */
-			 LCD_IntegerToString(Temp);
+			 TRACE_EVENT(TRACE_EVENT_STATE_CHANGE, Rate_IsAlarm());
+			 Logger_Event((Rate_IsAlarm() == TRUE) ? LOGGER_EVENT_RATE_ALARM_ON : LOGGER_EVENT_RATE_ALARM_OFF);
 		 }
-		 else
-		 {
-			 /* Display the temperature on LCD */
-			 LCD_IntegerToString(Temp);
+		 PROF_END(PROF_RATE_UPDATE);
+		 Supervisor_CheckIn(SUPERVISOR_TASK_SENSOR);
 
-			 /* Put space in next place when the number is one or two digits to prevent noises on LCD */
-			 LCD_DisplayCharacter(' ');
+		 /* Debounce the emergency button every cycle */
+		 if (Hysteresis_Update(&Emergency_Button, GPIO_ReadPin(PORTD_ID, PIN2_ID)))
+		 {
+			 TRACE_EVENT(TRACE_EVENT_STATE_CHANGE, Hysteresis_GetLevel(&Emergency_Button));
 		 }
 
-		 switch(MCU1_Sequence)
+		 /* Latch the emergency on the button or a fast rise, the emergency frame is the first frame of the cycle */
+		 g_emergencyTrigger = ((Hysteresis_GetLevel(&Emergency_Button) == LOGIC_HIGH) || (Rate_IsAlarm() == TRUE)) ? TRUE : FALSE;
+		 if (g_emergencyTrigger == TRUE)
 		 {
-		 case SENDING_TEMPERATURE:
+			 Fsm_Dispatch(&g_emergencyMachine, EMERGENCY_EVENT_TRIGGER);
+		 }
 
-			 /* Synchronization between two MCUs to send/receive data */
-			 UART_SendByte(MCU1_READY);
-			 while (UART_ReceiveByte() != MCU2_READY);
+		 /* Keep the temperature history, the EEPROM is written in the background */
+		 Logger_Sample(Temp);
 
-			 if (GPIO_ReadPin(PORTD_ID, PIN2_ID) == LOGIC_HIGH)
-			 {
-				 /* Send this serial code to MCU2 to start slowing down the motor */
-				 UART_SendByte(200);
-			 }
-			 else
-			 {
-				 /* Send the temperature to MCU2 */
-				 UART_SendByte(Temp);
-			 }
+		 /* Publish the zone summary and the latched emergency state, frames are sent only when they changed */
+		 Zones.Num_Of_Zones = MCU1_NUM_OF_ZONES;
+		 Zones.Max_Zone = Summary.Max_Zone;
+		 Zones.Max = Summary.Max;
+		 Zones.Mean = Summary.Mean;
+		 for (Zone = 0; Zone < MCU1_NUM_OF_ZONES; Zone++)
+		 {
+			 Zones.Zones[Zone] = (uint8)(LM35_GetZoneTemperatureTenths(Zone) / 10);
+		 }
+		 Link_PublishZones(&Zones);
+		 Link_Publish(LINK_TOPIC_EMERGENCY, Fsm_IsIn(&g_emergencyMachine, EMERGENCY_STATE_LATCHED) ? LOGIC_HIGH : LOGIC_LOW);
+
+		 /* Show the temperature, the LCD is initialized in the background during the first cycles */
+		 MCU1_DisplayTask(Temp, Summary.Max_Zone);
+		 Supervisor_CheckIn(SUPERVISOR_TASK_DISPLAY);
+
+		 /* Read the frames received from the actuator nodes, the fan requests are kept by MCU1_LinkHandler */
+		 PROF_BEGIN(PROF_LINK_POLL);
+		 Link_Poll();
+		 PROF_END(PROF_LINK_POLL);
+		 Supervisor_CheckIn(SUPERVISOR_TASK_LINK);
+
+		 /*
+		  * Safe local policy: the request of an actuator node which missed its turn is forgotten, it is sent again
+		  * when the node answers a later turn. Without a link, all the requests are forgotten and the fan stops.
+		  */
+		 g_fanRequests &= Link_GetAliveNodes();
+		 if (Link_GetState() != LINK_UP)
+		 {
+			 g_fanRequests = 0;
+		 }
 
-			 /* Move to the next step */
-			 MCU1_Sequence++;
-			 break;
+		 /* The fan runs when any actuator node requests it, the state machine re-configures it only when this really changed */
+		 Hysteresis_Update(&Fan_State, (g_fanRequests != 0) ? CONFIG_VALUE(CONFIG_FAN_ON_CODE) : 0);
+		 Fsm_Dispatch(&Fan_Machine, (Link_GetState() == LINK_UP) ? MCU1_EVENT_LINK_UP : MCU1_EVENT_LINK_DOWN);
+		 Fsm_Dispatch(&Fan_Machine, (Hysteresis_GetLevel(&Fan_State) == 1) ? MCU1_EVENT_FAN_REQUEST : MCU1_EVENT_FAN_RELEASE);
+		 Supervisor_CheckIn(SUPERVISOR_TASK_ACTUATOR);
 
-		 case RECEIVING_MOTOR_SPEED:
+		 /* Low priority tasks: save the configuration, send the requested log dump */
+		 Config_Task();
+		 MCU1_LogDumpTask();
 
-			 /* Synchronization between two MCUs to send/receive data */
-			 while (UART_ReceiveByte() != MCU2_READY);
-			 UART_SendByte(MCU1_READY);
+		 /* Measure the awake duty of the CPU, the service PC reads the last window */
+		 if (SysTick_HasElapsed(Awake_Window_Start, MCU1_AWAKE_WINDOW_MS))
+		 {
+			 g_awakePercent = Power_GetAwakePercent();
+			 Awake_Window_Start = SysTick_GetTicks();
+		 }
 
-			 /* Receive the DC Motor Speed from MCU2 through UART */
-			 Receive_Speed = UART_ReceiveByte();
+		 /* Feed the watchdog only if every task ran in time */
+		 Supervisor_Service();
 
-			 if (Receive_Speed == 70)
-			 {
-				 /* Initialize the Timer1 in PWM mode */
-				 Timer1_PWM_Mode_Init(&Timer1_Config);
+		 /*
+		  * Nothing else to run until the next cycle: sleep, but keep reading the link, initializing the LCD
+		  * and sending the recorded trace events to the service PC while the UART transmitter is free
+		  */
+		 while (SysTick_HasElapsed(Cycle_Start, MCU1_CYCLE_PERIOD_MS) == FALSE)
+		 {
+			 Link_Poll();
+			 LCD_InitTask();
+			 Trace_StreamTask();
 
-				 /* Start the fan */
-				 DcMotor_Rotate(CW, 100);
-			 }
-			 else
+			 cli();
+			 if (UART_Available() == 0)
 			 {
-				 /* Stop the fan */
-				 DcMotor_Rotate(STOP, 0);
-
-				 /* Stop the timer */
-				 Timer1_DeInit();
+				 Power_Sleep(POWER_IDLE);
 			 }
-
-			 /* return to the previous step */
-			 MCU1_Sequence--;
-			 break;
+			 sei();
 		 }
 	 }
 }
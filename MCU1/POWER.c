@@ -0,0 +1,77 @@
+/*******************************************************************************************************************
+ * File Name: POWER.c
+ * Date: 19/10/2026
+ * Driver: ATmega32 Power Management (Sleep Modes) Driver Source File
+ * Author: Youssef Zaki
+ ******************************************************************************************************************/
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include "POWER.h"
+#include "SYSTICK.h"
+#include "Common_Macros.h"
+
+/***************************************************************************************
+ *                                         Global Variables                            *
+ ***************************************************************************************/
+
+/* SysTick fine-time counts spent in sleep since the start of the current window */
+static uint32 g_sleepCounts = 0;
+
+/* SysTick tick at the start of the current measurement window */
+static uint16 g_windowStart = 0;
+
+/****************************************************************************************
+ *                                      Functions Definitions                           *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Put the CPU into the required sleep mode until the next interrupt.
+ * 1. Must be called with the Global Interrupt disabled, after checking the wake-up condition,
+ *    so an interrupt cannot be lost between the check and the sleep instruction.
+ * 2. Select the sleep mode by SM2:0 bits and set SE bit in MCUCR Register.
+ * 3. Enable the interrupts and sleep (the instruction after SEI is always executed first).
+ * 4. After the wake-up, clear SE bit and return with the Global Interrupt disabled again.
+ * 5. Time spent in sleep is accumulated for Power_GetAwakePercent.
+ */
+void Power_Sleep(Power_SleepMode Mode)
+{
+	uint16 Start = SysTick_GetFineTime();
+
+	/* MCUCR & 1000 1111 (SM2:0) | Mode */
+	MCUCR = (MCUCR & 0x8F) | (Mode << SM0);
+	SET_BIT(MCUCR, SE);
+
+	sei();
+	sleep_cpu();
+
+	CLEAR_BIT(MCUCR, SE);
+	cli();
+
+	g_sleepCounts += (uint16)(SysTick_GetFineTime() - Start);
+}
+
+/*
+ * Description:
+ * Return the percentage of time the CPU was awake since the previous call and start a new window.
+ * The window must be shorter than 65.5 seconds (SysTick ticks wrap around), so call it periodically.
+ */
+uint8 Power_GetAwakePercent(void)
+{
+	uint16 Now = SysTick_GetTicks();
+	uint32 Window_Counts = (uint32)(uint16)(Now - g_windowStart) * SYSTICK_COUNTS_PER_TICK;
+	uint32 Sleep_Percent;
+	uint8 Awake_Percent = 100;
+
+	if (Window_Counts >= 100)
+	{
+		Sleep_Percent = g_sleepCounts / (Window_Counts / 100);
+		Awake_Percent = (Sleep_Percent >= 100) ? 0 : (uint8)(100 - Sleep_Percent);
+	}
+
+	g_windowStart = Now;
+	g_sleepCounts = 0;
+
+	return Awake_Percent;
+}
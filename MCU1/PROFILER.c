@@ -0,0 +1,157 @@
+/*****************************************************************************************************************
+ * File Name: PROFILER.c
+ * Date: 19/10/2026
+ * Driver: Hot-Path Cycle Profiler Source File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include "PROFILER.h"
+#include "SYSTICK.h"
+#include "LINK.h"
+
+#if (PROFILER_ENABLE == 1)
+
+/******************************************************************************************
+ *                                     Types Declaration                                  *
+ ******************************************************************************************/
+
+/* One row of the profiling table, all times in SysTick fine-time counts */
+typedef struct
+{
+	uint16 Start;
+	uint16 Calls;
+	uint16 Min;
+	uint16 Max;
+	uint32 Total;
+}Profiler_RowType;
+
+/***************************************************************************************
+ *                                         Global Variables                            *
+ ***************************************************************************************/
+
+static Profiler_RowType g_profTable[PROF_NUM_OF_SECTIONS];
+
+/* Cost of an empty PROF_BEGIN/PROF_END pair in counts */
+static uint16 g_profOverhead = 0;
+
+/****************************************************************************************
+ *                                     Functions Definitions                            *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Clear the table and measure the cost of an empty PROF_BEGIN/PROF_END pair, which is then
+ * removed from every measurement. The SysTick must be initialized and running.
+ */
+void Profiler_Init(void)
+{
+	uint8 Id;
+
+	for (Id = 0; Id < PROF_NUM_OF_SECTIONS; Id++)
+	{
+		g_profTable[Id].Calls = 0;
+		g_profTable[Id].Min = 0xFFFF;
+		g_profTable[Id].Max = 0;
+		g_profTable[Id].Total = 0;
+	}
+
+	/* Calibration: time an empty section, then clear its row */
+	g_profOverhead = 0;
+	Profiler_Begin(PROF_LM35_GET_TEMPERATURE);
+	Profiler_End(PROF_LM35_GET_TEMPERATURE);
+	g_profOverhead = g_profTable[PROF_LM35_GET_TEMPERATURE].Min;
+
+	g_profTable[PROF_LM35_GET_TEMPERATURE].Calls = 0;
+	g_profTable[PROF_LM35_GET_TEMPERATURE].Min = 0xFFFF;
+	g_profTable[PROF_LM35_GET_TEMPERATURE].Max = 0;
+	g_profTable[PROF_LM35_GET_TEMPERATURE].Total = 0;
+}
+
+/*
+ * Description:
+ * Save the entry time stamp of the section.
+ */
+void Profiler_Begin(Profiler_SectionId Id)
+{
+	g_profTable[Id].Start = SysTick_GetFineTime();
+}
+
+/*
+ * Description:
+ * Accumulate the duration of the section in its row: calls, min, max and total.
+ */
+void Profiler_End(Profiler_SectionId Id)
+{
+	Profiler_RowType *Row_Ptr = &g_profTable[Id];
+	uint16 Duration = SysTick_GetFineTime() - Row_Ptr -> Start;
+
+	/* Remove the cost of the profiler itself */
+	Duration = (Duration > g_profOverhead) ? (Duration - g_profOverhead) : 0;
+
+	if (Row_Ptr -> Calls != 0xFFFF)
+	{
+		Row_Ptr -> Calls++;
+		Row_Ptr -> Total += Duration;
+	}
+
+	if (Duration < Row_Ptr -> Min)
+	{
+		Row_Ptr -> Min = Duration;
+	}
+
+	if (Duration > Row_Ptr -> Max)
+	{
+		Row_Ptr -> Max = Duration;
+	}
+}
+
+/*
+ * Description:
+ * Answer PROFILER_COMMAND_GET of a LINK_COMMAND_TOPIC frame with one row of the table in a
+ * LINK_REPLY_TOPIC frame to Source. Return FALSE if PAYLOAD[0] is not a profiler command.
+ */
+boolean Profiler_HandleCommand(uint8 Source, const uint8 *Payload_Ptr, uint8 Length)
+{
+	uint8 Reply[14] = {0};
+	const Profiler_RowType *Row_Ptr;
+
+	if (Payload_Ptr[0] != PROFILER_COMMAND_GET)
+	{
+		return FALSE;
+	}
+
+	Reply[0] = PROFILER_COMMAND_GET;
+	Reply[3] = SYSTICK_CYCLES_PER_COUNT;
+
+	if (Length != 2)
+	{
+		Reply[2] = PROFILER_STATUS_BAD_LENGTH;
+	}
+	else if (Payload_Ptr[1] >= PROF_NUM_OF_SECTIONS)
+	{
+		Reply[1] = Payload_Ptr[1];
+		Reply[2] = PROFILER_STATUS_BAD_ID;
+	}
+	else
+	{
+		/* The row is only written by the main loop, so it cannot change while it is copied */
+		Row_Ptr = &g_profTable[Payload_Ptr[1]];
+		Reply[1] = Payload_Ptr[1];
+		Reply[2] = PROFILER_STATUS_OK;
+		Reply[4] = (uint8)(Row_Ptr -> Calls);
+		Reply[5] = (uint8)(Row_Ptr -> Calls >> 8);
+		Reply[6] = (Row_Ptr -> Calls == 0) ? 0 : (uint8)(Row_Ptr -> Min);
+		Reply[7] = (Row_Ptr -> Calls == 0) ? 0 : (uint8)(Row_Ptr -> Min >> 8);
+		Reply[8] = (uint8)(Row_Ptr -> Max);
+		Reply[9] = (uint8)(Row_Ptr -> Max >> 8);
+		Reply[10] = (uint8)(Row_Ptr -> Total);
+		Reply[11] = (uint8)(Row_Ptr -> Total >> 8);
+		Reply[12] = (uint8)(Row_Ptr -> Total >> 16);
+		Reply[13] = (uint8)(Row_Ptr -> Total >> 24);
+	}
+
+	Link_Send(Source, LINK_REPLY_TOPIC, Reply, 14);
+
+	return TRUE;
+}
+
+#endif
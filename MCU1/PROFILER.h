@@ -0,0 +1,100 @@
+/*****************************************************************************************************************
+ * File Name: PROFILER.h
+ * Date: 19/10/2026
+ * Driver: Hot-Path Cycle Profiler Header File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include "Standard_Types.h"
+
+#ifndef PROFILER_H_
+#define PROFILER_H_
+
+/******************************************************************************************
+ *                                    Macros Definitions                                  *
+ ******************************************************************************************/
+
+/*
+ * Set to 1 to build the profiler in. When it is 0, PROF_BEGIN() and PROF_END() compile to
+ * nothing and no table is kept in RAM.
+ */
+#define PROFILER_ENABLE                      0
+
+/*
+ * Command received as a LINK_COMMAND_TOPIC frame, the answer is a LINK_REPLY_TOPIC frame:
+ * GET {CMD, ID} -> {CMD, ID, STATUS, CYCLES_PER_COUNT, CALLS, MIN, MAX (16-bit), TOTAL (32-bit)}
+ * Times are in counts of CYCLES_PER_COUNT CPU cycles, they are 0 if STATUS is not PROFILER_STATUS_OK.
+ * The service PC reads the table one row at a time, ID = Profiler_SectionId.
+ */
+#define PROFILER_COMMAND_GET                 0x20
+
+/* STATUS of a reply, same values as the configuration commands */
+#define PROFILER_STATUS_OK                   0x00
+#define PROFILER_STATUS_BAD_ID               0x01
+#define PROFILER_STATUS_BAD_LENGTH           0x03
+
+/*
+ * Sections are timed with SysTick_GetFineTime (Timer0 counts of SYSTICK_CYCLES_PER_COUNT cycles),
+ * because Timer1 is stopped by MCU1 whenever the fan is off. A single call of a section must be
+ * shorter than 65536 counts (524 ms at 1 MHz).
+ */
+
+/******************************************************************************************
+ *                                     Types Declaration                                  *
+ ******************************************************************************************/
+
+typedef enum
+{
+	PROF_LM35_GET_TEMPERATURE,
+	PROF_LCD_INTEGER_TO_STRING,
+	PROF_LINK_POLL,
+	PROF_DC_MOTOR_ROTATE,
+	PROF_RATE_UPDATE,
+	PROF_NUM_OF_SECTIONS
+}Profiler_SectionId;
+
+/******************************************************************************************
+ *                                    Functions Prototypes                                *
+ ******************************************************************************************/
+
+#if (PROFILER_ENABLE == 1)
+
+/* Mark the entry and the exit of a profiled section */
+#define PROF_BEGIN(ID)                       Profiler_Begin(ID)
+#define PROF_END(ID)                         Profiler_End(ID)
+
+/*
+ * Description:
+ * Clear the table and measure the cost of an empty PROF_BEGIN/PROF_END pair, which is then
+ * removed from every measurement. The SysTick must be initialized and running.
+ */
+void Profiler_Init(void);
+
+/*
+ * Description:
+ * Save the entry time stamp of the section.
+ */
+void Profiler_Begin(Profiler_SectionId Id);
+
+/*
+ * Description:
+ * Accumulate the duration of the section in its row: calls, min, max and total.
+ */
+void Profiler_End(Profiler_SectionId Id);
+
+/*
+ * Description:
+ * Answer PROFILER_COMMAND_GET of a LINK_COMMAND_TOPIC frame with one row of the table in a
+ * LINK_REPLY_TOPIC frame to Source. Return FALSE if PAYLOAD[0] is not a profiler command.
+ */
+boolean Profiler_HandleCommand(uint8 Source, const uint8 *Payload_Ptr, uint8 Length);
+
+#else
+
+#define PROF_BEGIN(ID)                       ((void)0)
+#define PROF_END(ID)                         ((void)0)
+#define Profiler_Init()                      ((void)0)
+#define Profiler_HandleCommand(SOURCE, PAYLOAD_PTR, LENGTH)   (FALSE)
+
+#endif
+
+#endif /* PROFILER_H_ */
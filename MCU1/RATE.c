@@ -0,0 +1,185 @@
+/*****************************************************************************************************************
+ * File Name: RATE.c
+ * Date: 19/10/2026
+ * Driver: Temperature Rate-of-Rise Fire Detector Source File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include "RATE.h"
+#include "SYSTICK.h"
+
+/******************************************************************************************
+ *                                    Macros Definitions                                  *
+ ******************************************************************************************/
+
+/*
+ * Numerator units per 0.01 C/s (RATE_UNITS_PER_LIMIT / RATE_LIMIT_SCALE):
+ * slope (C/s) = Numerator / RATE_DENOMINATOR / (10 << RATE_FRACTION_BITS) * (1000 / RATE_SAMPLE_PERIOD_MS)
+ * The 64-bit values are folded by the compiler, the conversions use the 32-bit factors below.
+ */
+#define RATE_UNITS_PER_LIMIT                 ((uint64)RATE_DENOMINATOR * (10 << RATE_FRACTION_BITS) * RATE_SAMPLE_PERIOD_MS)
+#define RATE_LIMIT_SCALE                     100000UL
+
+/* Limit to numerator: (Limit * RATE_LIMIT_FACTOR) >> RATE_LIMIT_SHIFT, the product fits in 32 bits up to RATE_MAX_LIMIT */
+#define RATE_LIMIT_SHIFT                     2
+#define RATE_LIMIT_FACTOR                    ((uint32)(((RATE_UNITS_PER_LIMIT << RATE_LIMIT_SHIFT) + (RATE_LIMIT_SCALE / 2)) / RATE_LIMIT_SCALE))
+#define RATE_MAX_LIMIT                       ((uint16)(0xFFFFFFFFUL / RATE_LIMIT_FACTOR))
+
+/*
+ * Numerator to slope: ((Numerator >> RATE_SLOPE_PRESHIFT) * RATE_SLOPE_FACTOR) >> RATE_SLOPE_SHIFT
+ * The samples are at most RATE_MAX_TEMPERATURE << RATE_FRACTION_BITS, so the numerator is below
+ * 2^27 and the product fits in 32 bits.
+ */
+#define RATE_SLOPE_PRESHIFT                  8
+#define RATE_SLOPE_SHIFT                     20
+#define RATE_SLOPE_FACTOR                    ((sint32)((((uint64)RATE_LIMIT_SCALE << (RATE_SLOPE_PRESHIFT + RATE_SLOPE_SHIFT)) + \
+		(RATE_UNITS_PER_LIMIT / 2)) / RATE_UNITS_PER_LIMIT))
+
+/***************************************************************************************
+ *                                         Global Variables                            *
+ ***************************************************************************************/
+
+/* Window of filtered samples, g_rateHead is the oldest one when the window is full */
+static sint16 g_rateWindow[RATE_WINDOW_SIZE];
+static uint8 g_rateHead = 0;
+static uint8 g_rateCount = 0;
+
+/* sum(y) and sum(k * y) of the window */
+static sint32 g_rateSum = 0;
+static sint32 g_rateWeightedSum = 0;
+static sint32 g_rateNumerator = 0;
+
+static sint16 g_rateFiltered;
+static boolean g_rateFilterStarted = FALSE;
+static uint16 g_rateLastSampleTime;
+
+/* Limits scaled to the numerator units */
+static sint32 g_rateAlarmOn;
+static sint32 g_rateAlarmOff;
+static boolean g_rateAlarm = FALSE;
+
+/****************************************************************************************
+ *                                     Functions Definitions                            *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Clear the window and set the alarm limit in 0.01 C/s. The alarm is raised above the limit
+ * and cleared below half of it. The SysTick must be initialized.
+ */
+void Rate_Init(uint16 Limit)
+{
+	g_rateHead = 0;
+	g_rateCount = 0;
+	g_rateSum = 0;
+	g_rateWeightedSum = 0;
+	g_rateNumerator = 0;
+	g_rateFilterStarted = FALSE;
+	g_rateAlarm = FALSE;
+
+	Rate_SetLimit(Limit);
+}
+
+/*
+ * Description:
+ * Change the alarm limit (0.01 C/s) without clearing the window.
+ * A limit above RATE_MAX_LIMIT (153 C/s with the default window) is clamped.
+ */
+void Rate_SetLimit(uint16 Limit)
+{
+	if (Limit > RATE_MAX_LIMIT)
+	{
+		Limit = RATE_MAX_LIMIT;
+	}
+
+	g_rateAlarmOn = (sint32)(((uint32)Limit * RATE_LIMIT_FACTOR) >> RATE_LIMIT_SHIFT);
+	g_rateAlarmOff = g_rateAlarmOn >> 1;
+}
+
+/*
+ * Description:
+ * Offer the current temperature in 0.1 C, to be called every cycle in the sampling path.
+ * Costs a few additions and shifts (O(1)), a sample is added to the window every RATE_SAMPLE_PERIOD_MS.
+ * Return TRUE only when the alarm state changes, there is no alarm until the window is full.
+ */
+boolean Rate_Update(uint16 Temperature)
+{
+	sint16 Sample;
+	sint16 Oldest;
+	boolean Alarm;
+
+	if (Temperature > RATE_MAX_TEMPERATURE)
+	{
+		Temperature = RATE_MAX_TEMPERATURE;
+	}
+	Sample = (sint16)(Temperature << RATE_FRACTION_BITS);
+
+	if (g_rateFilterStarted == FALSE)
+	{
+		g_rateFiltered = Sample;
+		g_rateFilterStarted = TRUE;
+		g_rateLastSampleTime = SysTick_GetTicks() - RATE_SAMPLE_PERIOD_MS;
+	}
+	else
+	{
+		g_rateFiltered += (Sample - g_rateFiltered) >> RATE_FILTER_SHIFT;
+	}
+
+	if (SysTick_HasElapsed(g_rateLastSampleTime, RATE_SAMPLE_PERIOD_MS) == FALSE)
+	{
+		return FALSE;
+	}
+	g_rateLastSampleTime += RATE_SAMPLE_PERIOD_MS;
+
+	if (g_rateCount < RATE_WINDOW_SIZE)
+	{
+		/* Filling: the new sample gets the next weight */
+		g_rateWeightedSum += (sint32)g_rateCount * g_rateFiltered;
+		g_rateSum += g_rateFiltered;
+		g_rateCount++;
+	}
+	else
+	{
+		/* Sliding: every weight drops by one, the oldest sample leaves and the new one gets N - 1 */
+		Oldest = g_rateWindow[g_rateHead];
+		g_rateWeightedSum += (sint32)Oldest - g_rateSum + ((sint32)(RATE_WINDOW_SIZE - 1) * g_rateFiltered);
+		g_rateSum += (sint32)g_rateFiltered - Oldest;
+	}
+
+	g_rateWindow[g_rateHead] = g_rateFiltered;
+	g_rateHead = (g_rateHead + 1) & (RATE_WINDOW_SIZE - 1);
+
+	if (g_rateCount < RATE_WINDOW_SIZE)
+	{
+		return FALSE;
+	}
+
+	g_rateNumerator = (g_rateWeightedSum * RATE_WINDOW_SIZE) - (g_rateSum * ((RATE_WINDOW_SIZE * (RATE_WINDOW_SIZE - 1)) / 2));
+
+	Alarm = (g_rateAlarm == TRUE) ? (g_rateNumerator >= g_rateAlarmOff) : (g_rateNumerator > g_rateAlarmOn);
+	if (Alarm != g_rateAlarm)
+	{
+		g_rateAlarm = Alarm;
+		return TRUE;
+	}
+
+	return FALSE;
+}
+
+/*
+ * Description:
+ * Return TRUE while the temperature rises faster than the limit.
+ */
+boolean Rate_IsAlarm(void)
+{
+	return g_rateAlarm;
+}
+
+/*
+ * Description:
+ * Return the slope of the window in 0.01 C/s (0 until the window is full).
+ * A 32-bit multiply and shifts, the result is rounded down.
+ */
+sint16 Rate_GetSlope(void)
+{
+	return (sint16)(((g_rateNumerator >> RATE_SLOPE_PRESHIFT) * RATE_SLOPE_FACTOR) >> RATE_SLOPE_SHIFT);
+}
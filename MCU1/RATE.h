@@ -0,0 +1,83 @@
+/*****************************************************************************************************************
+ * File Name: RATE.h
+ * Date: 19/10/2026
+ * Driver: Temperature Rate-of-Rise Fire Detector Header File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include "Standard_Types.h"
+
+#ifndef RATE_H_
+#define RATE_H_
+
+/******************************************************************************************
+ *                                    Macros Definitions                                  *
+ ******************************************************************************************/
+
+/*
+ * The temperature (in 0.1 C) is smoothed by a first order filter on every call, then one filtered
+ * sample is taken every RATE_SAMPLE_PERIOD_MS into a sliding window of RATE_WINDOW_SIZE samples
+ * (16 s). The slope is the least squares line through the window:
+ * slope = (N * sum(k * y) - (N * (N - 1) / 2) * sum(y)) / RATE_DENOMINATOR per sample, k = 0 (oldest) .. N - 1
+ * Both sums are moved with the window in O(1) per sample, only the numerator is compared with
+ * the limit, which is scaled once to the same units, so no division runs per sample.
+ */
+#define RATE_WINDOW_SIZE                     32
+#define RATE_SAMPLE_PERIOD_MS                500
+
+/* Filtered samples are kept with 4 fraction bits, the filter weight of a new value is 1/4 */
+#define RATE_FRACTION_BITS                   4
+#define RATE_FILTER_SHIFT                    2
+
+/* Higher readings (a broken sensor wire) are limited to this value (0.1 C) to keep the samples in 16 bits */
+#define RATE_MAX_TEMPERATURE                 2000
+
+/* N * sum(k^2) - (sum(k))^2 = N^2 * (N^2 - 1) / 12 */
+#define RATE_DENOMINATOR                     (((uint32)RATE_WINDOW_SIZE * RATE_WINDOW_SIZE * \
+		((uint32)RATE_WINDOW_SIZE * RATE_WINDOW_SIZE - 1)) / 12)
+
+#if ((RATE_WINDOW_SIZE & (RATE_WINDOW_SIZE - 1)) != 0)
+
+#error "RATE_WINDOW_SIZE should be a power of two"
+
+#endif
+
+/******************************************************************************************
+ *                                    Functions Prototypes                                *
+ ******************************************************************************************/
+
+/*
+ * Description:
+ * Clear the window and set the alarm limit in 0.01 C/s. The alarm is raised above the limit
+ * and cleared below half of it. The SysTick must be initialized.
+ */
+void Rate_Init(uint16 Limit);
+
+/*
+ * Description:
+ * Change the alarm limit (0.01 C/s) without clearing the window.
+ * A limit above RATE_MAX_LIMIT (153 C/s with the default window) is clamped.
+ */
+void Rate_SetLimit(uint16 Limit);
+
+/*
+ * Description:
+ * Offer the current temperature in 0.1 C, to be called every cycle in the sampling path.
+ * Costs a few additions and shifts (O(1)), a sample is added to the window every RATE_SAMPLE_PERIOD_MS.
+ * Return TRUE only when the alarm state changes, there is no alarm until the window is full.
+ */
+boolean Rate_Update(uint16 Temperature);
+
+/*
+ * Description:
+ * Return TRUE while the temperature rises faster than the limit.
+ */
+boolean Rate_IsAlarm(void);
+
+/*
+ * Description:
+ * Return the slope of the window in 0.01 C/s (0 until the window is full).
+ * A 32-bit multiply and shifts, the result is rounded down.
+ */
+sint16 Rate_GetSlope(void);
+
+#endif /* RATE_H_ */
@@ -0,0 +1,83 @@
+/*****************************************************************************************************************
+ * File Name: SUPERVISOR.h
+ * Date: 19/10/2026
+ * Driver: Watchdog Supervisor of the Application Tasks Header File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include "Standard_Types.h"
+#include "WDG.h"
+
+#ifndef SUPERVISOR_H_
+#define SUPERVISOR_H_
+
+/******************************************************************************************
+ *                                    Macros Definitions                                  *
+ ******************************************************************************************/
+
+/*
+ * Reset record in the EEPROM, after the configuration block:
+ * RESET_CAUSE (WDG_RESET_xxx of the last reset), LATE_TASK (task which missed its deadline before
+ * the last watchdog reset), WATCHDOG_RESETS (16-bit, little endian)
+ */
+#define SUPERVISOR_EEPROM_START              0x03F0
+#define SUPERVISOR_EEPROM_RESET_CAUSE        (SUPERVISOR_EEPROM_START + 0)
+#define SUPERVISOR_EEPROM_LATE_TASK          (SUPERVISOR_EEPROM_START + 1)
+#define SUPERVISOR_EEPROM_WATCHDOG_RESETS    (SUPERVISOR_EEPROM_START + 2)
+
+/* LATE_TASK value when no task was late (the reset was not caused by the supervisor) */
+#define SUPERVISOR_NO_TASK                   0xFF
+
+/******************************************************************************************
+ *                                     Types Declaration                                  *
+ ******************************************************************************************/
+
+/* The tasks of the control loop, every node supervises its own part of them */
+typedef enum
+{
+	SUPERVISOR_TASK_SENSOR,
+	SUPERVISOR_TASK_LINK,
+	SUPERVISOR_TASK_ACTUATOR,
+	SUPERVISOR_TASK_DISPLAY,
+	SUPERVISOR_NUM_OF_TASKS
+}Supervisor_TaskId;
+
+typedef struct
+{
+	const uint16 *Deadlines_Ms;    /* longest time between two check-ins, indexed by Supervisor_TaskId, 0 = not supervised */
+	WDG_TimeoutType Timeout;
+}Supervisor_ConfigType;
+
+/******************************************************************************************
+ *                                    Functions Prototypes                                *
+ ******************************************************************************************/
+
+/*
+ * Description:
+ * 1. Read the reset cause from MCUCSR and keep it in the EEPROM reset record, a watchdog reset
+ *    also saves the task which was late and counts the watchdog resets.
+ * 2. Start every task deadline now and enable the watchdog with the configured time-out.
+ * Call it after the blocking startup steps. The SysTick must be initialized.
+ */
+void Supervisor_Init(const Supervisor_ConfigType *Config_Ptr);
+
+/*
+ * Description:
+ * Report that a task finished its work of this cycle.
+ */
+void Supervisor_CheckIn(Supervisor_TaskId Task);
+
+/*
+ * Description:
+ * Feed the watchdog only when every supervised task checked in within its deadline, to be called
+ * once every cycle. Return FALSE if a task is late: the watchdog is not fed any more and resets
+ * the MCU at its time-out, the late task is kept over the reset.
+ */
+boolean Supervisor_Service(void);
+
+/*
+ * Description:
+ * Return the reset cause read by Supervisor_Init (WDG_RESET_xxx flags).
+ */
+uint8 Supervisor_GetResetCause(void);
+
+#endif /* SUPERVISOR_H_ */
@@ -0,0 +1,67 @@
+/*****************************************************************************************************************
+ * File Name: SYSTICK.h
+ * Date: 19/10/2026
+ * Driver: System Tick Service Header File (based on Timer0)
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include "Standard_Types.h"
+
+#ifndef SYSTICK_H_
+#define SYSTICK_H_
+
+/******************************************************************************************
+ *                                    Macros Definitions                                  *
+ ******************************************************************************************/
+
+/* The system tick period is one millisecond */
+#define SYSTICK_TICK_MS                      1
+
+/* Choose the smallest Timer0 pre-scalar that lets one tick fit in the 8-bit OCR0 register */
+#if ((F_CPU / 8UL / 1000UL) <= 256UL)
+#define SYSTICK_PRESCALER                    TIMER0_Prescaler_8
+#define SYSTICK_CYCLES_PER_COUNT             8
+#elif ((F_CPU / 64UL / 1000UL) <= 256UL)
+#define SYSTICK_PRESCALER                    TIMER0_Prescaler_64
+#define SYSTICK_CYCLES_PER_COUNT             64
+#else
+#error "SysTick: F_CPU is too high for a 1 ms tick with Timer0"
+#endif
+
+/* Number of Timer0 counts in one tick (125 counts of 8 us at 1 MHz) */
+#define SYSTICK_COUNTS_PER_TICK              (F_CPU / SYSTICK_CYCLES_PER_COUNT / 1000UL)
+
+/* Convert between fine-time counts and CPU cycles */
+#define SYSTICK_COUNTS_TO_CYCLES(COUNTS)     ((uint32)(COUNTS) * SYSTICK_CYCLES_PER_COUNT)
+
+/******************************************************************************************
+ *                                    Functions Prototypes                                *
+ ******************************************************************************************/
+
+/*
+ * Description:
+ * Start Timer0 in CTC Mode to generate an interrupt every SYSTICK_TICK_MS.
+ * The Global Interrupt Enable bit must be set by the application afterwards.
+ */
+void SysTick_Init(void);
+
+/*
+ * Description:
+ * Return the number of milliseconds since SysTick_Init (wraps around every 65.5 seconds).
+ */
+uint16 SysTick_GetTicks(void);
+
+/*
+ * Description:
+ * Return a free-running time stamp in Timer0 counts (SYSTICK_CYCLES_PER_COUNT cycles each).
+ * The value wraps around at 16 bits, so differences are valid for intervals shorter than
+ * 65536 counts (524 ms at 1 MHz).
+ */
+uint16 SysTick_GetFineTime(void);
+
+/*
+ * Description:
+ * Return TRUE if at least Period ticks passed since the Start tick (wrap-around safe).
+ */
+boolean SysTick_HasElapsed(uint16 Start, uint16 Period);
+
+#endif /* SYSTICK_H_ */
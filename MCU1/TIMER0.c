@@ -0,0 +1,96 @@
+/*******************************************************************************************************************
+ * File Name: TIMER0.c
+ * Date: 19/10/2026
+ * Driver: ATmega32 TIMER0 Driver Source File
+ * Author: Youssef Zaki
+ ******************************************************************************************************************/
+#include "TIMER0.h"
+#include "Common_Macros.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+/***************************************************************************************
+ *                                         Global Variables                            *
+ ***************************************************************************************/
+/* Global variables to hold the address of the call back function in the application */
+static void (* volatile g_timer0CallBackPtr)(void) = NULL_PTR;
+
+/*******************************************************************************
+ *                       Interrupt Service Routines                            *
+ *******************************************************************************/
+/* Interrupt for Normal (Overflow) Mode */
+ISR(TIMER0_OVF_vect)
+{
+	if(g_timer0CallBackPtr != NULL_PTR)
+	{
+		/* Call the Call Back function in the application after the overflow */
+		(*g_timer0CallBackPtr)();
+	}
+}
+/* Interrupt for Compare Mode */
+ISR(TIMER0_COMP_vect)
+{
+	if(g_timer0CallBackPtr != NULL_PTR)
+	{
+		/* Call the Call Back function in the application after the compare match */
+		(*g_timer0CallBackPtr)();
+	}
+}
+
+/****************************************************************************************
+ *                                      Functions Definitions                           *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Initialization of Timer0 in Normal or CTC Mode.
+ * 1. Let the TCNT0 Register = The Start value of the timer0.
+ * 2. Configure WGM01:0 bits in TCCR0 according to the Timer0 Mode (OC0 pin disconnected).
+ * 3. In CTC Mode Let OCR0 = the compare value (TOP Value).
+ * 4. Set OCIE0 or TOIE0 in TIMSK Register without touching the Timer1/Timer2 interrupt bits.
+ * 5. Start the timer by configuring CS02:0 bits with the required pre-scalar.
+ */
+void Timer0_Init(const Timer0_ConfigType * Config_Ptr)
+{
+	/* Stop the timer while configuring it */
+	TCCR0 = (1<<FOC0);
+	TCNT0 = Config_Ptr -> initial_value;
+
+	if (Config_Ptr -> mode == TIMER0_Normal_0)
+	{
+		/* Configuration for Normal Mode: WGM00 = 0, WGM01 = 0, COM01 = 0, COM00 = 0 */
+		CLEAR_BIT(TIMSK, OCIE0);
+		SET_BIT(TIMSK, TOIE0);
+	}
+	else if (Config_Ptr -> mode == TIMER0_CTC_2)
+	{
+		/* Configuration for CTC Mode: WGM00 = 0, WGM01 = 1, COM01 = 0, COM00 = 0 */
+		OCR0 = Config_Ptr -> compare_value;
+		SET_BIT(TCCR0, WGM01);
+		CLEAR_BIT(TIMSK, TOIE0);
+		SET_BIT(TIMSK, OCIE0);
+	}
+
+	/* Set to required pre-scalar Configuration, this starts the timer */
+	TCCR0 = (TCCR0 & 0xF8) | (Config_Ptr -> prescaler);
+}
+
+/*
+ * Description:
+ * Function to disable the Timer0 and its interrupts only.
+ */
+void Timer0_DeInit(void)
+{
+	TCCR0 = 0;
+	CLEAR_BIT(TIMSK, OCIE0);
+	CLEAR_BIT(TIMSK, TOIE0);
+}
+
+/*
+ * Description:
+ * Function to set the Call Back function address.
+ */
+void Timer0_SetCallBack(void(*a_ptr)(void))
+{
+	g_timer0CallBackPtr = a_ptr;
+}
@@ -4,11 +4,91 @@
  * Driver: ATmega32 UART Driver Header File
  * Author: Youssef Zaki
  ****************************************************************************************************************/
-#include "Standard_types.h"
+#include "Standard_Types.h"
 
 #ifndef UART_H_
 #define UART_H_
 
+/*******************************************************************************************
+ *                                    Macros Definitions                                   *
+ *******************************************************************************************/
+
+/* Size of the receive ring buffer filled by the RXC interrupt (must be a power of two) */
+#define UART_RX_BUFFER_SIZE               16
+
+#if ((UART_RX_BUFFER_SIZE & (UART_RX_BUFFER_SIZE - 1)) != 0)
+
+#error "UART_RX_BUFFER_SIZE should be a power of two"
+
+#endif
+
+/*
+ * Status saved with every received byte, the error flags use the same bits as FE, DOR and PE
+ * in UCSRA and the ninth bit uses bit 0.
+ */
+#define UART_STATUS_BIT8                  0x01
+#define UART_STATUS_PARITY_ERROR          0x04
+#define UART_STATUS_DATA_OVERRUN          0x08
+#define UART_STATUS_FRAME_ERROR           0x10
+#define UART_STATUS_ERRORS                (UART_STATUS_FRAME_ERROR | UART_STATUS_DATA_OVERRUN | UART_STATUS_PARITY_ERROR)
+
+/*
+ * What the RXC interrupt does with a byte received with FE, DOR or PE set (always counted):
+ * UART_RX_ERROR_DROP -> the byte is thrown away.
+ * UART_RX_ERROR_TAG  -> the byte is saved with its error flags, see UART_GetRxStatus.
+ */
+#define UART_RX_ERROR_DROP                0
+#define UART_RX_ERROR_TAG                 1
+
+#define UART_RX_ERROR_POLICY              UART_RX_ERROR_TAG
+
+/*
+ * Baud rate of the UART, computed at compile time like <util/setbaud.h>:
+ * 1. UBRR is rounded to the nearest value instead of truncated.
+ * 2. Normal Speed is used when its error is within UART_BAUD_TOLERANCE percent, otherwise
+ *    Double Speed (U2X) is used, otherwise the build stops.
+ * High baud rates are exact on these crystals (build with -DUART_BAUD_RATE=...):
+ *    F_CPU = 8 MHz  -> 250000 (UBRR 1), 500000 (UBRR 0), 1000000 (U2X, UBRR 0)
+ *    F_CPU = 16 MHz -> 250000 (UBRR 3), 500000 (UBRR 1), 1000000 (UBRR 0)
+ * At 1 Mbaud a 9-bit character takes 12 us, the RXC interrupt must finish within that time.
+ */
+#ifndef UART_BAUD_RATE
+#define UART_BAUD_RATE                    9600UL
+#endif
+
+#define UART_BAUD_TOLERANCE               2
+
+#define UART_UBRR_NORMAL                  (((F_CPU) + 8UL * (UART_BAUD_RATE)) / (16UL * (UART_BAUD_RATE)) - 1UL)
+#define UART_UBRR_DOUBLE                  (((F_CPU) + 4UL * (UART_BAUD_RATE)) / (8UL * (UART_BAUD_RATE)) - 1UL)
+#define UART_UBRR_SYNCHRONOUS             (((F_CPU) + 1UL * (UART_BAUD_RATE)) / (2UL * (UART_BAUD_RATE)) - 1UL)
+
+/* TRUE if F_CPU / (DIVISOR * (UBRR + 1)) is within UART_BAUD_TOLERANCE percent of UART_BAUD_RATE */
+#define UART_BAUD_IN_TOLERANCE(DIVISOR, UBRR) \
+	((100UL * (F_CPU) <= (DIVISOR) * ((UBRR) + 1UL) * (100UL * (UART_BAUD_RATE) + (UART_BAUD_RATE) * UART_BAUD_TOLERANCE)) && \
+	 (100UL * (F_CPU) >= (DIVISOR) * ((UBRR) + 1UL) * (100UL * (UART_BAUD_RATE) - (UART_BAUD_RATE) * UART_BAUD_TOLERANCE)))
+
+#if ((F_CPU) >= 16UL * (UART_BAUD_RATE)) && UART_BAUD_IN_TOLERANCE(16UL, UART_UBRR_NORMAL)
+#define UART_USE_2X                       0
+#define UART_UBRR_VALUE                   UART_UBRR_NORMAL
+#elif ((F_CPU) >= 8UL * (UART_BAUD_RATE)) && UART_BAUD_IN_TOLERANCE(8UL, UART_UBRR_DOUBLE)
+#define UART_USE_2X                       1
+#define UART_UBRR_VALUE                   UART_UBRR_DOUBLE
+#else
+#error "UART_BAUD_RATE can not be generated from F_CPU within UART_BAUD_TOLERANCE percent"
+#endif
+
+#if (UART_UBRR_VALUE > 4095)
+
+#error "UART_BAUD_RATE is too low for F_CPU, UBRR has only 12 bits"
+
+#endif
+
+/* Address which is accepted by every node in the Multi-processor Communication Mode */
+#define UART_BROADCAST_ADDRESS            0xFF
+
+/* Node address before UART_SetNodeAddress is called: no address filtering */
+#define UART_NO_ADDRESS                   0x00
+
 /*******************************************************************************************
  *                                      Types Declaration                                  *
  *******************************************************************************************/
@@ -17,11 +97,6 @@ typedef enum
 Asynchronous, Synchronous
 }UART_ModeSelect;
 
-typedef enum
-{
-	Normal, Double_Speed
-}UART_AsynchronousSpeed;
-
 typedef enum
 {
 	Disabled, Reversed, Even_Parity, Odd_Parity
@@ -37,14 +112,22 @@ typedef enum
 	Five_Bit_0, Six_Bit_1, Seven_Bit_2, Eight_Bit_3, Reserved_4, Reserved_5, Reserved_6, Nine_Bit_7
 }UART_BitDataSize;
 
+/* Running receive statistics, counted by the RXC interrupt from the flags in UCSRA */
+typedef struct
+{
+	uint16 Received_Bytes;
+	uint16 Frame_Errors;           /* FE: the stop bit was read as zero                       */
+	uint16 Data_Overruns;          /* DOR: characters were lost before UDR was read           */
+	uint16 Parity_Errors;          /* PE: the parity bit did not match (parity enabled only)  */
+	uint16 Buffer_Overflows;       /* the receive ring buffer was full, the byte was dropped  */
+}UART_ErrorStatisticsType;
+
 typedef struct
 {
 	UART_ModeSelect Mode;
-	UART_AsynchronousSpeed Speed;
 	UART_ParityModeSelect Parity_Mode;
 	UART_StopBitSelect Stop_Bit;
 	UART_BitDataSize Data_Size;
-	uint32 Baud_Rate;
 }UART_ConfigType;
 /*******************************************************************************************
  *                                      Functions Prototypes                               *
@@ -54,34 +137,114 @@ typedef struct
  * Description:
  * 1. To write in UCRSC Register, so the URSEL bit must be Set.
  * 2. Enable RXEN or TXEN according to device to be receiver or transmitter respectively.
- * 3. Enable RXCIE or TXCIE according to device to be receiver or transmitter respectively (for interrupt enable)
+ * 3. Enable RXCIE to fill the receive ring buffer by interrupt, so the Global Interrupt must be enabled.
  * 4. Select the Mode of the UART to be Asynchronous or Synchronous
- * 5. Based of the mode to be Asynchronous or Synchronous, Choose the Speed and Baud Rate.
+ * 5. Based of the mode to be Asynchronous or Synchronous, load the UBRR (and U2X) computed at compile time for UART_BAUD_RATE.
  * 6. from UPM1:0 bits in UCSRC Register, configure the parity mode.
  * 7. from USBS bit in UCSRC Register, Select the number of stop bits to be one or two.
  * 8. from UCSZ2 in UCSRB and from USCZ1:0 in UCSRC bits, select the character size.
  */
 void UART_Init(const UART_ConfigType *Config_Ptr);
 
+/*
+ * Description:
+ * Enable the Multi-processor Communication Mode, the frame size must be Nine_Bit_7.
+ * 1. Frames with the ninth bit set are addresses, frames with the ninth bit cleared are data.
+ * 2. The MPCM bit is set, so the hardware ignores all data frames until an address frame is received.
+ * 3. The RXC interrupt compares the address with Address and UART_BROADCAST_ADDRESS, if it matches
+ *    the MPCM bit is cleared to receive the following data frames, otherwise it stays set.
+ * 4. The addresses of this node (and broadcasts) are put in the receive buffer with UART_STATUS_BIT8,
+ *    so the reader knows where a new frame starts. The other address frames are not.
+ */
+void UART_SetNodeAddress(uint8 Address);
+
+/*
+ * Description:
+ * Function to Send 9-bit character to the another device, the frame size must be Nine_Bit_7.
+ * 1. Wait in Idle sleep until the Tx Buffer is empty like UART_SendByte.
+ * 2. The ninth bit is written to TXB8 before the low 8 bits are written to UDR Register.
+ */
+void UART_SendNineBit(uint16 Data);
+
+/*
+ * Description:
+ * Send an address frame (ninth bit set) to select the receiving node, the frame size must be Nine_Bit_7.
+ */
+void UART_SendAddress(uint8 Address);
+
 /*
  * Description:
  * Function to Send byte to the another device.
  * 1. The UDRE is the flag which be set automatically when the Tx Buffer is empty and ready to send new byte.
- * 2. We wait until the buffer is empty, and flag is set to one.
- * 3. The required data is put in UDR Register and consequently, the UDRE flag is cleared while writing.
+ * 2. We wait in Idle sleep until the buffer is empty, the UDRE interrupt wakes the CPU up.
+ * 3. TXC flag is cleared by writing '1', so it tells later when the byte has completely left the shift register.
+ * 4. The required data is put in UDR Register and consequently, the UDRE flag is cleared while writing.
+ * In 9-bit frames the ninth bit is sent cleared, so the byte is a data frame.
  */
 void UART_SendByte(uint8 Byte);
 
 /*
  * Description:
  * Function to receive byte from the another device.
- * 1. RXC bit is set automatically when the received buffer Rx hasn't any unread data.
- * 2. We wait until the all data is read.
- * 3. Then, we can read the received data from the Rx buffer through UDR Register.
- * 4. After read the data, the RXC flag will be cleared.
+ * 1. The RXC interrupt moves every received byte from UDR Register to the receive ring buffer.
+ * 2. We wait in Idle sleep until the buffer has a byte, any interrupt wakes the CPU up to check again.
+ * 3. Then, we read the oldest received byte from the ring buffer.
  */
 uint8 UART_ReceiveByte(void);
 
+/*
+ * Description:
+ * Function to receive byte with a time limit.
+ * Same as UART_ReceiveByte, but the wait ends after Timeout_Ms milliseconds of the SysTick.
+ * Return TRUE and the byte in Byte_Ptr, or FALSE if no byte was received in time.
+ */
+boolean UART_ReceiveByteTimeout(uint8 *Byte_Ptr, uint16 Timeout_Ms);
+
+/*
+ * Description:
+ * Function to receive 9-bit character from the another device.
+ * Same as UART_ReceiveByte, but the ninth bit saved by the RXC interrupt is returned in bit 8.
+ */
+uint16 UART_ReceiveNineBit(void);
+
+/*
+ * Description:
+ * Function to receive byte without waiting.
+ * If the receive buffer has a byte, it is copied to Byte_Ptr and the function returns TRUE,
+ * otherwise the function returns FALSE immediately.
+ */
+boolean UART_TryReceiveByte(uint8 *Byte_Ptr);
+
+/*
+ * Description:
+ * Return the status saved with the oldest byte in the receive buffer without removing it:
+ * UART_STATUS_FRAME_ERROR, UART_STATUS_DATA_OVERRUN, UART_STATUS_PARITY_ERROR and UART_STATUS_BIT8.
+ * Return 0 if the buffer is empty.
+ */
+uint8 UART_GetRxStatus(void);
+
+/*
+ * Description:
+ * Return the number of received bytes waiting in the receive buffer.
+ */
+uint8 UART_Available(void);
+
+/*
+ * Description:
+ * Give a pointer to the oldest received bytes inside the receive buffer without copying them.
+ * Return the number of bytes which can be read in a row from Data_Ptr (the part before the
+ * buffer wraps around or before the first byte received with an error or the ninth bit), 0 if the
+ * buffer is empty or the oldest byte has an error or the ninth bit (check UART_GetRxStatus). The bytes stay in the buffer until
+ * UART_Consume is called, the RXC interrupt only writes after them.
+ */
+uint8 UART_Peek(const uint8 **Data_Ptr);
+
+/*
+ * Description:
+ * Release Count bytes given by UART_Peek, so the RXC interrupt can use their place again.
+ */
+void UART_Consume(uint8 Count);
+
 /*
  * Description:
  * Function to send string to the another device.
@@ -89,10 +252,39 @@ uint8 UART_ReceiveByte(void);
 void UART_SendString(const uint8 *Str);
 
 /*
- * Function to receive String from the another device.
+ * Description:
+ * Function to send string stored in the flash memory (PROGMEM / PSTR) to the another device.
+ * The characters are read with pgm_read_byte, so the string takes no RAM.
+ */
+void UART_SendString_P(const char *Str);
+
+/*
+ * Description:
+ * Function to send Length bytes from Data_Ptr to the another device, the data may contain '\0'.
+ */
+void UART_SendBuffer(const uint8 *Data_Ptr, uint16 Length);
+
+/*
+ * Description:
+ * Function to receive String from the another device into a buffer of Size bytes.
  * 1. Receive the required string until the '#' symbol through UART from the other UART device.
- * 2. when the receiving process is finished, we should re-assign the last character to '\0' to read the actual data.
+ * 2. At most Size - 1 characters are saved, the rest of a too long string is received and dropped.
+ * 3. The '#' is replaced with '\0' to read the actual data.
+ * Return the number of saved characters (without the '\0').
+ */
+uint8 UART_ReceiveString(uint8 *Str, uint8 Size);
+
+/*
+ * Description:
+ * Function to receive up to Size bytes into Buffer_Ptr, waiting at most Timeout_Ms for every byte.
+ * Return the number of received bytes, less than Size if the other device stopped sending.
+ */
+uint8 UART_ReceiveBuffer(uint8 *Buffer_Ptr, uint8 Size, uint16 Timeout_Ms);
+
+/*
+ * Description:
+ * Copy the receive statistics, the copy is taken with interrupts disabled.
  */
-void UART_ReceiveString(uint8 *Str);
+void UART_GetErrorStatistics(UART_ErrorStatisticsType *Stats_Ptr);
 
 #endif /* UART_H_ */
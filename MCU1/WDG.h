@@ -0,0 +1,73 @@
+/*******************************************************************************************************************
+ * File Name: WDG.h
+ * Date: 19/10/2026
+ * Driver: ATmega32 Watchdog Timer Driver Header File
+ * Author: Youssef Zaki
+ ******************************************************************************************************************/
+#include "Standard_Types.h"
+
+#ifndef WDG_H_
+#define WDG_H_
+
+/*******************************************************************************************
+ *                                    Macros Definitions                                   *
+ *******************************************************************************************/
+
+/* Reset flags of MCUCSR Register, returned by WDG_GetResetCause */
+#define WDG_RESET_POWER_ON                0x01
+#define WDG_RESET_EXTERNAL                0x02
+#define WDG_RESET_BROWN_OUT               0x04
+#define WDG_RESET_WATCHDOG                0x08
+#define WDG_RESET_JTAG                    0x10
+#define WDG_RESET_FLAGS                   0x1F
+
+/*******************************************************************************************
+ *                                      Types Declaration                                  *
+ *******************************************************************************************/
+
+/* Values of WDP2:0 bits in WDTCR Register, the time-out of the 1 MHz watchdog oscillator at VCC = 5V */
+typedef enum
+{
+	WDG_TIMEOUT_16_MS,
+	WDG_TIMEOUT_32_MS,
+	WDG_TIMEOUT_65_MS,
+	WDG_TIMEOUT_130_MS,
+	WDG_TIMEOUT_260_MS,
+	WDG_TIMEOUT_520_MS,
+	WDG_TIMEOUT_1000_MS,
+	WDG_TIMEOUT_2100_MS
+}WDG_TimeoutType;
+
+/*******************************************************************************
+ *                              Functions Prototypes                           *
+ *******************************************************************************/
+
+/*
+ * Description:
+ * Function to start the Watchdog Timer.
+ * 1. Reset the watchdog counter, so the first time-out is complete.
+ * 2. Select the time-out by WDP2:0 bits and set WDE bit in WDTCR Register.
+ * The MCU is reset when WDG_Refresh is not called within the time-out.
+ */
+void WDG_Enable(WDG_TimeoutType Timeout);
+
+/*
+ * Description:
+ * Function to stop the Watchdog Timer with the timed sequence (WDTOE and WDE, then WDE = 0 within 4 cycles).
+ */
+void WDG_Disable(void);
+
+/*
+ * Description:
+ * Reset the watchdog counter (WDR instruction).
+ */
+void WDG_Refresh(void);
+
+/*
+ * Description:
+ * Return the reset flags of MCUCSR Register (WDG_RESET_xxx) and clear them,
+ * so the cause of the next reset is not mixed with this one. Call it once at startup.
+ */
+uint8 WDG_GetResetCause(void);
+
+#endif /* WDG_H_ */
@@ -20,7 +20,7 @@
  *******************************************************************************************/
 
 /* Extern Public global variable to be used by other modules */
-extern volatile uint16 g_adcResult;
+extern volatile uint16 g_ADC_Value;
 
 /*******************************************************************************************
  *                                      Types Declaration                                  *
@@ -42,7 +42,8 @@ typedef enum
 
 typedef enum
 {
-	Free_Running, Analog_Comparator, EXT_INT_Req0, TIMER0_COMP, TIMER0_OVF, TIMER1_COMPB, TIMER1_OVF, TIMER1_CAPT
+	Free_Running, Analog_Comparator, EXT_INT_Req0, TIMER0_COMP, TIMER0_OVF, TIMER1_COMPB, TIMER1_OVF, TIMER1_CAPT,
+	Single_Conversion /* Auto Trigger disabled, every conversion is started by ADC_ReadChannel */
 }ADC_AutoTriggerSource;
 
 typedef struct
@@ -64,6 +65,7 @@ typedef struct
  * 4. Choose the required pre-scalar to make ADC operating frequency within a range (50KHz:200KHz).
  * 5. Enable the ADATE bit in ADCSRA Register to activate ADC Auto Trigger Source.
  * 6. By the Configuration of SFIOR Register, choose the ADC Auto Trigger Source from bits ADTS2:0.
+ * 7. In Single Conversion, the ADATE bit is cleared and the Auto Trigger Source is not used.
  */
 void ADC_Init(const ADC_ConfigType *Config_Ptr);
 
@@ -71,8 +73,25 @@ void ADC_Init(const ADC_ConfigType *Config_Ptr);
  * Description:
  * 1. Configure the ADMUX Register and choose the required ADC Channel.
  * 2. Start Conversion of the ADC.
+ * 3. Wait in Idle sleep for the ADC interrupt to report the end of conversion, so the Global Interrupt
+ *    Enable bit must be set before calling this function. The UART and the timers keep running.
  */
 uint16 ADC_ReadChannel(InputChannel_Select Channel_Select);
 
+/*
+ * Description:
+ * Start converting a list of channels in the background, one after the other.
+ * The ADC interrupt saves every result in Results_Ptr (same index as the channel) and starts
+ * the next channel, the CPU is free during the whole scan (~104 us per channel with F_CPU/8).
+ * Used in Single Conversion only, ADC_ReadChannel must not be called during a scan.
+ */
+void ADC_StartScan(const InputChannel_Select *Channels_Ptr, uint8 Num_Of_Channels, volatile uint16 *Results_Ptr);
+
+/*
+ * Description:
+ * Return TRUE when the last scan is completed (or no scan was started).
+ */
+boolean ADC_IsScanComplete(void);
+
 
 #endif /* ADC_H_ */
@@ -0,0 +1,345 @@
+/*****************************************************************************************************************
+ * File Name: CONFIG.c
+ * Date: 19/10/2026
+ * Driver: Runtime Configuration Stored in EEPROM Source File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include <avr/pgmspace.h>
+#include "CONFIG.h"
+#include "EEPROM.h"
+#include "LINK.h"
+
+/******************************************************************************************
+ *                                    Macros Definitions                                  *
+ ******************************************************************************************/
+
+/* VERSION + VALUES + CRC8 */
+#define CONFIG_BLOCK_SIZE                    (1 + (CONFIG_NUM_OF_PARAMS * 2) + 1)
+
+#if ((CONFIG_EEPROM_START + CONFIG_BLOCK_SIZE) > EEPROM_SIZE)
+
+#error "The configuration block does not fit in the EEPROM"
+
+#endif
+
+/* Saving is not in progress */
+#define CONFIG_SAVE_IDLE                     0xFF
+
+/******************************************************************************************
+ *                                     Types Declaration                                  *
+ ******************************************************************************************/
+
+typedef struct
+{
+	uint16 Default;
+	uint16 Min;
+	uint16 Max;
+}Config_ParamType;
+
+/***************************************************************************************
+ *                                         Global Variables                            *
+ ***************************************************************************************/
+
+/* Default value and allowed range of every parameter, indexed by Config_ParamId */
+static const Config_ParamType g_configParams[CONFIG_NUM_OF_PARAMS] PROGMEM =
+{
+	{20,    0,    150},        /* CONFIG_LED_YELLOW_TEMPERATURE  */
+	{40,    0,    150},        /* CONFIG_LED_RED_TEMPERATURE     */
+	{1,     0,    10},         /* CONFIG_LED_HYSTERESIS          */
+	{716,   1,    1023},       /* CONFIG_FAN_SPEED_THRESHOLD     */
+	{20,    0,    200},        /* CONFIG_FAN_SPEED_HYSTERESIS    */
+	{256,   0,    1023},       /* CONFIG_EMERGENCY_SPEED         */
+	{70,    1,    255},        /* CONFIG_FAN_ON_CODE             */
+	{2,     1,    20},         /* CONFIG_CONFIRM_SAMPLES         */
+	{10000, 1000, 60000},      /* CONFIG_LOGGER_SAMPLE_PERIOD_MS */
+	{15,    1,    500}         /* CONFIG_RATE_OF_RISE_LIMIT      */
+};
+
+Config_Type g_config;
+
+/* Save in progress: next byte of the block and the CRC of the bytes queued so far */
+static uint8 g_configSaveIndex = CONFIG_SAVE_IDLE;
+static uint8 g_configSaveCrc;
+
+static void (*g_configCallBackPtr)(void) = NULL_PTR;
+
+/***************************************************************************************
+ *                                      Private Functions                              *
+ ***************************************************************************************/
+
+/* Same CRC8 as the link frames (polynomial 0x07) */
+static uint8 Config_Crc8Update(uint8 Crc, uint8 Byte)
+{
+	uint8 i;
+
+	Crc ^= Byte;
+	for (i = 0; i < 8; i++)
+	{
+		Crc = (Crc & 0x80) ? (uint8)((Crc << 1) ^ 0x07) : (uint8)(Crc << 1);
+	}
+
+	return Crc;
+}
+
+/* Check a value against the range of its parameter */
+static boolean Config_InRange(Config_ParamId Id, uint16 Value)
+{
+	return ((Value >= pgm_read_word(&g_configParams[Id].Min)) && (Value <= pgm_read_word(&g_configParams[Id].Max))) ? TRUE : FALSE;
+}
+
+/* Byte Index of the block to be saved: VERSION, VALUES, then the CRC of all the previous bytes */
+static uint8 Config_BlockByte(uint8 Index)
+{
+	uint16 Value;
+
+	if (Index == 0)
+	{
+		return CONFIG_VERSION;
+	}
+	if (Index == (CONFIG_BLOCK_SIZE - 1))
+	{
+		return g_configSaveCrc;
+	}
+
+	Value = g_config.Values[(Index - 1) >> 1];
+	return ((Index - 1) & 1) ? (uint8)(Value >> 8) : (uint8)Value;
+}
+
+/* Send the answer of a command to the requester */
+static void Config_Reply(uint8 Source, uint8 Command, uint8 Id, uint16 Value, uint8 Status)
+{
+	uint8 Reply[5];
+
+	Reply[0] = Command;
+	Reply[1] = Id;
+	Reply[2] = (uint8)Value;
+	Reply[3] = (uint8)(Value >> 8);
+	Reply[4] = Status;
+
+	Link_Send(Source, LINK_REPLY_TOPIC, Reply, 5);
+}
+
+/****************************************************************************************
+ *                                     Functions Definitions                            *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Load the configuration block from the EEPROM into g_config (blocking, called once at startup).
+ * Return FALSE if the block is not valid, then the defaults are used and the EEPROM is not touched.
+ */
+boolean Config_Init(void)
+{
+	uint8 Block[CONFIG_BLOCK_SIZE];
+	uint8 Crc = 0;
+	uint8 i;
+	uint16 Value;
+
+	for (i = 0; i < CONFIG_BLOCK_SIZE; i++)
+	{
+		Block[i] = EEPROM_ReadByte(CONFIG_EEPROM_START + i);
+		if (i < (CONFIG_BLOCK_SIZE - 1))
+		{
+			Crc = Config_Crc8Update(Crc, Block[i]);
+		}
+	}
+
+	Config_RestoreDefaults();
+
+	if ((Block[0] != CONFIG_VERSION) || (Block[CONFIG_BLOCK_SIZE - 1] != Crc))
+	{
+		return FALSE;
+	}
+
+	/* Take the stored values, a value out of its range keeps its default */
+	for (i = 0; i < CONFIG_NUM_OF_PARAMS; i++)
+	{
+		Value = Block[1 + (2 * i)] | ((uint16)Block[2 + (2 * i)] << 8);
+		if (Config_InRange((Config_ParamId)i, Value))
+		{
+			g_config.Values[i] = Value;
+		}
+	}
+
+	/* The hysteresis thresholds must stay in ascending order */
+	if (g_config.Values[CONFIG_LED_YELLOW_TEMPERATURE] >= g_config.Values[CONFIG_LED_RED_TEMPERATURE])
+	{
+		g_config.Values[CONFIG_LED_YELLOW_TEMPERATURE] = pgm_read_word(&g_configParams[CONFIG_LED_YELLOW_TEMPERATURE].Default);
+		g_config.Values[CONFIG_LED_RED_TEMPERATURE] = pgm_read_word(&g_configParams[CONFIG_LED_RED_TEMPERATURE].Default);
+	}
+
+	return TRUE;
+}
+
+/*
+ * Description:
+ * Change one parameter in RAM after checking its range (and the order of the LED thresholds).
+ * Return one of the CONFIG_STATUS values, g_config is not changed if it is not CONFIG_STATUS_OK.
+ */
+uint8 Config_Set(Config_ParamId Id, uint16 Value)
+{
+	if (Id >= CONFIG_NUM_OF_PARAMS)
+	{
+		return CONFIG_STATUS_BAD_ID;
+	}
+
+	if (Config_InRange(Id, Value) == FALSE)
+	{
+		return CONFIG_STATUS_OUT_OF_RANGE;
+	}
+
+	/* The hysteresis thresholds must stay in ascending order */
+	if (((Id == CONFIG_LED_YELLOW_TEMPERATURE) && (Value >= g_config.Values[CONFIG_LED_RED_TEMPERATURE])) ||
+		((Id == CONFIG_LED_RED_TEMPERATURE) && (Value <= g_config.Values[CONFIG_LED_YELLOW_TEMPERATURE])))
+	{
+		return CONFIG_STATUS_OUT_OF_RANGE;
+	}
+
+	g_config.Values[Id] = Value;
+
+	/* A save in progress would mix old and new bytes, start it again */
+	if (g_configSaveIndex != CONFIG_SAVE_IDLE)
+	{
+		Config_Save();
+	}
+
+	return CONFIG_STATUS_OK;
+}
+
+/*
+ * Description:
+ * Put the default values back in RAM.
+ */
+void Config_RestoreDefaults(void)
+{
+	uint8 i;
+
+	for (i = 0; i < CONFIG_NUM_OF_PARAMS; i++)
+	{
+		g_config.Values[i] = pgm_read_word(&g_configParams[i].Default);
+	}
+
+	if (g_configSaveIndex != CONFIG_SAVE_IDLE)
+	{
+		Config_Save();
+	}
+}
+
+/*
+ * Description:
+ * Start writing g_config to the EEPROM, the bytes are queued by Config_Task.
+ */
+void Config_Save(void)
+{
+	g_configSaveIndex = 0;
+	g_configSaveCrc = 0;
+}
+
+/*
+ * Description:
+ * Queue the next bytes of a save to the EEPROM without waiting, to be called every cycle.
+ * A parameter changed during a save restarts it, so the block always matches its CRC.
+ */
+void Config_Task(void)
+{
+	uint8 Byte;
+
+	while ((g_configSaveIndex != CONFIG_SAVE_IDLE) && (EEPROM_GetFreeSpace() > CONFIG_QUEUE_RESERVE))
+	{
+		Byte = Config_BlockByte(g_configSaveIndex);
+		EEPROM_WriteByte(CONFIG_EEPROM_START + g_configSaveIndex, Byte);
+		g_configSaveCrc = Config_Crc8Update(g_configSaveCrc, Byte);
+
+		g_configSaveIndex++;
+		if (g_configSaveIndex == CONFIG_BLOCK_SIZE)
+		{
+			g_configSaveIndex = CONFIG_SAVE_IDLE;
+		}
+	}
+}
+
+/*
+ * Description:
+ * Answer the configuration commands of a LINK_COMMAND_TOPIC frame with a LINK_REPLY_TOPIC frame
+ * to Source. Return FALSE if PAYLOAD[0] is not a configuration command.
+ */
+boolean Config_HandleCommand(uint8 Source, const uint8 *Payload_Ptr, uint8 Length)
+{
+	uint8 Status;
+	uint16 Value;
+
+	switch (Payload_Ptr[0])
+	{
+	case CONFIG_COMMAND_GET:
+		if (Length != 2)
+		{
+			Config_Reply(Source, CONFIG_COMMAND_GET, 0, 0, CONFIG_STATUS_BAD_LENGTH);
+		}
+		else if (Payload_Ptr[1] >= CONFIG_NUM_OF_PARAMS)
+		{
+			Config_Reply(Source, CONFIG_COMMAND_GET, Payload_Ptr[1], 0, CONFIG_STATUS_BAD_ID);
+		}
+		else
+		{
+			Config_Reply(Source, CONFIG_COMMAND_GET, Payload_Ptr[1], g_config.Values[Payload_Ptr[1]], CONFIG_STATUS_OK);
+		}
+		break;
+
+	case CONFIG_COMMAND_SET:
+		if (Length != 4)
+		{
+			Config_Reply(Source, CONFIG_COMMAND_SET, 0, 0, CONFIG_STATUS_BAD_LENGTH);
+			break;
+		}
+
+		Value = Payload_Ptr[2] | ((uint16)Payload_Ptr[3] << 8);
+		Status = Config_Set((Config_ParamId)Payload_Ptr[1], Value);
+		if ((Status == CONFIG_STATUS_OK) && (g_configCallBackPtr != NULL_PTR))
+		{
+			(*g_configCallBackPtr)();
+		}
+		Config_Reply(Source, CONFIG_COMMAND_SET, Payload_Ptr[1], Value, Status);
+		break;
+
+	case CONFIG_COMMAND_SAVE:
+		if (Length != 1)
+		{
+			Config_Reply(Source, CONFIG_COMMAND_SAVE, 0, 0, CONFIG_STATUS_BAD_LENGTH);
+			break;
+		}
+
+		Config_Save();
+		Config_Reply(Source, CONFIG_COMMAND_SAVE, 0, 0, CONFIG_STATUS_OK);
+		break;
+
+	case CONFIG_COMMAND_DEFAULTS:
+		if (Length != 1)
+		{
+			Config_Reply(Source, CONFIG_COMMAND_DEFAULTS, 0, 0, CONFIG_STATUS_BAD_LENGTH);
+			break;
+		}
+
+		Config_RestoreDefaults();
+		if (g_configCallBackPtr != NULL_PTR)
+		{
+			(*g_configCallBackPtr)();
+		}
+		Config_Reply(Source, CONFIG_COMMAND_DEFAULTS, 0, 0, CONFIG_STATUS_OK);
+		break;
+
+	default:
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+/*
+ * Description:
+ * Set the function called after g_config changed (SET or DEFAULTS command), the application
+ * rebuilds the settings it derived from the configuration there.
+ */
+void Config_SetCallBack(void(*a_ptr)(void))
+{
+	g_configCallBackPtr = a_ptr;
+}
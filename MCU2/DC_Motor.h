@@ -12,17 +12,29 @@
 /******************************************************************************************
  *                                    Macros Definitions                                  *
  ******************************************************************************************/
+/* The driver pins can be moved by the build (-D), e.g. the unit tests put IN2 on another port */
+#ifndef DC_MOTOR_IN1_PORT_ID
 #define DC_MOTOR_IN1_PORT_ID                 PORTB_ID
+#endif
+#ifndef DC_MOTOR_IN1_PIN_ID
 #define DC_MOTOR_IN1_PIN_ID                  PIN0_ID
+#endif
 
+#ifndef DC_MOTOR_IN2_PORT_ID
 #define DC_MOTOR_IN2_PORT_ID                 PORTB_ID
+#endif
+#ifndef DC_MOTOR_IN2_PIN_ID
 #define DC_MOTOR_IN2_PIN_ID                  PIN1_ID
+#endif
 
 #define DC_MOTOR_EN1_PORT_ID                 PORTB_ID
 #define DC_MOTOR_EN1_PIN_ID                  PIN3_ID
 
 #define DC_MOTOR_MAX_SPEED                   100
 
+/* TOP of the Timer1 10-bit Fast PWM, a higher speed is limited to it */
+#define DC_MOTOR_PWM_TOP                     1023
+
 /******************************************************************************************
  *                                     Types Declaration                                  *
  ******************************************************************************************/
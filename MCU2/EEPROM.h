@@ -0,0 +1,63 @@
+/*******************************************************************************************************************
+ * File Name: EEPROM.h
+ * Date: 19/10/2026
+ * Driver: ATmega32 Internal EEPROM Driver Header File
+ * Author: Youssef Zaki
+ ******************************************************************************************************************/
+#include "Standard_Types.h"
+
+#ifndef EEPROM_H_
+#define EEPROM_H_
+
+/*******************************************************************************************
+ *                                    Macros Definitions                                   *
+ *******************************************************************************************/
+
+/* Size of the ATmega32 internal EEPROM in bytes */
+#define EEPROM_SIZE                       1024
+
+/* Number of byte writes waiting for the EE_RDY interrupt (must be a power of two) */
+#define EEPROM_WRITE_QUEUE_SIZE           16
+
+#if ((EEPROM_WRITE_QUEUE_SIZE & (EEPROM_WRITE_QUEUE_SIZE - 1)) != 0)
+
+#error "EEPROM_WRITE_QUEUE_SIZE should be a power of two"
+
+#endif
+
+/*******************************************************************************
+ *                              Functions Prototypes                           *
+ *******************************************************************************/
+
+/*
+ * Description:
+ * Function to queue one byte to be written in the EEPROM without waiting.
+ * 1. The byte is put in the write queue and the EE_RDY interrupt (EERIE) is enabled.
+ * 2. The EE_RDY interrupt starts the writes one by one, every write takes about 8.5 ms.
+ * 3. A byte which already holds the same value is not written again to save the EEPROM cells.
+ * Return FALSE if the queue is full, the byte is not written.
+ * The Global Interrupt must be enabled.
+ */
+boolean EEPROM_WriteByte(uint16 Address, uint8 Data);
+
+/*
+ * Description:
+ * Function to read one byte from the EEPROM.
+ * The read waits (in Idle sleep) until all the queued writes are finished, so call it at startup
+ * or when EEPROM_IsBusy returns FALSE to keep the control loop running.
+ */
+uint8 EEPROM_ReadByte(uint16 Address);
+
+/*
+ * Description:
+ * Return TRUE while queued writes are not finished yet.
+ */
+boolean EEPROM_IsBusy(void);
+
+/*
+ * Description:
+ * Return the number of free places in the write queue.
+ */
+uint8 EEPROM_GetFreeSpace(void);
+
+#endif /* EEPROM_H_ */
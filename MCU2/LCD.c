@@ -5,207 +5,394 @@
  * Author: Youssef Zaki
  ****************************************************************************************************************/
 #include <avr/io.h>
+#include <avr/interrupt.h>
 #include <util/delay.h>
+#include <avr/pgmspace.h>
 #include "LCD.h"
 #include "Common_Macros.h"
 #include "GPIO.h"
+#include "PROFILER.h"
+#include "SYSTICK.h"
 
 /****************************************************************************************
- *                                     Functions Definitions                            *
+ *                                     Macros Definitions                               *
  ****************************************************************************************/
 
 /*
- * Description:
- * 1. Setup the LCD pins directions by GPIO Driver
- * 2. Setup the LCD Data Mode 4-bits or 8-bits.
+ * HD44780 bus timing from the datasheet (worst case of the 2.7V .. 5.5V range) in ns:
+ * tAS: RS setup before E rises, PWEH: E high pulse width, tDSW: data setup before E falls,
+ * tH: data hold after E falls, tcycE: E cycle time.
+ * They are turned into CPU cycles at F_CPU, one cycle more than the truncated value so it is never shorter.
  */
-void LCD_Init(void)
-{
-	/* Setup the RS and E pins as an Output pins to control the LCD */
-	GPIO_SetupPinDirection(LCD_RS_PORT, LCD_RS_PIN, OUTPUT_PIN);
-	GPIO_SetupPinDirection(LCD_E_PORT, LCD_E_PIN, OUTPUT_PIN);
+#define LCD_T_AS_NS                          60
+#define LCD_T_PWEH_NS                        450
+#define LCD_T_DSW_NS                         195
+#define LCD_T_H_NS                           10
+#define LCD_T_CYCLE_E_NS                     1000
 
-	/* LCD Power ON delay always > 15ms */
-	_delay_ms(20);
+#define LCD_NS_TO_CYCLES(NS)                 ((((NS) * (F_CPU / 1000000UL)) / 1000UL) + 1)
 
-#if (LCD_BIT_MODE == 8)
+/* Execution time of a command or a data write, Clear Display and Return Home take 1.52 ms */
+#define LCD_T_EXECUTION_US                   40
+#define LCD_T_CLEAR_MS                       2
 
-	/* let all pins in LCD_DATA_PORT to be an output pins to connect with LCD Data pins  */
-	GPIO_SetupPortDirection(LCD_DATA_PORT, OUTPUT_PORT);
+/*
+ * 4-bit mode: when DB4 .. DB7 are on consecutive pins of the port, a nibble is shifted and masked
+ * into the PORT register in one write instead of four GPIO_WritePin calls.
+ */
+#if (LCD_BIT_MODE == 4)
+
+#if ((LCD_DB5_PIN_ID == (LCD_DB4_PIN_ID + 1)) && (LCD_DB6_PIN_ID == (LCD_DB4_PIN_ID + 2)) && \
+	(LCD_DB7_PIN_ID == (LCD_DB4_PIN_ID + 3)))
+
+#define LCD_DATA_PINS_CONSECUTIVE            1
+#define LCD_DATA_PINS_MASK                   (0x0F << LCD_DB4_PIN_ID)
+
+#if (LCD_DATA_PORT == PORTA_ID)
+#define LCD_DATA_PORT_REGISTER               PORTA
+#elif (LCD_DATA_PORT == PORTB_ID)
+#define LCD_DATA_PORT_REGISTER               PORTB
+#elif (LCD_DATA_PORT == PORTC_ID)
+#define LCD_DATA_PORT_REGISTER               PORTC
+#elif (LCD_DATA_PORT == PORTD_ID)
+#define LCD_DATA_PORT_REGISTER               PORTD
+#endif
 
-	/* Send the command of the 8-bit mode to LCD */
-	LCD_SendCommand(LCD_TWO_LINES_EIGHT_BIT_MODE);
+#else
 
-#elif (LCD_BIT_MODE == 4)
+#define LCD_DATA_PINS_CONSECUTIVE            0
 
-	/* make the 4 Pins in the LCD Data Port as output pins to connect with LCD */
-	GPIO_SetupPinDirection(LCD_DATA_PORT, LCD_DB4_PIN_ID, OUTPUT_PIN);
-	GPIO_SetupPinDirection(LCD_DATA_PORT, LCD_DB5_PIN_ID, OUTPUT_PIN);
-	GPIO_SetupPinDirection(LCD_DATA_PORT, LCD_DB6_PIN_ID, OUTPUT_PIN);
-	GPIO_SetupPinDirection(LCD_DATA_PORT, LCD_DB7_PIN_ID, OUTPUT_PIN);
+#endif
 
-	/* Send for 4-bit initialization of LCD  */
-	LCD_SendCommand(LCD_TWO_LINES_FOUR_BITS_MODE_INIT1);
-	LCD_SendCommand(LCD_TWO_LINES_FOUR_BITS_MODE_INIT2);
+#endif
 
-	/* Send the command of the 4-bit mode to LCD */
-	LCD_SendCommand(LCD_TWO_LINES_FOUR_BIT_MODE);
+/* LCD power-on time before the first instruction (> 15 ms after VCC rises to 4.5V) */
+#define LCD_POWER_ON_MS                      20
 
-#endif
+/* Kinds of the steps of the initialization */
+#define LCD_STEP_NIBBLE                      0         /* 4-bit mode: one nibble with RS = 0 */
+#define LCD_STEP_COMMAND                     1
 
-	/*
-	 * Initialize LCD Screen by sending two commands:
-	 * 1. Clear Screen before writing new data at the beginning
-	 * 2. Turn Off the cursor
-	 */
-	LCD_SendCommand(CLEAR_DISPLAY_SCREEN);
-	LCD_SendCommand(DISPLAY_ON_CURSOR_OFF);
-}
+/*******************************************************************************************
+ *                                      Types Declaration                                  *
+ *******************************************************************************************/
 
-/*
- * Description:
- * Send Command to LCD
- */
-void LCD_SendCommand(uint8 Command)
+/* One step of the initialization: send Data, then wait Wait_Ms before the next step */
+typedef struct
 {
-	/* Register Select Pin RS = 0 -> Transferring Instruction (Command) to LCD */
-	GPIO_WritePin(LCD_RS_PORT, LCD_RS_PIN, LOGIC_LOW);
+	uint8 Type;
+	uint8 Data;
+	uint8 Wait_Ms;
+}LCD_InitStepType;
 
-	/* processing of "tas" = 50 nsec, so delaying for 1 us */
-	_delay_us(1);
+/***************************************************************************************
+ *                                         Global Variables                            *
+ ***************************************************************************************/
 
-	/* Data Enable Pin E = 1 -> Enable the LCD */
-	GPIO_WritePin(LCD_E_PORT, LCD_E_PIN, LOGIC_HIGH);
+/* Initialization sequence of the datasheet, run step by step by LCD_InitTask */
+static const LCD_InitStepType g_lcdInitSteps[] =
+{
+#if (LCD_BIT_MODE == 4)
+	/*
+	 * 4-bit initialization by instruction (nibbles of LCD_TWO_LINES_FOUR_BITS_MODE_INIT1 and INIT2):
+	 * the LCD may be in 8-bit or 4-bit mode, three "8-bit mode" nibbles bring it to 8-bit mode
+	 * with the waits of the datasheet (> 4.1 ms, then > 100 us), then one nibble selects 4-bit mode.
+	 */
+	{LCD_STEP_NIBBLE,  LCD_TWO_LINES_FOUR_BITS_MODE_INIT1 >> 4,   5},
+	{LCD_STEP_NIBBLE,  LCD_TWO_LINES_FOUR_BITS_MODE_INIT1 & 0x0F, 1},
+	{LCD_STEP_NIBBLE,  LCD_TWO_LINES_FOUR_BITS_MODE_INIT2 >> 4,   0},
+	{LCD_STEP_NIBBLE,  LCD_TWO_LINES_FOUR_BITS_MODE_INIT2 & 0x0F, 0},
+	{LCD_STEP_COMMAND, LCD_TWO_LINES_FOUR_BIT_MODE,               0},
+#elif (LCD_BIT_MODE == 8)
+	{LCD_STEP_COMMAND, LCD_TWO_LINES_EIGHT_BIT_MODE,              0},
+#endif
+	/* Clear Screen before writing new data at the beginning, then turn Off the cursor */
+	{LCD_STEP_COMMAND, CLEAR_DISPLAY_SCREEN,                      LCD_T_CLEAR_MS},
+	{LCD_STEP_COMMAND, DISPLAY_ON_CURSOR_OFF,                     0}
+};
 
-	/* processing of (tpw - tdsw) = (290 - 100) = 190 nsec, so delaying 1 us*/
-	_delay_us(1);
+#define LCD_NUM_OF_INIT_STEPS                (sizeof(g_lcdInitSteps) / sizeof(g_lcdInitSteps[0]))
 
-#if (LCD_BIT_MODE == 8)
+/* Next step of the initialization (LCD_NUM_OF_INIT_STEPS = ready), its start time and wait */
+static uint8 g_lcdInitStep = LCD_NUM_OF_INIT_STEPS;
+static uint16 g_lcdStepTime;
+static uint8 g_lcdStepWait;
 
-	/* Send the Instruction from Micro-Controller to the LCD through LCD Data Port (D0 : D7) */
-	GPIO_WritePORT(LCD_DATA_PORT, Command);
+/****************************************************************************************
+ *                                      Private Functions                               *
+ ****************************************************************************************/
 
-	/* processing tdsw = 100 ns, so delaying 1 us */
-	_delay_us(1);
+/* Give the LCD the data on its pins: E high for PWEH, the data is latched when E falls */
+static void LCD_PulseEnable(void)
+{
+	GPIO_WritePin(LCD_E_PORT, LCD_E_PIN, LOGIC_HIGH);
+	__builtin_avr_delay_cycles(LCD_NS_TO_CYCLES(LCD_T_PWEH_NS));
 
-	/* Data Enable Pin E = 0 -> Disable the LCD */
 	GPIO_WritePin(LCD_E_PORT, LCD_E_PIN, LOGIC_LOW);
+	__builtin_avr_delay_cycles(LCD_NS_TO_CYCLES(LCD_T_CYCLE_E_NS - LCD_T_PWEH_NS));
+}
 
-	/* processing of (tpw - tdsw) = (290 - 100) = 190 nsec, so delaying 1 us*/
-	_delay_us(1);
-
-#elif (LCD_BIT_MODE == 4)
+#if (LCD_BIT_MODE == 4)
 
-	/* Sending the Higher nibble (4 bits) of the command through 4 pins of Micro-Controller to LCD */
-	GPIO_WritePin(LCD_DATA_PORT, LCD_DB4_PIN_ID, GET_BIT(Command, 4));
-	GPIO_WritePin(LCD_DATA_PORT, LCD_DB5_PIN_ID, GET_BIT(Command, 5));
-	GPIO_WritePin(LCD_DATA_PORT, LCD_DB6_PIN_ID, GET_BIT(Command, 6));
-	GPIO_WritePin(LCD_DATA_PORT, LCD_DB7_PIN_ID, GET_BIT(Command, 7));
+/* Put the low nibble of Data on DB4 .. DB7 and latch it */
+static void LCD_WriteNibble(uint8 Data)
+{
+#if (LCD_DATA_PINS_CONSECUTIVE == 1)
+	uint8 SREG_Value = SREG;
+
+	/* The other pins of the port are kept, the read-modify-write must not be broken by an interrupt */
+	cli();
+	LCD_DATA_PORT_REGISTER = (LCD_DATA_PORT_REGISTER & ~LCD_DATA_PINS_MASK) | ((Data & 0x0F) << LCD_DB4_PIN_ID);
+	SREG = SREG_Value;
+#else
+	GPIO_WritePin(LCD_DATA_PORT, LCD_DB4_PIN_ID, GET_BIT(Data, 0));
+	GPIO_WritePin(LCD_DATA_PORT, LCD_DB5_PIN_ID, GET_BIT(Data, 1));
+	GPIO_WritePin(LCD_DATA_PORT, LCD_DB6_PIN_ID, GET_BIT(Data, 2));
+	GPIO_WritePin(LCD_DATA_PORT, LCD_DB7_PIN_ID, GET_BIT(Data, 3));
+#endif
 
-	/* processing tdsw = 100 ns, so delaying 1 us */
-	_delay_ms(1);
+	/* The data setup time tDSW is shorter than PWEH, it is covered by the E pulse */
+	LCD_PulseEnable();
+}
 
-	/* Data Enable Pin E = 0 -> Disable the LCD */
-	GPIO_WritePin(LCD_E_PORT, LCD_E_PIN, LOGIC_LOW);
+#endif
 
-	/* delay for processing th = 13ns, so delaying 1 us */
-	_delay_ms(1);
+/* Send one byte to the instruction register (RS = 0) or the data register (RS = 1) and wait for its execution */
+static void LCD_Write(uint8 Data, uint8 RS)
+{
+	GPIO_WritePin(LCD_RS_PORT, LCD_RS_PIN, RS);
+	__builtin_avr_delay_cycles(LCD_NS_TO_CYCLES(LCD_T_AS_NS));
 
-	/* Data Enable Pin E = 1 -> Enable the LCD */
-	GPIO_WritePin(LCD_E_PORT, LCD_E_PIN, LOGIC_HIGH);
+#if (LCD_BIT_MODE == 8)
 
-	/* processing of (tpw - tdsw) = (290 - 100) = 190 nsec, so delaying 1 us*/
-	_delay_ms(1);
+	/* Send the byte from Micro-Controller to the LCD through LCD Data Port (D0 : D7) */
+	GPIO_WritePORT(LCD_DATA_PORT, Data);
+	LCD_PulseEnable();
 
-	/* Sending the Lower nibble (4 bits) of the command through 4 pins of Micro-Controller to LCD */
-	GPIO_WritePin(LCD_DATA_PORT, LCD_DB4_PIN_ID, GET_BIT(Command, 0));
-	GPIO_WritePin(LCD_DATA_PORT, LCD_DB5_PIN_ID, GET_BIT(Command, 1));
-	GPIO_WritePin(LCD_DATA_PORT, LCD_DB6_PIN_ID, GET_BIT(Command, 2));
-	GPIO_WritePin(LCD_DATA_PORT, LCD_DB7_PIN_ID, GET_BIT(Command, 3));
+#elif (LCD_BIT_MODE == 4)
 
-	/* processing tdsw = 100 ns, so delaying 1 us */
-	_delay_ms(1);
+	/* Higher nibble first, then the lower nibble */
+	LCD_WriteNibble(Data >> 4);
+	LCD_WriteNibble(Data);
 
-	/* Data Enable Pin E = 0 -> Disable the LCD */
-	GPIO_WritePin(LCD_E_PORT, LCD_E_PIN, LOGIC_LOW);
+#endif
 
-	/* delay for processing th = 13ns, so delaying 1 us */
-	_delay_ms(1);
+	_delay_us(LCD_T_EXECUTION_US);
+}
 
-#endif
+/*
+ * Character of a bar graph cell filled with Fill sub-steps (0 .. LCD_BAR_STEPS_PER_CELL)
+ */
+static uint8 LCD_BarCharacter(uint8 Fill)
+{
+	return (Fill == 0) ? ' ' : (LCD_BAR_GLYPH_BASE + Fill - 1);
 }
 
 /*
- * Description:
- * Display Character on LCD
+ * Fill of the cell number Cell when Level sub-steps of the bar are filled
  */
-void LCD_DisplayCharacter(uint8 Data)
+static uint8 LCD_BarCellFill(uint8 Level, uint8 Cell)
 {
-	/* Register Select Pin RS = 1 -> Transferring Data to LCD */
-	GPIO_WritePin(LCD_RS_PORT, LCD_RS_PIN, LOGIC_HIGH);
+	uint8 Cell_Start = Cell * LCD_BAR_STEPS_PER_CELL;
 
-	/* processing of "tas" = 50 nsec, so delaying for 1 us */
-	_delay_ms(1);
+	if (Level <= Cell_Start)
+	{
+		return 0;
+	}
 
-	/* Data Enable Pin E = 1 -> Enable the LCD */
-	GPIO_WritePin(LCD_E_PORT, LCD_E_PIN, LOGIC_HIGH);
+	Level -= Cell_Start;
+	return (Level > LCD_BAR_STEPS_PER_CELL) ? LCD_BAR_STEPS_PER_CELL : Level;
+}
 
-	/* processing of (tpw - tdsw) = (290 - 100) = 190 nsec, so delaying 1 us*/
-	_delay_ms(1);
+/*
+ * Convert a value into its decimal digits without division: every digit is found by subtracting
+ * its power of ten (at most 9 times), which is a few 16-bit subtractions on the AVR instead of the
+ * division routine of itoa. Then display it right aligned in Width characters:
+ * leading spaces, the minus sign, the digits with a decimal point before the last Decimals digits.
+ */
+static void LCD_DisplayDecimal(uint16 Value, boolean Negative, uint8 Decimals, uint8 Width)
+{
+	static const uint16 Powers_Of_Ten[] = {10000, 1000, 100, 10};
+	uint8 Digits[5];
+	uint8 Num_Of_Digits = 0;
+	uint8 Length;
+	uint8 i;
+	uint8 Digit;
 
-#if (LCD_BIT_MODE == 8)
+	PROF_BEGIN(PROF_LCD_INTEGER_TO_STRING);
 
-	/* Send the data from Micro-Controller to the LCD through LCD Data Port (D0 : D7) */
-	GPIO_WritePORT(LCD_DATA_PORT, Data);
+	for (i = 0; i < 4; i++)
+	{
+		Digit = '0';
+		while (Value >= Powers_Of_Ten[i])
+		{
+			Value -= Powers_Of_Ten[i];
+			Digit++;
+		}
+
+		/* Skip the leading zeros, but keep one digit before the decimal point */
+		if ((Num_Of_Digits != 0) || (Digit != '0') || ((4 - i) <= Decimals))
+		{
+			Digits[Num_Of_Digits++] = Digit;
+		}
+	}
+	Digits[Num_Of_Digits++] = '0' + (uint8)Value;
 
-	/* processing tdsw = 100 ns, so delaying 1 us */
-	_delay_us(1);
+	Length = Num_Of_Digits + ((Negative == TRUE) ? 1 : 0) + ((Decimals != 0) ? 1 : 0);
 
-	/* Data Enable Pin E = 0 -> Disable the LCD */
-	GPIO_WritePin(LCD_E_PORT, LCD_E_PIN, LOGIC_LOW);
+	/* Leading spaces erase the longer value shown before at the same place */
+	for (; Length < Width; Length++)
+	{
+		LCD_DisplayCharacter(' ');
+	}
 
-	/* processing of (tpw - tdsw) = (290 - 100) = 190 nsec, so delaying 1 us*/
-	_delay_us(1);
+	if (Negative == TRUE)
+	{
+		LCD_DisplayCharacter('-');
+	}
 
-#elif (LCD_BIT_MODE == 4)
+	for (i = 0; i < Num_Of_Digits; i++)
+	{
+		if ((Decimals != 0) && (i == (Num_Of_Digits - Decimals)))
+		{
+			LCD_DisplayCharacter('.');
+		}
+		LCD_DisplayCharacter(Digits[i]);
+	}
 
-	/* Sending the Higher nibble (4 bits) of the data through 4 pins of Micro-Controller to LCD */
-	GPIO_WritePin(LCD_DATA_PORT, LCD_DB4_PIN_ID, GET_BIT(Data, 4));
-	GPIO_WritePin(LCD_DATA_PORT, LCD_DB5_PIN_ID, GET_BIT(Data, 5));
-	GPIO_WritePin(LCD_DATA_PORT, LCD_DB6_PIN_ID, GET_BIT(Data, 6));
-	GPIO_WritePin(LCD_DATA_PORT, LCD_DB7_PIN_ID, GET_BIT(Data, 7));
+	PROF_END(PROF_LCD_INTEGER_TO_STRING);
+}
 
-	/* processing tdsw = 100 ns, so delaying 1 us */
-	_delay_ms(1);
+/****************************************************************************************
+ *                                     Functions Definitions                            *
+ ****************************************************************************************/
 
-	/* Data Enable Pin E = 0 -> Disable the LCD */
+/*
+ * Description:
+ * 1. Setup the LCD pins directions by GPIO Driver
+ * 2. Setup the LCD Data Mode 4-bits or 8-bits.
+ * Blocking version of LCD_StartInit and LCD_InitTask, the SysTick must be initialized.
+ */
+void LCD_Init(void)
+{
+	LCD_StartInit();
+
+	while (LCD_InitTask() == FALSE)
+	{
+	}
+}
+
+/*
+ * Description:
+ * Setup the LCD pins directions and start the initialization without waiting.
+ * The power-on delay and the initialization commands are then run by LCD_InitTask.
+ * The SysTick must be initialized.
+ */
+void LCD_StartInit(void)
+{
+	/* Setup the RS and E pins as an Output pins to control the LCD */
+	GPIO_SetupPinDirection(LCD_RS_PORT, LCD_RS_PIN, OUTPUT_PIN);
+	GPIO_SetupPinDirection(LCD_E_PORT, LCD_E_PIN, OUTPUT_PIN);
 	GPIO_WritePin(LCD_E_PORT, LCD_E_PIN, LOGIC_LOW);
 
-	/* delay for processing th = 13ns, so delaying 1 us */
-	_delay_ms(1);
+#if (LCD_BIT_MODE == 8)
 
-	/* Data Enable Pin E = 1 -> Enable the LCD */
-	GPIO_WritePin(LCD_E_PORT, LCD_E_PIN, LOGIC_HIGH);
+	/* let all pins in LCD_DATA_PORT to be an output pins to connect with LCD Data pins  */
+	GPIO_SetupPortDirection(LCD_DATA_PORT, OUTPUT_PORT);
 
-	/* processing of (tpw - tdsw) = (290 - 100) = 190 nsec, so delaying 1 us*/
-	_delay_ms(1);
+#elif (LCD_BIT_MODE == 4)
 
-	/* Sending the Lower nibble (4 bits) of the data through 4 pins of Micro-Controller to LCD */
-	GPIO_WritePin(LCD_DATA_PORT, LCD_DB4_PIN_ID, GET_BIT(Data, 0));
-	GPIO_WritePin(LCD_DATA_PORT, LCD_DB5_PIN_ID, GET_BIT(Data, 1));
-	GPIO_WritePin(LCD_DATA_PORT, LCD_DB6_PIN_ID, GET_BIT(Data, 2));
-	GPIO_WritePin(LCD_DATA_PORT, LCD_DB7_PIN_ID, GET_BIT(Data, 3));
+	/* make the 4 Pins in the LCD Data Port as output pins to connect with LCD */
+	GPIO_SetupPinDirection(LCD_DATA_PORT, LCD_DB4_PIN_ID, OUTPUT_PIN);
+	GPIO_SetupPinDirection(LCD_DATA_PORT, LCD_DB5_PIN_ID, OUTPUT_PIN);
+	GPIO_SetupPinDirection(LCD_DATA_PORT, LCD_DB6_PIN_ID, OUTPUT_PIN);
+	GPIO_SetupPinDirection(LCD_DATA_PORT, LCD_DB7_PIN_ID, OUTPUT_PIN);
 
-	/* processing tdsw = 100 ns, so delaying 1 us */
-	_delay_ms(1);
+#endif
 
-	/* Data Enable Pin E = 0 -> Disable the LCD */
-	GPIO_WritePin(LCD_E_PORT, LCD_E_PIN, LOGIC_LOW);
+	/* LCD Power ON delay always > 15ms, counted from now */
+	g_lcdInitStep = 0;
+	g_lcdStepTime = SysTick_GetTicks();
+	g_lcdStepWait = LCD_POWER_ON_MS;
+}
 
-	/* delay for processing th = 13ns, so delaying 1 us */
-	_delay_ms(1);
+/*
+ * Description:
+ * Run the next steps of the initialization whose wait is over, never waits more than the
+ * execution time of one command. Call it often (every cycle and after every wake-up) until it
+ * returns TRUE, the LCD must not be used before.
+ * Return TRUE when the LCD is ready.
+ */
+boolean LCD_InitTask(void)
+{
+	const LCD_InitStepType *Step_Ptr;
 
+	/* A started SysTick period is not a full millisecond, so one more tick is waited after a wait */
+	while ((g_lcdInitStep < LCD_NUM_OF_INIT_STEPS) &&
+	       ((g_lcdStepWait == 0) || SysTick_HasElapsed(g_lcdStepTime, g_lcdStepWait + 1)))
+	{
+		Step_Ptr = &g_lcdInitSteps[g_lcdInitStep];
+
+#if (LCD_BIT_MODE == 4)
+		if (Step_Ptr -> Type == LCD_STEP_NIBBLE)
+		{
+			GPIO_WritePin(LCD_RS_PORT, LCD_RS_PIN, LOGIC_LOW);
+			LCD_WriteNibble(Step_Ptr -> Data);
+			_delay_us(LCD_T_EXECUTION_US);
+		}
+		else
 #endif
+		{
+			LCD_Write(Step_Ptr -> Data, LOGIC_LOW);
+		}
+
+		g_lcdInitStep++;
+		g_lcdStepTime = SysTick_GetTicks();
+		g_lcdStepWait = Step_Ptr -> Wait_Ms;
+
+		/* Steps without a wait follow at once */
+		if (g_lcdStepWait != 0)
+		{
+			break;
+		}
+	}
+
+	return LCD_IsReady();
+}
+
+/*
+ * Description:
+ * Return TRUE when the initialization is finished.
+ */
+boolean LCD_IsReady(void)
+{
+	return (g_lcdInitStep == LCD_NUM_OF_INIT_STEPS) ? TRUE : FALSE;
+}
+
+/*
+ * Description:
+ * Send Command to LCD
+ */
+void LCD_SendCommand(uint8 Command)
+{
+	/* Register Select Pin RS = 0 -> Transferring Instruction (Command) to LCD */
+	LCD_Write(Command, LOGIC_LOW);
+
+	/* Clear Display and Return Home take much longer than the other commands */
+	if ((Command == CLEAR_DISPLAY_SCREEN) || (Command == RETURN_HOME))
+	{
+		_delay_ms(LCD_T_CLEAR_MS);
+	}
+}
+
+/*
+ * Description:
+ * Display Character on LCD
+ */
+void LCD_DisplayCharacter(uint8 Data)
+{
+	/* Register Select Pin RS = 1 -> Transferring Data to LCD */
+	LCD_Write(Data, LOGIC_HIGH);
 }
 
 /*
@@ -230,6 +417,23 @@ void LCD_DisplayString(const char *Str)
 	*/
 }
 
+/*
+ * Description:
+ * Display String stored in the flash memory (PROGMEM / PSTR) on LCD
+ * The characters are read with pgm_read_byte, so the string takes no RAM.
+ */
+void LCD_DisplayString_P(const char *Str)
+{
+	uint8 Character = pgm_read_byte(Str);
+
+	while (Character != '\0')
+	{
+		LCD_DisplayCharacter(Character);
+		Str++;
+		Character = pgm_read_byte(Str);
+	}
+}
+
 /*
  * Description:
  * Move cursor to the required position on LCD
@@ -273,6 +477,20 @@ void LCD_DisplayStringRowColumn(uint8 row, uint8 col, const char *Str)
 	LCD_DisplayString(Str);
 }
 
+/*
+ * Description:
+ * 1. Move cursor to the required position on LCD
+ * 2. Display string stored in the flash memory (PROGMEM / PSTR) from the required position
+ */
+void LCD_DisplayStringRowColumn_P(uint8 row, uint8 col, const char *Str)
+{
+	/* Go to the required LCD Position */
+	LCD_MoveCursor(row, col);
+
+	/* Display the Required String */
+	LCD_DisplayString_P(Str);
+}
+
 /*
  * Description:
  * Clear string on LCD
@@ -289,12 +507,150 @@ void LCD_ClearString(void)
  */
 void LCD_IntegerToString(int Data)
 {
-	/* String to hold the ASCII result */
-	char buff[16];
+	if (Data < 0)
+	{
+		LCD_DisplayDecimal((uint16)(-(sint32)Data), TRUE, 0, 0);
+	}
+	else
+	{
+		LCD_DisplayDecimal((uint16)Data, FALSE, 0, 0);
+	}
+}
+
+/*
+ * Description:
+ * Display an unsigned value right aligned in a field of Width characters (leading spaces),
+ * so a shorter value overwrites all the digits of a longer one. A value longer than Width
+ * is displayed completely.
+ */
+void LCD_DisplayNumber(uint16 Number, uint8 Width)
+{
+	LCD_DisplayDecimal(Number, FALSE, 0, Width);
+}
 
-	/* Use itoa C function to convert the data to its corresponding ASCII value, 10 for decimal */
-	itoa(Data, buff, 10);
+/*
+ * Description:
+ * Display a fixed-point value right aligned in a field of Width characters.
+ * Value is in units of 10^-Decimals (0 .. 4), e.g. 235 with Decimals = 1 is displayed as "23.5"
+ * and -5 as "-0.5". Width counts the sign and the decimal point.
+ */
+void LCD_DisplayFixedPoint(sint16 Value, uint8 Decimals, uint8 Width)
+{
+	if (Value < 0)
+	{
+		LCD_DisplayDecimal((uint16)(-(sint32)Value), TRUE, Decimals, Width);
+	}
+	else
+	{
+		LCD_DisplayDecimal((uint16)Value, FALSE, Decimals, Width);
+	}
+}
+
+/*
+ * Description:
+ * Upload a custom character (glyph) in the CGRAM place Location (0 .. 7).
+ * Pattern_Ptr points to LCD_GLYPH_ROWS bytes, the 5 low bits of every byte are the dots of a row.
+ * The glyph is displayed with LCD_DisplayCharacter(Location).
+ * The LCD address is left in the CGRAM, so move the cursor before displaying anything.
+ */
+void LCD_CreateCharacter(uint8 Location, const uint8 *Pattern_Ptr)
+{
+	uint8 i;
+
+	/* Every glyph takes 8 bytes of the CGRAM, the data writes then go to the CGRAM with auto increment */
+	LCD_SendCommand(SET_CGRAM_ADDRESS | ((Location & (LCD_NUM_OF_GLYPHS - 1)) * LCD_GLYPH_ROWS));
+
+	for (i = 0; i < LCD_GLYPH_ROWS; i++)
+	{
+		LCD_DisplayCharacter(Pattern_Ptr[i] & 0x1F);
+	}
+}
+
+/*
+ * Description:
+ * Upload the bar glyphs, attach the configuration to the bar graph and draw it empty.
+ */
+void LCD_BarGraphInit(LCD_BarGraphType *Bar_Ptr, const LCD_BarGraphConfigType *Config_Ptr)
+{
+	uint8 Pattern[LCD_GLYPH_ROWS];
+	uint8 Fill;
+	uint8 i;
+
+	/* Glyph of Fill columns: the Fill left dots of every row are on */
+	for (Fill = 1; Fill <= LCD_BAR_STEPS_PER_CELL; Fill++)
+	{
+		for (i = 0; i < LCD_GLYPH_ROWS; i++)
+		{
+			Pattern[i] = (uint8)(0x1F << (LCD_BAR_STEPS_PER_CELL - Fill)) & 0x1F;
+		}
+		LCD_CreateCharacter(LCD_BAR_GLYPH_BASE + Fill - 1, Pattern);
+	}
+
+	Bar_Ptr -> Config_Ptr = Config_Ptr;
+	Bar_Ptr -> Level = 0;
+
+	LCD_MoveCursor(Config_Ptr -> Row, Config_Ptr -> Col);
+	for (i = 0; i < Config_Ptr -> Width; i++)
+	{
+		LCD_DisplayCharacter(' ');
+	}
+}
+
+/*
+ * Description:
+ * Show Value (0 .. Max, a bigger value fills the whole bar) on the bar graph.
+ * Only the cells whose fill changed are written, so a small change costs one cursor move
+ * and one or two characters. The cursor is left after the last written cell.
+ */
+void LCD_BarGraphUpdate(LCD_BarGraphType *Bar_Ptr, uint16 Value)
+{
+	const LCD_BarGraphConfigType *Config_Ptr = Bar_Ptr -> Config_Ptr;
+	uint8 Steps = Config_Ptr -> Width * LCD_BAR_STEPS_PER_CELL;
+	uint8 Level;
+	uint8 Cell;
+	uint8 Last_Cell;
+	uint8 Fill;
+	boolean Cursor_Placed = FALSE;
+
+	Level = (Value >= Config_Ptr -> Max) ? Steps : (uint8)(((uint32)Value * Steps) / Config_Ptr -> Max);
+
+	if (Level == Bar_Ptr -> Level)
+	{
+		return;
+	}
+
+	/* Only the cells between the old and the new end of the bar can change */
+	if (Level < Bar_Ptr -> Level)
+	{
+		Cell = Level / LCD_BAR_STEPS_PER_CELL;
+		Last_Cell = (Bar_Ptr -> Level - 1) / LCD_BAR_STEPS_PER_CELL;
+	}
+	else
+	{
+		Cell = Bar_Ptr -> Level / LCD_BAR_STEPS_PER_CELL;
+		Last_Cell = (Level - 1) / LCD_BAR_STEPS_PER_CELL;
+	}
+
+	for (; Cell <= Last_Cell; Cell++)
+	{
+		Fill = LCD_BarCellFill(Level, Cell);
+
+		if (Fill != LCD_BarCellFill(Bar_Ptr -> Level, Cell))
+		{
+			/* The LCD address moves to the next cell by itself, the cursor is placed once */
+			if (Cursor_Placed == FALSE)
+			{
+				LCD_MoveCursor(Config_Ptr -> Row, Config_Ptr -> Col + Cell);
+				Cursor_Placed = TRUE;
+			}
+			LCD_DisplayCharacter(LCD_BarCharacter(Fill));
+		}
+		else
+		{
+			/* A cell which keeps its fill breaks the run of written cells */
+			Cursor_Placed = FALSE;
+		}
+	}
 
-	 /* Display the string */
-	LCD_DisplayString(buff);
+	Bar_Ptr -> Level = Level;
 }
@@ -9,7 +9,10 @@
 #ifndef LCD_H_
 #define LCD_H_
 
+/* 4 or 8 data pins, can be given by the build (-DLCD_BIT_MODE=4) */
+#ifndef LCD_BIT_MODE
 #define LCD_BIT_MODE                               8
+#endif
 
 #if ((LCD_BIT_MODE != 4) && (LCD_BIT_MODE != 8))
 
@@ -48,6 +51,19 @@
 #define SHIFT_ENTIRE_DISPLAY_TO_RIGHT              0x1C
 #define SET_CURSOR_POSITION                        0x80
 #define FORCE_CURSOR_BEGINNING_OF_SECOND_LINE      0xC0
+#define SET_CGRAM_ADDRESS                          0x40
+
+/* Custom characters: 8 glyphs of 5x8 dots in the CGRAM, displayed with the character codes 0 .. 7 */
+#define LCD_NUM_OF_GLYPHS                          8
+#define LCD_GLYPH_ROWS                             8
+
+/*
+ * Bar graph: every cell is filled column by column, so a cell has LCD_BAR_STEPS_PER_CELL sub-steps.
+ * The glyphs of 1 .. 5 filled columns use the CGRAM places LCD_BAR_GLYPH_BASE .. LCD_BAR_GLYPH_BASE + 4,
+ * the other places are free for the application.
+ */
+#define LCD_BAR_STEPS_PER_CELL                     5
+#define LCD_BAR_GLYPH_BASE                         0
 
 /* Control Pins Setup */
 #define LCD_RS_PORT                               PORTA_ID
@@ -72,6 +88,25 @@
 
 #endif
 
+/*******************************************************************************************
+ *                                      Types Declaration                                  *
+ *******************************************************************************************/
+
+/* Place and scale of a horizontal bar graph, Max fills all the Width cells */
+typedef struct
+{
+	uint8 Row;
+	uint8 Col;
+	uint8 Width;
+	uint16 Max;
+}LCD_BarGraphConfigType;
+
+typedef struct
+{
+	const LCD_BarGraphConfigType *Config_Ptr;
+	uint8 Level;                   /* filled sub-steps shown now (0 .. Width * LCD_BAR_STEPS_PER_CELL) */
+}LCD_BarGraphType;
+
 /*******************************************************************************************
  *                                      Functions Prototypes                               *
  *******************************************************************************************/
@@ -80,9 +115,33 @@
  * Description:
  * 1. Setup the LCD pins directions by GPIO Driver
  * 2. Setup the LCD Data Mode 4-bits or 8-bits.
+ * Blocking version of LCD_StartInit and LCD_InitTask, the SysTick must be initialized.
  */
 void LCD_Init(void);
 
+/*
+ * Description:
+ * Setup the LCD pins directions and start the initialization without waiting.
+ * The power-on delay and the initialization commands are then run by LCD_InitTask.
+ * The SysTick must be initialized.
+ */
+void LCD_StartInit(void);
+
+/*
+ * Description:
+ * Run the next steps of the initialization whose wait is over, never waits more than the
+ * execution time of one command. Call it often (every cycle and after every wake-up) until it
+ * returns TRUE, the LCD must not be used before.
+ * Return TRUE when the LCD is ready.
+ */
+boolean LCD_InitTask(void);
+
+/*
+ * Description:
+ * Return TRUE when the initialization is finished.
+ */
+boolean LCD_IsReady(void);
+
 
 /*
  * Description:
@@ -103,6 +162,13 @@ void LCD_DisplayCharacter(uint8 Data);
  */
 void LCD_DisplayString(const char *Str);
 
+/*
+ * Description:
+ * Display String stored in the flash memory (PROGMEM / PSTR) on LCD
+ * The characters are read with pgm_read_byte, so the string takes no RAM.
+ */
+void LCD_DisplayString_P(const char *Str);
+
 /*
  * Description:
  * Move cursor to the required position on LCD
@@ -116,6 +182,13 @@ void LCD_MoveCursor(uint8 row,uint8 col);
  */
 void LCD_DisplayStringRowColumn(uint8 row, uint8 col, const char *Str);
 
+/*
+ * Description:
+ * 1. Move cursor to the required position on LCD
+ * 2. Display string stored in the flash memory (PROGMEM / PSTR) from the required position
+ */
+void LCD_DisplayStringRowColumn_P(uint8 row, uint8 col, const char *Str);
+
 /*
  * Description:
  * Clear string on LCD
@@ -129,4 +202,43 @@ void LCD_ClearString(void);
  */
 void LCD_IntegerToString(int Data);
 
+/*
+ * Description:
+ * Display an unsigned value right aligned in a field of Width characters (leading spaces),
+ * so a shorter value overwrites all the digits of a longer one. A value longer than Width
+ * is displayed completely.
+ */
+void LCD_DisplayNumber(uint16 Number, uint8 Width);
+
+/*
+ * Description:
+ * Display a fixed-point value right aligned in a field of Width characters.
+ * Value is in units of 10^-Decimals (0 .. 4), e.g. 235 with Decimals = 1 is displayed as "23.5"
+ * and -5 as "-0.5". Width counts the sign and the decimal point.
+ */
+void LCD_DisplayFixedPoint(sint16 Value, uint8 Decimals, uint8 Width);
+
+/*
+ * Description:
+ * Upload a custom character (glyph) in the CGRAM place Location (0 .. 7).
+ * Pattern_Ptr points to LCD_GLYPH_ROWS bytes, the 5 low bits of every byte are the dots of a row.
+ * The glyph is displayed with LCD_DisplayCharacter(Location).
+ * The LCD address is left in the CGRAM, so move the cursor before displaying anything.
+ */
+void LCD_CreateCharacter(uint8 Location, const uint8 *Pattern_Ptr);
+
+/*
+ * Description:
+ * Upload the bar glyphs, attach the configuration to the bar graph and draw it empty.
+ */
+void LCD_BarGraphInit(LCD_BarGraphType *Bar_Ptr, const LCD_BarGraphConfigType *Config_Ptr);
+
+/*
+ * Description:
+ * Show Value (0 .. Max, a bigger value fills the whole bar) on the bar graph.
+ * Only the cells whose fill changed are written, so a small change costs one cursor move
+ * and one or two characters. The cursor is left after the last written cell.
+ */
+void LCD_BarGraphUpdate(LCD_BarGraphType *Bar_Ptr, uint16 Value);
+
 #endif /* LCD_H_ */
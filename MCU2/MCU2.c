@@ -2,34 +2,328 @@
  * [File]: MCU2.c
  * [Date]: 2/9/2023
  * [Objective]: Developing a Smart Fire Fighting System - MCU2.
- * [Drivers]: GPIO - Timer1 - UART - ADC - DC_Motor - LCD
+ * [Drivers]: GPIO - Timer0 - Timer1 - UART - ADC - DC_Motor - LCD - Power - SysTick - Hysteresis - Link - EEPROM - Config - State Machine - Watchdog - Supervisor - Trace - Profiler
  * [Author]: Youssef Ahmed Zaki
  *************************************************************************************************************************/
 #include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
 
 /* MCAL Layer */
 #include "GPIO.h"
 #include "TIMER1.h"
 #include "UART.h"
 #include "ADC.h"
+#include "POWER.h"
+#include "EEPROM.h"
+#include "WDG.h"
 
 /* HAL Layer */
 #include "DC_Motor.h"
 #include "LCD.h"
 
-#define MCU1_READY                   0x01
-#define MCU2_READY                   0X02
-
-/* MCU2 Cases */
-#define RECEIVING_TEMPERATURE        0
-#define SENDING_MOTOR_SPEED          1
+/* Services */
+#include "SYSTICK.h"
+#include "TRACE.h"
+#include "PROFILER.h"
+#include "HYSTERESIS.h"
+#include "LINK.h"
+#include "CONFIG.h"
+#include "SUPERVISOR.h"
+#include "FSM.h"
+
+/* Period of the MCU2 control cycle, the CPU sleeps for the rest of the period */
+#define MCU2_CYCLE_PERIOD_MS         50
+
+/* Address of this actuator node on the bus, every MCU2 board needs its own (0 .. MCU1_NUM_OF_ACTUATOR_NODES - 1) */
+#define MCU2_NODE_ADDRESS            (LINK_ACTUATOR_BASE_ADDRESS + 0)
+
+/* A published value is sent again after this time even if it did not change */
+#define LINK_KEEP_ALIVE_MS           1000
+
+/*
+ * The thresholds are in the runtime configuration (CONFIG.h), stored in the EEPROM and changed over the link
+ * by the service PC through MCU1 (LINK_FORWARD_TOPIC):
+ * LED zones: Green < 20 <= Yellow < 40 <= Red, a zone is left downwards 1 C below its threshold.
+ * Fan request when the motor reaches 70% of ADC Max value "1023" (= 716), released 2% below.
+ * The motor runs at 25% (= 256) in emergency. 70 is published to MCU1 when the fan is requested.
+ * The emergency is latched by MCU1, the LEDs keep showing the temperature during it.
+ */
+
+/* Every task must check in at least every 250 ms (5 cycles), the watchdog resets the MCU 520 ms after the last feed */
+#define MCU2_TASK_DEADLINE_MS        250
+
+/*
+ * Commands of the service PC relayed by MCU1 (PAYLOAD[0] of LINK_COMMAND_TOPIC), same ids as MCU1:
+ * {MCU2_COMMAND_GET_AWAKE}, answered with {MCU2_COMMAND_GET_AWAKE, AWAKE %} of the last measurement window
+ */
+#define MCU2_COMMAND_GET_AWAKE       0x03
+
+/* The awake duty of the CPU is measured over windows of this length */
+#define MCU2_AWAKE_WINDOW_MS         1000
+
+/* LED zone levels, they are the events of the LED state machine */
+#define LED_GREEN_ZONE               0
+#define LED_YELLOW_ZONE              1
+#define LED_RED_ZONE                 2
+#define LED_NUM_OF_ZONES             3
+
+/*
+ * Mode state machine: the motor follows the potentiometer in NORMAL only. SAFE runs the motor at the
+ * emergency speed, for an emergency from MCU1 or without news from MCU1 (safe local policy).
+ */
+typedef enum
+{
+	MCU2_STATE_NORMAL,
+	MCU2_STATE_SAFE,             /* parent of LINK_LOST and EMERGENCY */
+	MCU2_STATE_LINK_LOST,
+	MCU2_STATE_EMERGENCY,
+	MCU2_NUM_OF_STATES
+}MCU2_StateId;
+
+/* Dispatched every cycle, an event which does not change the state is ignored by the tables */
+typedef enum
+{
+	MCU2_EVENT_LINK_DOWN,
+	MCU2_EVENT_LINK_UP,
+	MCU2_EVENT_EMERGENCY_ON,
+	MCU2_EVENT_EMERGENCY_OFF,
+	MCU2_NUM_OF_EVENTS
+}MCU2_EventId;
+
+/* LED state machine, one state per lit LED, all the LEDs are off until the first temperature */
+typedef enum
+{
+	LED_STATE_OFF,
+	LED_STATE_GREEN,
+	LED_STATE_YELLOW,
+	LED_STATE_RED,
+	LED_NUM_OF_STATES
+}LED_StateId;
 /********************************************************************************************************
  *                                                                                                      *
  *                                             * Global Variables *                                     *
  *                                                                                                      *
  ********************************************************************************************************/
 
-uint8 MCU2_Sequence = 0;
+/* The thresholds are read in place from the configuration, the bands are copied by MCU2_ApplyConfig */
+static Hysteresis_ConfigType g_ledZoneConfig = {&CONFIG_VALUE(CONFIG_LED_YELLOW_TEMPERATURE), 2, 0, 0};
+static Hysteresis_ConfigType g_fanStateConfig = {&CONFIG_VALUE(CONFIG_FAN_SPEED_THRESHOLD), 1, 0, 0};
+
+/*
+ * Publishing rules indexed by Link_TopicId {Destination, Delta, Keep Alive, Max Value}:
+ * The fan state is sent to MCU1 on every change, in the turn given by MCU1 (at most 200 ms later).
+ */
+static const Link_TopicConfigType g_linkTopics[LINK_NUM_OF_TOPICS] =
+{
+	{LINK_BROADCAST_ADDRESS,   1, LINK_KEEP_ALIVE_MS,       LINK_MAX_TEMPERATURE},   /* LINK_TOPIC_TEMPERATURE */
+	{LINK_BROADCAST_ADDRESS,   1, LINK_KEEP_ALIVE_MS,       LOGIC_HIGH},             /* LINK_TOPIC_EMERGENCY   */
+	{LINK_SENSOR_NODE_ADDRESS, 1, LINK_KEEP_ALIVE_MS,       0xFF},                   /* LINK_TOPIC_FAN_STATE   */
+	{LINK_SENSOR_NODE_ADDRESS, 1, LINK_HEARTBEAT_PERIOD_MS, LINK_UP}                 /* LINK_TOPIC_HEARTBEAT   */
+};
+
+static const Link_ConfigType g_linkConfig = {MCU2_NODE_ADDRESS, g_linkTopics, 0};
+
+/* Motor speed bar graph after the ADC value on the second line of the LCD, full at the ADC max value */
+static const LCD_BarGraphConfigType g_speedBarConfig = {1, 5, 11, 1023};
+static LCD_BarGraphType g_speedBar;
+
+/* The screen is drawn once the LCD finished its initialization in the background */
+static boolean g_displayReady = FALSE;
+
+/* Deadlines of the supervised tasks indexed by Supervisor_TaskId */
+static const uint16 g_taskDeadlines[SUPERVISOR_NUM_OF_TASKS] =
+{
+	MCU2_TASK_DEADLINE_MS,         /* SUPERVISOR_TASK_SENSOR   */
+	MCU2_TASK_DEADLINE_MS,         /* SUPERVISOR_TASK_LINK     */
+	MCU2_TASK_DEADLINE_MS,         /* SUPERVISOR_TASK_ACTUATOR */
+	MCU2_TASK_DEADLINE_MS          /* SUPERVISOR_TASK_DISPLAY  */
+};
+
+static const Supervisor_ConfigType g_supervisorConfig = {g_taskDeadlines, WDG_TIMEOUT_520_MS};
+
+/* Awake duty of the CPU in the last measurement window */
+static uint8 g_awakePercent = 100;
+
+/********************************************************************************************************
+ *                                                                                                      *
+ *                                          * State Machine Tables *                                    *
+ *                                                                                                      *
+ ********************************************************************************************************/
+
+static void MCU2_LedGreenEntry(void);
+static void MCU2_LedYellowEntry(void);
+static void MCU2_LedRedEntry(void);
+static void MCU2_SafeEntry(void);
+
+/* Mode states {Parent, Entry, Exit}, the motor speed is selected every cycle with Fsm_IsIn(MCU2_STATE_SAFE) */
+static const Fsm_StateType g_modeStates[MCU2_NUM_OF_STATES] PROGMEM =
+{
+	{FSM_NO_PARENT,   NULL_PTR,       NULL_PTR}, /* MCU2_STATE_NORMAL    */
+	{FSM_NO_PARENT,   MCU2_SafeEntry, NULL_PTR}, /* MCU2_STATE_SAFE      */
+	{MCU2_STATE_SAFE, NULL_PTR,       NULL_PTR}, /* MCU2_STATE_LINK_LOST */
+	{MCU2_STATE_SAFE, NULL_PTR,       NULL_PTR}  /* MCU2_STATE_EMERGENCY */
+};
+
+/* Mode transitions [State][Event]: LINK_DOWN, LINK_UP, EMERGENCY_ON, EMERGENCY_OFF */
+static const uint8 g_modeTransitions[MCU2_NUM_OF_STATES][MCU2_NUM_OF_EVENTS] PROGMEM =
+{
+	{MCU2_STATE_LINK_LOST, FSM_IGNORE,         MCU2_STATE_EMERGENCY, FSM_IGNORE},            /* NORMAL    */
+	{FSM_IGNORE,           FSM_IGNORE,         FSM_IGNORE,           FSM_IGNORE},            /* SAFE      */
+	{FSM_UNHANDLED,        MCU2_STATE_NORMAL,  FSM_UNHANDLED,        FSM_UNHANDLED},         /* LINK_LOST */
+	{MCU2_STATE_LINK_LOST, FSM_UNHANDLED,      FSM_UNHANDLED,        MCU2_STATE_NORMAL}      /* EMERGENCY */
+};
+
+/* The link is down at startup and the motor already runs at the emergency speed */
+/* The mode machine also takes the emergency frames as soon as Link_Poll reads them */
+static Fsm_Type g_modeMachine;
+
+/* Last emergency state sent by the sensor node, a frame of another node is not taken */
+static uint8 g_sensorEmergency = LOGIC_LOW;
+
+static const Fsm_ConfigType g_modeConfig = {g_modeStates, &g_modeTransitions[0][0], MCU2_NUM_OF_EVENTS, MCU2_STATE_LINK_LOST};
+
+/* LED states {Parent, Entry, Exit} */
+static const Fsm_StateType g_ledStates[LED_NUM_OF_STATES] PROGMEM =
+{
+	{FSM_NO_PARENT, NULL_PTR,            NULL_PTR},      /* LED_STATE_OFF    */
+	{FSM_NO_PARENT, MCU2_LedGreenEntry,  NULL_PTR},      /* LED_STATE_GREEN  */
+	{FSM_NO_PARENT, MCU2_LedYellowEntry, NULL_PTR},      /* LED_STATE_YELLOW */
+	{FSM_NO_PARENT, MCU2_LedRedEntry,    NULL_PTR}       /* LED_STATE_RED    */
+};
+
+/* LED transitions [State][Zone]: GREEN, YELLOW, RED */
+static const uint8 g_ledTransitions[LED_NUM_OF_STATES][LED_NUM_OF_ZONES] PROGMEM =
+{
+	{LED_STATE_GREEN, LED_STATE_YELLOW, LED_STATE_RED},          /* OFF    */
+	{FSM_IGNORE,      LED_STATE_YELLOW, LED_STATE_RED},          /* GREEN  */
+	{LED_STATE_GREEN, FSM_IGNORE,       LED_STATE_RED},          /* YELLOW */
+	{LED_STATE_GREEN, LED_STATE_YELLOW, FSM_IGNORE}              /* RED    */
+};
+
+static const Fsm_ConfigType g_ledConfig = {g_ledStates, &g_ledTransitions[0][0], LED_NUM_OF_ZONES, LED_STATE_OFF};
+
+/********************************************************************************************************
+ *                                                                                                      *
+ *                                          * Configuration Functions *                                 *
+ *                                                                                                      *
+ ********************************************************************************************************/
+
+/* Take the configuration values which are copied in the hysteresis settings, called at startup and on every change */
+static void MCU2_ApplyConfig(void)
+{
+	g_ledZoneConfig.Band = CONFIG_VALUE(CONFIG_LED_HYSTERESIS);
+	g_ledZoneConfig.Confirm_Samples = CONFIG_VALUE(CONFIG_CONFIRM_SAMPLES);
+
+	g_fanStateConfig.Band = CONFIG_VALUE(CONFIG_FAN_SPEED_HYSTERESIS);
+	g_fanStateConfig.Confirm_Samples = CONFIG_VALUE(CONFIG_CONFIRM_SAMPLES);
+}
+
+/* Called by Link_Poll for every value: an emergency from MCU1 is applied within the frame time */
+static void MCU2_LinkHandler(uint8 Source, Link_TopicId Topic, uint16 Value)
+{
+	if ((Topic == LINK_TOPIC_EMERGENCY) && (Source == LINK_SENSOR_NODE_ADDRESS))
+	{
+		g_sensorEmergency = (uint8)Value;
+		Fsm_Dispatch(&g_modeMachine, (Value == LOGIC_HIGH) ? MCU2_EVENT_EMERGENCY_ON : MCU2_EVENT_EMERGENCY_OFF);
+	}
+}
+
+/* Called by Link_Poll for every command frame */
+static void MCU2_CommandHandler(uint8 Source, const uint8 *Payload_Ptr, uint8 Length)
+{
+	uint8 Reply[2];
+
+	switch (Payload_Ptr[0])
+	{
+	case MCU2_COMMAND_GET_AWAKE:
+		if (Length != 1)
+		{
+			break;
+		}
+
+		Reply[0] = MCU2_COMMAND_GET_AWAKE;
+		Reply[1] = g_awakePercent;
+		Link_Send(Source, LINK_REPLY_TOPIC, Reply, 2);
+		break;
+
+	default:
+		/* The services answer their own commands */
+		if (Profiler_HandleCommand(Source, Payload_Ptr, Length) == FALSE)
+		{
+			Config_HandleCommand(Source, Payload_Ptr, Length);
+		}
+		break;
+	}
+}
+
+/********************************************************************************************************
+ *                                                                                                      *
+ *                                          * State Entry Functions *                                   *
+ *                                                                                                      *
+ ********************************************************************************************************/
+
+/* The motor is slowed down as soon as the state is entered, not at the next cycle */
+static void MCU2_SafeEntry(void)
+{
+	DcMotor_Rotate(CW, CONFIG_VALUE(CONFIG_EMERGENCY_SPEED));
+}
+
+static void MCU2_LedGreenEntry(void)
+{
+	/* Turn on only Green LED */
+	GPIO_WritePin(PORTD_ID, PIN2_ID, LOGIC_HIGH);
+	GPIO_WritePin(PORTD_ID, PIN3_ID, LOGIC_LOW);
+	GPIO_WritePin(PORTD_ID, PIN4_ID, LOGIC_LOW);
+}
+
+static void MCU2_LedYellowEntry(void)
+{
+	/* Turn on only Yellow LED */
+	GPIO_WritePin(PORTD_ID, PIN2_ID, LOGIC_LOW);
+	GPIO_WritePin(PORTD_ID, PIN3_ID, LOGIC_HIGH);
+	GPIO_WritePin(PORTD_ID, PIN4_ID, LOGIC_LOW);
+}
+
+static void MCU2_LedRedEntry(void)
+{
+	/* Turn on only Red LED */
+	GPIO_WritePin(PORTD_ID, PIN2_ID, LOGIC_LOW);
+	GPIO_WritePin(PORTD_ID, PIN3_ID, LOGIC_LOW);
+	GPIO_WritePin(PORTD_ID, PIN4_ID, LOGIC_HIGH);
+}
+
+/********************************************************************************************************
+ *                                                                                                      *
+ *                                             * Display Function *                                     *
+ *                                                                                                      *
+ ********************************************************************************************************/
+
+/* Show the ADC value and the speed bar, nothing is displayed until the LCD is initialized */
+static void MCU2_DisplayTask(uint16 Res_Value)
+{
+	if (LCD_InitTask() == FALSE)
+	{
+		return;
+	}
+
+	if (g_displayReady == FALSE)
+	{
+		/* Display this message always on the LCD Screen */
+		LCD_DisplayString_P(PSTR("ADC VALUE = "));
+		LCD_BarGraphInit(&g_speedBar, &g_speedBarConfig);
+		g_displayReady = TRUE;
+	}
+
+	/* Move LCD cursor to this position */
+	LCD_MoveCursor(1,0);
+
+	/* Display the ADC Value on LCD Screen, right aligned in 4 places so a shorter value leaves no old digits */
+	LCD_DisplayNumber(Res_Value, 4);
+
+	/* Redraw only the cells of the speed bar which changed */
+	LCD_BarGraphUpdate(&g_speedBar, Res_Value);
+}
 
 /********************************************************************************************************
  *                                                                                                      *
@@ -38,8 +332,17 @@ uint8 MCU2_Sequence = 0;
  ********************************************************************************************************/
 int main(void)
 {
-	uint8 Receive_Temp;
-	uint16 Res_Value;
+	uint16 Receive_Temp;
+	uint16 Emergency;
+	uint16 Res_Value = 0;
+	uint16 Cycle_Start;
+	uint16 Awake_Window_Start = 0;
+	Hysteresis_Type LED_Zone;
+	Hysteresis_Type Fan_State;
+	Fsm_Type Leds;
+#if (LINK_BENCHMARK_ENABLE == 1)
+	Link_BenchmarkType Benchmark;
+#endif
 	/********************************************************************************************************
 	 *                                                                                                      *
 	 *                                         * Drivers Configurations *                                   *
@@ -50,9 +353,9 @@ int main(void)
 	 * ADC Configuration:
 	 * Voltage Reference = AREF
 	 * Pre-scaler = F_CPU/8
-	 * Free Running Mode
+	 * Single Conversion Mode -> Every reading starts its own conversion and waits for the ADC interrupt.
 	 */
-	ADC_ConfigType ADC_Config = {ADC_AREF, CLK_8, Free_Running};
+	ADC_ConfigType ADC_Config = {ADC_AREF, CLK_8, Single_Conversion};
 
 	/*
 	 * Timer1 PWM Mode Configuration:
@@ -66,12 +369,11 @@ int main(void)
 	/*
 	 * UART Configuration:
 	 * 1. UART Mode -> Asynchronous Mode.
-	 * 2. Data Transmission Speed Mode -> Double Speed Mode.
-	 * 3. Parity Bit State -> Disabled.
-	 * 4. Data Size in Bits -> Eight bits.
-	 * 5. Baud Rate -> 9600.
+	 * 2. Parity Bit State -> Disabled.
+	 * 3. Data Size in Bits -> Nine bits, the ninth bit marks the node address of the multi-drop bus.
+	 * 4. Baud Rate -> UART_BAUD_RATE (9600), the speed mode is selected at compile time.
 	 */
-	UART_ConfigType UART_Config = {Asynchronous, Double_Speed, Disabled, 0, Eight_Bit_3, 9600};
+	UART_ConfigType UART_Config = {Asynchronous, Disabled, One_Bit, Nine_Bit_7};
 
 
 	/********************************************************************************************************
@@ -80,22 +382,78 @@ int main(void)
 	 *                                                                                                      *
 	 ********************************************************************************************************/
 
-	UART_Init(&UART_Config);
-	ADC_Init(&ADC_Config);
+	SysTick_Init();
+	Trace_Init();
+
+	/* Enable the Global Interrupts for the system tick and the ADC conversion complete interrupt */
+	sei();
+
+	/* Load the thresholds from the EEPROM, the defaults are used when the block is not valid */
+	Config_Init();
+	MCU2_ApplyConfig();
+	Config_SetCallBack(MCU2_ApplyConfig);
+
+	/*
+	 * Staged boot, stage 1 - safety: the motor at a safe speed (the link is down, so the emergency speed)
+	 * in less than a millisecond after a reset.
+	 */
 	Timer1_PWM_Mode_Init(&Timer1_Config);
 	DcMotor_Init();
-	LCD_Init();
+	DcMotor_Rotate(CW, CONFIG_VALUE(CONFIG_EMERGENCY_SPEED));
+
+	/* Calibrate the profiler after the interrupts are enabled, the SysTick must be running */
+	Profiler_Init();
+
+	/* Stage 2 - control: the link and the sensor */
+	UART_Init(&UART_Config);
+	ADC_Init(&ADC_Config);
+
+	/* Stage 3 - display: the LCD power-on delay and commands run in the background, see MCU2_DisplayTask */
+	LCD_StartInit();
 
 	/* let the first three pins in in PORTC as output pins to be connected with LEDs */
 	GPIO_SetupPinDirection(PORTD_ID, PIN2_ID, OUTPUT_PIN);
 	GPIO_SetupPinDirection(PORTD_ID, PIN3_ID, OUTPUT_PIN);
 	GPIO_SetupPinDirection(PORTD_ID, PIN4_ID, OUTPUT_PIN);
 
-	/* Display this message always on the LCD Screen */
-	LCD_DisplayString("ADC VALUE = ");
-
-	/* Send to MCU1 that MCU2 is ready to start */
-	UART_SendByte(MCU2_READY);
+	/* LEDs and fan request change only on confirmed transitions */
+	Hysteresis_Init(&LED_Zone, &g_ledZoneConfig);
+	Hysteresis_Init(&Fan_State, &g_fanStateConfig);
+
+	/* The behaviour of the node is in the state machine tables */
+	Fsm_Init(&g_modeMachine, &g_modeConfig);
+	Fsm_Init(&Leds, &g_ledConfig);
+
+	/* Join the bus with the node address, MCU1 broadcasts the temperature to all the actuator nodes */
+	Link_Init(&g_linkConfig);
+	Link_SetCallBack(MCU2_LinkHandler);
+	Link_SetCommandCallBack(MCU2_CommandHandler);
+
+#if (LINK_BENCHMARK_ENABLE == 1)
+	/* Benchmark build: MCU2 receives the benchmark frames, then shows the rate and all the errors and stops */
+	Link_Benchmark(FALSE, LINK_BENCHMARK_DURATION_MS, &Benchmark);
+	while (LCD_InitTask() == FALSE);
+	LCD_ClearString();
+	LCD_DisplayString_P(PSTR("RX FPS = "));
+	LCD_IntegerToString(Benchmark.Frames_Per_Second);
+	LCD_DisplayStringRowColumn_P(1, 0, PSTR("L"));
+	LCD_IntegerToString(Benchmark.Lost_Frames);
+	LCD_DisplayString_P(PSTR(" C"));
+	LCD_IntegerToString(Benchmark.Crc_Errors);
+	LCD_DisplayString_P(PSTR(" F"));
+	LCD_IntegerToString(Benchmark.Frame_Errors);
+	LCD_DisplayString_P(PSTR(" D"));
+	LCD_IntegerToString(Benchmark.Data_Overruns);
+	LCD_DisplayString_P(PSTR(" P"));
+	LCD_IntegerToString(Benchmark.Parity_Errors);
+	while (1);
+#endif
+
+	/* Keep the reset cause in the EEPROM and start the watchdog, the blocking startup steps are over */
+	Supervisor_Init(&g_supervisorConfig);
+
+	/* End of the boot: the argument is the boot-to-control time in ms (from SysTick_Init, the first statement) */
+	TRACE_EVENT(TRACE_EVENT_BOOT_DONE, SysTick_GetTicks());
 
 	/********************************************************************************************************
 	 *                                                                                                      *
@@ -105,101 +463,86 @@ int main(void)
 
 	while (1)
 	{
-		/* Move LCD cursor to this position */
-		LCD_MoveCursor(1,0);
+		Cycle_Start = SysTick_GetTicks();
+
+		/* Read the frames received from MCU1, the last temperature and emergency state are kept in the link cache */
+		PROF_BEGIN(PROF_LINK_POLL);
+		Link_Poll();
+		PROF_END(PROF_LINK_POLL);
+		Supervisor_CheckIn(SUPERVISOR_TASK_LINK);
 
-		/* Check ADC Value and Display it on LCD Screen */
-		if(Res_Value >= 1000)
+		/* Update the LEDs only when the temperature zone really changed, the zone is the event of the LED machine */
+		if ((Link_GetValue(LINK_TOPIC_TEMPERATURE, &Receive_Temp) == TRUE) && Hysteresis_Update(&LED_Zone, Receive_Temp))
 		{
-			LCD_IntegerToString(Res_Value);
+			Fsm_Dispatch(&Leds, Hysteresis_GetLevel(&LED_Zone));
 		}
-		else
-		{
-			LCD_IntegerToString(Res_Value);
 
-			/* Put space in next place when the number is one, two or three digits to prevent noises on LCD */
-			LCD_DisplayCharacter(' ');
-		}
+		/* Feed the link state and the emergency state of MCU1 to the mode machine, the cache tells if it is still valid */
+		Fsm_Dispatch(&g_modeMachine, (Link_GetState() == LINK_UP) ? MCU2_EVENT_LINK_UP : MCU2_EVENT_LINK_DOWN);
+		Fsm_Dispatch(&g_modeMachine, ((Link_GetValue(LINK_TOPIC_EMERGENCY, &Emergency) == TRUE) && (g_sensorEmergency == LOGIC_HIGH)) ?
+				MCU2_EVENT_EMERGENCY_ON : MCU2_EVENT_EMERGENCY_OFF);
 
-		switch (MCU2_Sequence)
+		if (Fsm_IsIn(&g_modeMachine, MCU2_STATE_SAFE))
 		{
+			/*
+			 * Emergency, or no news from MCU1 (safe local policy):
+			 * Slow down the motor to the emergency speed, 25% of its speed by default (1023*25% = 256)
+			 */
+			Res_Value = CONFIG_VALUE(CONFIG_EMERGENCY_SPEED);
+		}
+		else
+		{
+			/* Select ADC0 to be the ADC selected channel and read the value of the potentiometer */
+			Res_Value = ADC_ReadChannel(ADC0);
+		}
+		Supervisor_CheckIn(SUPERVISOR_TASK_SENSOR);
 
-		/* Receiving temperature from MCU1 and based on it, turn on/off LEDs */
-		case RECEIVING_TEMPERATURE:
-
-			/* Synchronization between two MCUs to send/receive data */
-			while (UART_ReceiveByte() != MCU1_READY);
-			UART_SendByte(MCU2_READY);
-
-			/* Receive the temperature from MCU1 */
-			Receive_Temp = UART_ReceiveByte();
+		/* The Motor speed is mainly controlled by the Potentiometer */
+		DcMotor_Rotate(CW, Res_Value);
+		Supervisor_CheckIn(SUPERVISOR_TASK_ACTUATOR);
 
-			if (Receive_Temp == 200)
-			{
-				/* Let Res_Value = 256 to slow down the motor to 25% of its speed (1023*25% = 256) */
-				Res_Value = 256;
+		/* Check if the ADC value reaches the fan threshold, 70% of ADC Max value "1023" (MAX Motor Speed) = 716 by default */
+		if (Hysteresis_Update(&Fan_State, Res_Value))
+		{
+			TRACE_EVENT(TRACE_EVENT_STATE_CHANGE, Hysteresis_GetLevel(&Fan_State));
+		}
 
-				/* Move to the next step */
-				MCU2_Sequence++;
-				break;
+		/* Publish to MCU1 whether the Motor speed reached 70% from its maximum speed, sent only when it changed */
+		Link_Publish(LINK_TOPIC_FAN_STATE, (Hysteresis_GetLevel(&Fan_State) == 1) ? CONFIG_VALUE(CONFIG_FAN_ON_CODE) : 0);
 
-			}
-			else
-			{
-				/* Select ADC0 to be the ADC selected channel and read the value of the potentiometer */
-				Res_Value = ADC_ReadChannel(ADC0);
-
-				if (Receive_Temp < 20)
-				{
-					/* Turn on only Green LED */
-					GPIO_WritePin(PORTD_ID, PIN2_ID, LOGIC_HIGH);
-					GPIO_WritePin(PORTD_ID, PIN3_ID, LOGIC_LOW);
-					GPIO_WritePin(PORTD_ID, PIN4_ID, LOGIC_LOW);
-				}
-				else if (Receive_Temp >= 20 && Receive_Temp < 40)
-				{
-					/* Turn on only Yellow LED */
-					GPIO_WritePin(PORTD_ID, PIN2_ID, LOGIC_LOW);
-					GPIO_WritePin(PORTD_ID, PIN3_ID, LOGIC_HIGH);
-					GPIO_WritePin(PORTD_ID, PIN4_ID, LOGIC_LOW);
-				}
-				else if (Receive_Temp >= 40)
-				{
-					/* Turn on only Red LED */
-					GPIO_WritePin(PORTD_ID, PIN2_ID, LOGIC_LOW);
-					GPIO_WritePin(PORTD_ID, PIN3_ID, LOGIC_LOW);
-					GPIO_WritePin(PORTD_ID, PIN4_ID, LOGIC_HIGH);
-				}
-			}
+		/* Show the ADC value, the LCD is initialized in the background during the first cycles */
+		MCU2_DisplayTask(Res_Value);
+		Supervisor_CheckIn(SUPERVISOR_TASK_DISPLAY);
 
-			/* Move to the next step */
-			MCU2_Sequence++;
-			break;
+		/* Low priority task: save the configuration when requested */
+		Config_Task();
 
-		case SENDING_MOTOR_SPEED:
+		/* Measure the awake duty of the CPU, the service PC reads the last window */
+		if (SysTick_HasElapsed(Awake_Window_Start, MCU2_AWAKE_WINDOW_MS))
+		{
+			g_awakePercent = Power_GetAwakePercent();
+			Awake_Window_Start = SysTick_GetTicks();
+		}
 
-			/* The Motor speed is mainly controlled by the Potentiometer */
-			DcMotor_Rotate(CW, Res_Value);
+		/* Feed the watchdog only if every task ran in time */
+		Supervisor_Service();
 
-			/* Synchronization between two MCUs to send/receive data */
-			UART_SendByte(MCU2_READY);
-			while (UART_ReceiveByte() != MCU1_READY);
+		/*
+		 * Nothing else to run until the next cycle: sleep, but keep reading the link, initializing the LCD
+		 * and sending the recorded trace events to the service PC while the UART transmitter is free
+		 */
+		while (SysTick_HasElapsed(Cycle_Start, MCU2_CYCLE_PERIOD_MS) == FALSE)
+		{
+			Link_Poll();
+			LCD_InitTask();
+			Trace_StreamTask();
 
-			/* Check if the ADC value reaches 70% of ADC Max value "1023" (MAX Motor Speed) which is = 716 */
-			if (Res_Value >= 716)
+			cli();
+			if (UART_Available() == 0)
 			{
-				/* Send to MCU1 that Motor speed is reached 70% from its maximum speed  */
-				UART_SendByte(70);
+				Power_Sleep(POWER_IDLE);
 			}
-			else
-			{
-				/* Send to MCU1 that Motor Speed is less than 70% from its maximum speed */
-				UART_SendByte(0);
-			}
-
-			/* return to the previous step */
-			MCU2_Sequence--;
-			break;
+			sei();
 		}
 	}
 }
@@ -0,0 +1,48 @@
+/*******************************************************************************************************************
+ * File Name: POWER.h
+ * Date: 19/10/2026
+ * Driver: ATmega32 Power Management (Sleep Modes) Driver Header File
+ * Author: Youssef Zaki
+ ******************************************************************************************************************/
+#include "Standard_Types.h"
+
+#ifndef POWER_H_
+#define POWER_H_
+
+/*******************************************************************************************
+ *                                      Types Declaration                                  *
+ *******************************************************************************************/
+
+/*
+ * Values of SM2:0 bits in MCUCR Register.
+ * The deeper modes stop clkIO, so a node on the link bus would lose the bytes of the UART receiver.
+ */
+typedef enum
+{
+	POWER_IDLE                     /* CPU stopped, all peripherals and interrupts keep running */
+}Power_SleepMode;
+
+/*******************************************************************************
+ *                              Functions Prototypes                           *
+ *******************************************************************************/
+
+/*
+ * Description:
+ * Put the CPU into the required sleep mode until the next interrupt.
+ * 1. Must be called with the Global Interrupt disabled, after checking the wake-up condition,
+ *    so an interrupt cannot be lost between the check and the sleep instruction.
+ * 2. Select the sleep mode by SM2:0 bits and set SE bit in MCUCR Register.
+ * 3. Enable the interrupts and sleep (the instruction after SEI is always executed first).
+ * 4. After the wake-up, clear SE bit and return with the Global Interrupt disabled again.
+ * 5. Time spent in sleep is accumulated for Power_GetAwakePercent.
+ */
+void Power_Sleep(Power_SleepMode Mode);
+
+/*
+ * Description:
+ * Return the percentage of time the CPU was awake since the previous call and start a new window.
+ * The window must be shorter than 65.5 seconds (SysTick ticks wrap around), so call it periodically.
+ */
+uint8 Power_GetAwakePercent(void);
+
+#endif /* POWER_H_ */
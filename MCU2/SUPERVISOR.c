@@ -0,0 +1,116 @@
+/*****************************************************************************************************************
+ * File Name: SUPERVISOR.c
+ * Date: 19/10/2026
+ * Driver: Watchdog Supervisor of the Application Tasks Source File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include "SUPERVISOR.h"
+#include "WDG.h"
+#include "EEPROM.h"
+#include "SYSTICK.h"
+
+/***************************************************************************************
+ *                                         Global Variables                            *
+ ***************************************************************************************/
+
+static const Supervisor_ConfigType *g_supervisorConfigPtr = NULL_PTR;
+
+static uint16 g_supervisorCheckIn[SUPERVISOR_NUM_OF_TASKS];
+static uint8 g_supervisorResetCause = 0;
+
+/* Late task, not cleared by the startup code so it can be read after the watchdog reset */
+static uint8 g_supervisorLateTask __attribute__((section(".noinit")));
+
+/****************************************************************************************
+ *                                     Functions Definitions                            *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * 1. Read the reset cause from MCUCSR and keep it in the EEPROM reset record, a watchdog reset
+ *    also saves the task which was late and counts the watchdog resets.
+ * 2. Start every task deadline now and enable the watchdog with the configured time-out.
+ * Call it after the blocking startup steps. The SysTick must be initialized.
+ */
+void Supervisor_Init(const Supervisor_ConfigType *Config_Ptr)
+{
+	uint16 Watchdog_Resets;
+	uint8 Task;
+
+	g_supervisorConfigPtr = Config_Ptr;
+	g_supervisorResetCause = WDG_GetResetCause();
+
+	EEPROM_WriteByte(SUPERVISOR_EEPROM_RESET_CAUSE, g_supervisorResetCause);
+
+	if (g_supervisorResetCause & WDG_RESET_WATCHDOG)
+	{
+		Watchdog_Resets = EEPROM_ReadByte(SUPERVISOR_EEPROM_WATCHDOG_RESETS) |
+			((uint16)EEPROM_ReadByte(SUPERVISOR_EEPROM_WATCHDOG_RESETS + 1) << 8);
+
+		/* An erased counter (0xFFFF) starts from zero */
+		Watchdog_Resets = (Watchdog_Resets == 0xFFFF) ? 1 : (Watchdog_Resets + 1);
+
+		EEPROM_WriteByte(SUPERVISOR_EEPROM_LATE_TASK,
+			(g_supervisorLateTask < SUPERVISOR_NUM_OF_TASKS) ? g_supervisorLateTask : SUPERVISOR_NO_TASK);
+		EEPROM_WriteByte(SUPERVISOR_EEPROM_WATCHDOG_RESETS, (uint8)Watchdog_Resets);
+		EEPROM_WriteByte(SUPERVISOR_EEPROM_WATCHDOG_RESETS + 1, (uint8)(Watchdog_Resets >> 8));
+	}
+
+	g_supervisorLateTask = SUPERVISOR_NO_TASK;
+
+	for (Task = 0; Task < SUPERVISOR_NUM_OF_TASKS; Task++)
+	{
+		g_supervisorCheckIn[Task] = SysTick_GetTicks();
+	}
+
+	WDG_Enable(Config_Ptr -> Timeout);
+}
+
+/*
+ * Description:
+ * Report that a task finished its work of this cycle.
+ */
+void Supervisor_CheckIn(Supervisor_TaskId Task)
+{
+	g_supervisorCheckIn[Task] = SysTick_GetTicks();
+}
+
+/*
+ * Description:
+ * Feed the watchdog only when every supervised task checked in within its deadline, to be called
+ * once every cycle. Return FALSE if a task is late: the watchdog is not fed any more and resets
+ * the MCU at its time-out, the late task is kept over the reset.
+ */
+boolean Supervisor_Service(void)
+{
+	uint16 Deadline;
+	uint8 Task;
+
+	if ((g_supervisorConfigPtr == NULL_PTR) || (g_supervisorLateTask != SUPERVISOR_NO_TASK))
+	{
+		return FALSE;
+	}
+
+	for (Task = 0; Task < SUPERVISOR_NUM_OF_TASKS; Task++)
+	{
+		Deadline = g_supervisorConfigPtr -> Deadlines_Ms[Task];
+
+		if ((Deadline != 0) && SysTick_HasElapsed(g_supervisorCheckIn[Task], Deadline))
+		{
+			g_supervisorLateTask = Task;
+			return FALSE;
+		}
+	}
+
+	WDG_Refresh();
+	return TRUE;
+}
+
+/*
+ * Description:
+ * Return the reset cause read by Supervisor_Init (WDG_RESET_xxx flags).
+ */
+uint8 Supervisor_GetResetCause(void)
+{
+	return g_supervisorResetCause;
+}
@@ -0,0 +1,104 @@
+/*****************************************************************************************************************
+ * File Name: SYSTICK.c
+ * Date: 19/10/2026
+ * Driver: System Tick Service Source File (based on Timer0)
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "TIMER0.h"
+#include "SYSTICK.h"
+#include "Common_Macros.h"
+
+/***************************************************************************************
+ *                                         Global Variables                            *
+ ***************************************************************************************/
+
+/* Number of ticks since the start, it is updated only from the Timer0 interrupt */
+static volatile uint16 g_sysTicks = 0;
+
+/***************************************************************************************
+ *                                      Private Functions                              *
+ ***************************************************************************************/
+
+/* Timer0 Call Back function which is called every tick */
+static void SysTick_Handler(void)
+{
+	g_sysTicks++;
+}
+
+/****************************************************************************************
+ *                                     Functions Definitions                            *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Start Timer0 in CTC Mode to generate an interrupt every SYSTICK_TICK_MS.
+ * The Global Interrupt Enable bit must be set by the application afterwards.
+ */
+void SysTick_Init(void)
+{
+	/*
+	 * Timer0 CTC Mode Configuration:
+	 * 1. TCNT0 = 0 -> Starting Value of Timer is Zero.
+	 * 2. OCR0 = (Counts per tick - 1) -> Compare match every 1 ms.
+	 * 3. Pre-scalar -> F_CPU/8 (F_CPU/64 for faster crystals).
+	 */
+	Timer0_ConfigType Timer0_Config = {0, (uint8)(SYSTICK_COUNTS_PER_TICK - 1), SYSTICK_PRESCALER, TIMER0_CTC_2};
+
+	g_sysTicks = 0;
+	Timer0_SetCallBack(SysTick_Handler);
+	Timer0_Init(&Timer0_Config);
+}
+
+/*
+ * Description:
+ * Return the number of milliseconds since SysTick_Init (wraps around every 65.5 seconds).
+ */
+uint16 SysTick_GetTicks(void)
+{
+	uint16 Ticks;
+	uint8 SREG_Value = SREG;
+
+	/* The 16-bit counter is shared with the interrupt, so read it with interrupts disabled */
+	cli();
+	Ticks = g_sysTicks;
+	SREG = SREG_Value;
+
+	return Ticks;
+}
+
+/*
+ * Description:
+ * Return a free-running time stamp in Timer0 counts (SYSTICK_CYCLES_PER_COUNT cycles each).
+ * The value wraps around at 16 bits, so differences are valid for intervals shorter than
+ * 65536 counts (524 ms at 1 MHz).
+ */
+uint16 SysTick_GetFineTime(void)
+{
+	uint16 Ticks;
+	uint8 Counts;
+	uint8 SREG_Value = SREG;
+
+	cli();
+	Ticks = g_sysTicks;
+	Counts = TCNT0;
+
+	/* The compare match happened but its interrupt is still pending, so count that tick here */
+	if (BIT_IS_SET(TIFR, OCF0) && (Counts < (SYSTICK_COUNTS_PER_TICK / 2)))
+	{
+		Ticks++;
+	}
+	SREG = SREG_Value;
+
+	return (uint16)(Ticks * (uint16)SYSTICK_COUNTS_PER_TICK) + Counts;
+}
+
+/*
+ * Description:
+ * Return TRUE if at least Period ticks passed since the Start tick (wrap-around safe).
+ */
+boolean SysTick_HasElapsed(uint16 Start, uint16 Period)
+{
+	return ((uint16)(SysTick_GetTicks() - Start) >= Period) ? TRUE : FALSE;
+}
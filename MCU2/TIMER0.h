@@ -0,0 +1,68 @@
+/*******************************************************************************************************************
+ * File Name: TIMER0.h
+ * Date: 19/10/2026
+ * Driver: ATmega32 Timer0 Driver Header File
+ * Author: Youssef Zaki
+ ******************************************************************************************************************/
+#include "Standard_Types.h"
+
+#ifndef TIMER0_H_
+#define TIMER0_H_
+
+/*******************************************************************************************
+ *                                      Types Declaration                                  *
+ *******************************************************************************************/
+
+typedef enum
+{
+	TIMER0_No_Clock,
+	TIMER0_Prescaler_1,
+	TIMER0_Prescaler_8,
+	TIMER0_Prescaler_64,
+	TIMER0_Prescaler_256,
+	TIMER0_Prescaler_1024,
+	TIMER0_External_Clock_Falling_Edge,
+	TIMER0_External_Clock_Rising_Edge
+}Timer0_Prescaler;
+
+typedef enum
+{
+	TIMER0_Normal_0,
+	TIMER0_CTC_2 = 2
+}Timer0_Mode;
+
+typedef struct {
+uint8 initial_value;
+uint8 compare_value; /* it will be used in compare mode only. */
+Timer0_Prescaler prescaler;
+Timer0_Mode mode;
+} Timer0_ConfigType;
+
+/*******************************************************************************
+ *                              Functions Prototypes                           *
+ *******************************************************************************/
+
+/*
+ * Description:
+ * Initialization of Timer0 in Normal or CTC Mode.
+ * 1. Let the TCNT0 Register = The Start value of the timer0.
+ * 2. Configure WGM01:0 bits in TCCR0 according to the Timer0 Mode (OC0 pin disconnected).
+ * 3. In CTC Mode Let OCR0 = the compare value (TOP Value).
+ * 4. Set OCIE0 or TOIE0 in TIMSK Register without touching the Timer1/Timer2 interrupt bits.
+ * 5. Start the timer by configuring CS02:0 bits with the required pre-scalar.
+ */
+void Timer0_Init(const Timer0_ConfigType * Config_Ptr);
+
+/*
+ * Description:
+ * Function to disable the Timer0 and its interrupts only.
+ */
+void Timer0_DeInit(void);
+
+/*
+ * Description:
+ * Function to set the Call Back function address.
+ */
+void Timer0_SetCallBack(void(*a_ptr)(void));
+
+#endif /* TIMER0_H_ */
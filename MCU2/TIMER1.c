@@ -7,6 +7,7 @@
 #include "TIMER1.h"
 #include "Common_Macros.h"
 #include "GPIO.h"
+#include "TRACE.h"
 #include <avr/io.h>
 #include <avr/interrupt.h>
 
@@ -14,7 +15,7 @@
  *                                         Global Variables                            *
  ***************************************************************************************/
 /* Global variables to hold the address of the call back function in the application */
-static volatile void (*g_callBackPtr)(void) = NULL_PTR;
+static void (* volatile g_callBackPtr)(void) = NULL_PTR;
 
 /*******************************************************************************
  *                       Interrupt Service Routines                            *
@@ -22,6 +23,8 @@ static volatile void (*g_callBackPtr)(void) = NULL_PTR;
 /* Interrupt for Normal (Overflow) Mode */
 ISR(TIMER1_OVF_vect)
 {
+	TRACE_EVENT(TRACE_EVENT_ISR_ENTRY, TRACE_ISR_TIMER1_OVF);
+
 	if(g_callBackPtr != NULL_PTR)
 	{
 		/* Call the Call Back function in the application after the edge is detected */
@@ -31,6 +34,8 @@ ISR(TIMER1_OVF_vect)
 /* Interrupt for Compare Mode */
 ISR(TIMER1_COMPA_vect)
 {
+	TRACE_EVENT(TRACE_EVENT_ISR_ENTRY, TRACE_ISR_TIMER1_COMPA);
+
 	if(g_callBackPtr != NULL_PTR)
 	{
 		/* Call the Call Back function in the application after the edge is detected */
@@ -78,8 +83,8 @@ void Timer1_NonPWm_Mode_Init(const Timer1_ConfigType * Config_Ptr)
 		TCCR1B = (TCCR1B & 0xF7) | (1 << WGM12);
 	}
 
-	/* Enable Timer1 Interrupt for mode A */
-	TIMSK = (1<<OCIE1A);
+	/* Enable Timer1 Interrupt for mode A, the Timer0 & Timer2 interrupt bits are kept as they are */
+	SET_BIT(TIMSK, OCIE1A);
 }
 
 /*
@@ -220,6 +225,10 @@ void Timer1_PWM_Mode_Init(const Timer1_ConfigType * Config_Ptr)
 		SET_BIT(TCCR1B, WGM13);
 		SET_BIT(TCCR1A, COM1A1);
 		break;
+
+	default:
+		/* Normal, CTC and reserved modes are not PWM modes: the timer stays in Normal mode, OC1A disconnected */
+		break;
 	}
 }
 
@@ -233,16 +242,20 @@ void TIMER1_PWM_Start (uint16 Duty_Cycle)
 {
 	ICR1 = 2499;
 	OCR1A = Duty_Cycle;
+
+	TRACE_EVENT(TRACE_EVENT_PWM_UPDATE, Duty_Cycle);
 }
 /*
  * Description:
- * Function to disable the Timer1.
+ * Function to disable the Timer1 and its interrupts only.
  */
 void Timer1_DeInit(void)
 {
 	TCCR1A = 0;
 	TCCR1B = 0;
-	TIMSK = 0;
+
+	/* TIMSK & 1100 0011 -> Clear TICIE1, OCIE1A, OCIE1B and TOIE1 only */
+	TIMSK &= 0xC3;
 }
 
 /*
@@ -90,7 +90,7 @@ void TIMER1_PWM_Start (uint16 Duty_Cycle);
 
 /*
  * Description:
- * Function to disable the Timer1.
+ * Function to disable the Timer1 and its interrupts only.
  */
 void Timer1_DeInit(void);
 
@@ -98,6 +98,6 @@ void Timer1_DeInit(void);
  * Description:
  * Function to set the Call Back function address.
  */
-void Timer1_setCallBack(void(*a_ptr)(void));
+void Timer1_SetCallBack(void(*a_ptr)(void));
 
 #endif /* TIMER1_H_ */
@@ -0,0 +1,181 @@
+/*****************************************************************************************************************
+ * File Name: TRACE.c
+ * Date: 19/10/2026
+ * Driver: Event Trace Recorder Source File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "TRACE.h"
+#include "SYSTICK.h"
+#include "Common_Macros.h"
+#include "LINK.h"
+
+#if (TRACE_ENABLE == 1)
+
+#if ((TRACE_BLOCK_HEADER_SIZE + (TRACE_BLOCK_MAX_RECORDS * TRACE_RECORD_SIZE)) > LINK_MAX_PAYLOAD)
+
+#error "A trace block does not fit in one link frame"
+
+#endif
+
+/******************************************************************************************
+ *                                     Types Declaration                                  *
+ ******************************************************************************************/
+
+/* One trace record as it is stored in RAM */
+typedef struct
+{
+	uint8 Id;
+	uint16 Arg;
+	uint16 Time_Stamp;
+}Trace_RecordType;
+
+/***************************************************************************************
+ *                                         Global Variables                            *
+ ***************************************************************************************/
+
+static Trace_RecordType g_traceBuffer[TRACE_BUFFER_SIZE];
+
+/* Index of the next record to write (ISR and main loop) and of the next record to send */
+static volatile uint8 g_traceHead = 0;
+static volatile uint8 g_traceTail = 0;
+
+/* Number of records dropped since the last stream block because the buffer was full */
+static volatile uint8 g_traceDropped = 0;
+
+/* A block is being sent: the UART_TX events of its own bytes are not recorded */
+static volatile boolean g_traceStreaming = FALSE;
+
+/* SysTick tick of the last block sent, for the keep alive block */
+static uint16 g_traceLastBlockTime = 0;
+
+/****************************************************************************************
+ *                                     Functions Definitions                            *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Clear the trace buffer, the SysTick must be initialized to have valid time stamps.
+ */
+void Trace_Init(void)
+{
+	g_traceHead = 0;
+	g_traceTail = 0;
+	g_traceDropped = 0;
+	g_traceStreaming = FALSE;
+	g_traceLastBlockTime = SysTick_GetTicks();
+}
+
+/*
+ * Description:
+ * Store the event id, its argument and the SysTick fine time stamp in the RAM ring buffer.
+ * When the buffer is full, the record is dropped and counted.
+ */
+void Trace_Log(Trace_EventId Id, uint16 Arg)
+{
+	uint8 Head;
+	uint8 SREG_Value;
+
+	/* Tracing the bytes of the trace frames would fill the buffer with the trace itself */
+	if ((Id == TRACE_EVENT_UART_TX) && (g_traceStreaming == TRUE))
+	{
+		return;
+	}
+
+	SREG_Value = SREG;
+	cli();
+	Head = g_traceHead;
+
+	if (((uint8)(Head + 1) & (TRACE_BUFFER_SIZE - 1)) == g_traceTail)
+	{
+		/* Buffer is full, keep the oldest records which explain what happened first */
+		if (g_traceDropped != 0xFF)
+		{
+			g_traceDropped++;
+		}
+	}
+	else
+	{
+		g_traceBuffer[Head].Id = Id;
+		g_traceBuffer[Head].Arg = Arg;
+		g_traceBuffer[Head].Time_Stamp = SysTick_GetFineTime();
+		g_traceHead = (Head + 1) & (TRACE_BUFFER_SIZE - 1);
+	}
+
+	SREG = SREG_Value;
+}
+
+/*
+ * Description:
+ * Low priority task to be called from the idle loop of the application, the link must be initialized.
+ * When the UART transmitter is free and the link can take a frame, send one block of the waiting
+ * records (~23 ms at 9600 bps). An actuator node sends it in its next turn.
+ * The block is the payload of a LINK_TRACE_TOPIC frame to LINK_SERVICE_ADDRESS:
+ * RECORDS, DROPPED, TICKS (16-bit), then 5 bytes per record.
+ */
+void Trace_StreamTask(void)
+{
+	uint8 Block[TRACE_BLOCK_HEADER_SIZE + (TRACE_BLOCK_MAX_RECORDS * TRACE_RECORD_SIZE)];
+	const Trace_RecordType *Record_Ptr;
+	uint8 Available;
+	uint8 Length;
+	uint8 i;
+	uint16 Now;
+	uint8 SREG_Value;
+
+	/* The transmitter is still busy with another frame or a block waits for the turn, try again in the next idle loop */
+	if (BIT_IS_CLEAR(UCSRA, UDRE) || (Link_CanSend() == FALSE))
+	{
+		return;
+	}
+
+	/* Coarse time of the block, taken after the records to send were logged so it is never older than them */
+	Available = (g_traceHead - g_traceTail) & (TRACE_BUFFER_SIZE - 1);
+	Now = SysTick_GetTicks();
+
+	if ((Available == 0) && (SysTick_HasElapsed(g_traceLastBlockTime, TRACE_KEEP_ALIVE_MS) == FALSE))
+	{
+		/* Nothing to send */
+		return;
+	}
+
+	if (Available > TRACE_BLOCK_MAX_RECORDS)
+	{
+		Available = TRACE_BLOCK_MAX_RECORDS;
+	}
+
+	/* Copy the records in the block and release them, Trace_Log only writes at the head */
+	Length = TRACE_BLOCK_HEADER_SIZE;
+	for (i = 0; i < Available; i++)
+	{
+		Record_Ptr = &g_traceBuffer[g_traceTail];
+		Block[Length] = Record_Ptr -> Id;
+		Block[Length + 1] = (uint8)(Record_Ptr -> Arg);
+		Block[Length + 2] = (uint8)(Record_Ptr -> Arg >> 8);
+		Block[Length + 3] = (uint8)(Record_Ptr -> Time_Stamp);
+		Block[Length + 4] = (uint8)(Record_Ptr -> Time_Stamp >> 8);
+		Length += TRACE_RECORD_SIZE;
+		g_traceTail = (g_traceTail + 1) & (TRACE_BUFFER_SIZE - 1);
+	}
+
+	Block[0] = Available;
+
+	/* Read and clear the dropped counter in one step, Trace_Log may run from an ISR */
+	SREG_Value = SREG;
+	cli();
+	Block[1] = g_traceDropped;
+	g_traceDropped = 0;
+	SREG = SREG_Value;
+
+	Block[2] = (uint8)Now;
+	Block[3] = (uint8)(Now >> 8);
+
+	g_traceStreaming = TRUE;
+	Link_Send(LINK_SERVICE_ADDRESS, LINK_TRACE_TOPIC, Block, Length);
+	g_traceStreaming = FALSE;
+
+	g_traceLastBlockTime = Now;
+}
+
+#endif
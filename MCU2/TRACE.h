@@ -0,0 +1,104 @@
+/*****************************************************************************************************************
+ * File Name: TRACE.h
+ * Date: 19/10/2026
+ * Driver: Event Trace Recorder Header File
+ * Author: Youssef Zaki
+ ****************************************************************************************************************/
+#include "Standard_Types.h"
+
+#ifndef TRACE_H_
+#define TRACE_H_
+
+/******************************************************************************************
+ *                                    Macros Definitions                                  *
+ ******************************************************************************************/
+
+/*
+ * Set to 1 to build the trace recorder in. When it is 0, every TRACE_EVENT() and the stream
+ * task compile to nothing. A trace build sends the records as LINK_TRACE_TOPIC frames to the
+ * service PC (LINK_SERVICE_ADDRESS), so the capture adapter must be attached to the bus.
+ * The sensor node relays the blocks of the actuator nodes (LINK_FORWARD_TOPIC in LINK.h).
+ */
+#define TRACE_ENABLE                         0
+
+/* Number of records kept in RAM (must be a power of two), each record takes 5 bytes */
+#define TRACE_BUFFER_SIZE                    32
+
+/*
+ * Stream block, the payload of one LINK_TRACE_TOPIC frame (little endian):
+ * {RECORDS, DROPPED, TICKS (16-bit), RECORD[RECORDS]}, RECORD = {ID, ARG (16-bit), TIME_STAMP (16-bit)}
+ * TICKS is SysTick_GetTicks when the block is sent, the decoder places the fine time stamps of the
+ * records just before it. A block without records is sent at least every TRACE_KEEP_ALIVE_MS, so
+ * the decoder can follow the 16-bit TICKS through long quiet periods.
+ */
+#define TRACE_BLOCK_HEADER_SIZE              4
+#define TRACE_RECORD_SIZE                    5
+#define TRACE_BLOCK_MAX_RECORDS              2
+#define TRACE_KEEP_ALIVE_MS                  10000
+
+#if ((TRACE_BUFFER_SIZE & (TRACE_BUFFER_SIZE - 1)) != 0)
+
+#error "TRACE_BUFFER_SIZE should be a power of two"
+
+#endif
+
+/* ISR identifiers used as argument of TRACE_EVENT_ISR_ENTRY */
+#define TRACE_ISR_ADC                        0
+#define TRACE_ISR_TIMER1_OVF                 1
+#define TRACE_ISR_TIMER1_COMPA               2
+
+/******************************************************************************************
+ *                                     Types Declaration                                  *
+ ******************************************************************************************/
+
+typedef enum
+{
+	TRACE_EVENT_ISR_ENTRY,
+	TRACE_EVENT_UART_TX,
+	TRACE_EVENT_UART_RX,
+	TRACE_EVENT_ADC_SAMPLE,
+	TRACE_EVENT_STATE_CHANGE,
+	TRACE_EVENT_PWM_UPDATE,
+	TRACE_EVENT_LINK_STATE,
+	TRACE_EVENT_BOOT_DONE
+}Trace_EventId;
+
+/******************************************************************************************
+ *                                    Functions Prototypes                                *
+ ******************************************************************************************/
+
+#if (TRACE_ENABLE == 1)
+
+/* Record one event, it is safe to use from the application and from any ISR */
+#define TRACE_EVENT(ID, ARG)                 Trace_Log((ID), (ARG))
+
+/*
+ * Description:
+ * Clear the trace buffer, the SysTick must be initialized to have valid time stamps.
+ */
+void Trace_Init(void);
+
+/*
+ * Description:
+ * Store the event id, its argument and the SysTick fine time stamp in the RAM ring buffer.
+ * When the buffer is full, the record is dropped and counted.
+ */
+void Trace_Log(Trace_EventId Id, uint16 Arg);
+
+/*
+ * Description:
+ * Low priority task to be called from the idle loop of the application, the link must be initialized.
+ * When the UART transmitter is free and the link can take a frame, send one block of the waiting
+ * records (~23 ms at 9600 bps). An actuator node sends it in its next turn.
+ */
+void Trace_StreamTask(void);
+
+#else
+
+#define TRACE_EVENT(ID, ARG)                 ((void)0)
+#define Trace_Init()                         ((void)0)
+#define Trace_StreamTask()                   ((void)0)
+
+#endif
+
+#endif /* TRACE_H_ */
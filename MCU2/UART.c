@@ -6,8 +6,120 @@
  ****************************************************************************************************************/
 #include <avr/io.h>
 #include <avr/interrupt.h>
+#include <avr/pgmspace.h>
 #include "UART.h"
 #include "Common_Macros.h"
+#include "TRACE.h"
+#include "POWER.h"
+#include "SYSTICK.h"
+
+/* The saved status is taken from UCSRA directly, so the flags must keep the register positions */
+#if ((UART_STATUS_FRAME_ERROR != (1<<FE)) || (UART_STATUS_DATA_OVERRUN != (1<<DOR)) || (UART_STATUS_PARITY_ERROR != (1<<PE)))
+
+#error "UART_STATUS_xxx error flags do not match FE, DOR and PE bits of UCSRA"
+
+#endif
+
+/***************************************************************************************
+ *                                         Global Variables                            *
+ ***************************************************************************************/
+
+/* Receive ring buffer filled by the RXC interrupt */
+static volatile uint8 g_uartRxBuffer[UART_RX_BUFFER_SIZE];
+static volatile uint8 g_uartRxHead = 0;
+static volatile uint8 g_uartRxTail = 0;
+
+/* Status of every byte in the receive buffer: UART_STATUS_xxx error flags and the ninth bit */
+static volatile uint8 g_uartRxStatus[UART_RX_BUFFER_SIZE];
+
+/* Receive statistics updated by the RXC interrupt */
+static volatile UART_ErrorStatisticsType g_uartErrorStats;
+
+/* Own address in the Multi-processor Communication Mode */
+static volatile uint8 g_uartNodeAddress = UART_NO_ADDRESS;
+
+/***************************************************************************************
+ *                                  Interrupt Service Routines                         *
+ ***************************************************************************************/
+
+/*
+ * Receive Complete: move the byte from UDR to the ring buffer, drop it if the buffer is full.
+ * In the Multi-processor Communication Mode, address frames only select or deselect this node.
+ */
+ISR(USART_RXC_vect)
+{
+	/* The error flags and RXB8 belong to the character in UDR, so they must be read before UDR */
+	uint8 Status = UCSRA & UART_STATUS_ERRORS;
+	uint8 Bit8 = BIT_IS_SET(UCSRB, RXB8);
+	uint8 Byte = UDR;
+	uint8 Next_Head;
+
+	if (Bit8)
+	{
+		Status |= UART_STATUS_BIT8;
+	}
+
+	g_uartErrorStats.Received_Bytes++;
+
+	if (Status & UART_STATUS_FRAME_ERROR)
+	{
+		g_uartErrorStats.Frame_Errors++;
+	}
+	if (Status & UART_STATUS_DATA_OVERRUN)
+	{
+		g_uartErrorStats.Data_Overruns++;
+	}
+	if (Status & UART_STATUS_PARITY_ERROR)
+	{
+		g_uartErrorStats.Parity_Errors++;
+	}
+
+	if (g_uartNodeAddress != UART_NO_ADDRESS)
+	{
+		if (Bit8)
+		{
+			/* A corrupted address is never taken as ours */
+			if (((Status & UART_STATUS_ERRORS) == 0) && ((Byte == g_uartNodeAddress) || (Byte == UART_BROADCAST_ADDRESS)))
+			{
+				/* Addressed: receive the data frames which follow (TXC is written 0 to keep it) */
+				UCSRA = UCSRA & (1<<U2X);
+			}
+			else
+			{
+				/* Not for this node: let the hardware ignore the data frames */
+				UCSRA = (UCSRA & (1<<U2X)) | (1<<MPCM);
+				return;
+			}
+		}
+	}
+
+#if (UART_RX_ERROR_POLICY == UART_RX_ERROR_DROP)
+	if (Status & UART_STATUS_ERRORS)
+	{
+		/* Counted above, never reaches the receive buffer */
+		return;
+	}
+#endif
+
+	Next_Head = (g_uartRxHead + 1) & (UART_RX_BUFFER_SIZE - 1);
+
+	if (Next_Head != g_uartRxTail)
+	{
+		g_uartRxBuffer[g_uartRxHead] = Byte;
+		g_uartRxStatus[g_uartRxHead] = Status;
+		g_uartRxHead = Next_Head;
+	}
+	else
+	{
+		g_uartErrorStats.Buffer_Overflows++;
+	}
+}
+
+/* Data Register Empty: only used to wake up UART_SendByte, so disable it after it fires once */
+ISR(USART_UDRE_vect)
+{
+	CLEAR_BIT(UCSRB, UDRIE);
+}
 
 /****************************************************************************************
  *                                     Functions Definitions                            *
@@ -17,9 +129,9 @@
  * Description:
  * 1. To write in UCRSC Register, so the URSEL bit must be Set.
  * 2. Enable RXEN or TXEN according to device to be receiver or transmitter respectively.
- * 3. Enable RXCIE or TXCIE according to device to be receiver or transmitter respectively (for interrupt enable)
+ * 3. Enable RXCIE to fill the receive ring buffer by interrupt, so the Global Interrupt must be enabled.
  * 4. Select the Mode of the UART to be Asynchronous or Synchronous
- * 5. Based of the mode to be Asynchronous or Synchronous, Choose the Speed and Baud Rate.
+ * 5. Based of the mode to be Asynchronous or Synchronous, load the UBRR (and U2X) computed at compile time for UART_BAUD_RATE.
  * 6. from UPM1:0 bits in UCSRC Register, configure the parity mode.
  * 7. from USBS bit in UCSRC Register, Select the number of stop bits to be one or two.
  * 8. from UCSZ2 in UCSRB and from USCZ1:0 in UCSRC bits, select the character size.
@@ -33,6 +145,20 @@ void UART_Init(const UART_ConfigType *Config_Ptr)
 	SET_BIT(UCSRB, RXEN);
 	/* Let the device as a transmitter by enable TXEN bit */
 	SET_BIT(UCSRB, TXEN);
+	/* Enable the Receive Complete interrupt to fill the receive buffer */
+	g_uartRxHead = 0;
+	g_uartRxTail = 0;
+	SET_BIT(UCSRB, RXCIE);
+
+	g_uartErrorStats.Received_Bytes = 0;
+	g_uartErrorStats.Frame_Errors = 0;
+	g_uartErrorStats.Data_Overruns = 0;
+	g_uartErrorStats.Parity_Errors = 0;
+	g_uartErrorStats.Buffer_Overflows = 0;
+
+	/* No address filtering until UART_SetNodeAddress is called */
+	g_uartNodeAddress = UART_NO_ADDRESS;
+	UCSRA = UCSRA & (1<<U2X);
 
 	if (Config_Ptr -> Mode == Asynchronous)
 	{
@@ -40,23 +166,20 @@ void UART_Init(const UART_ConfigType *Config_Ptr)
 		 * UMSEL = 0 -> Asynchronous Operation
 		 * UCPOL = 0 -> Used for Synchronous Only
 		 */
-		if (Config_Ptr -> Speed == Normal)
-		{
-			/* U2X = 0 -> Normal Speed Mode */
-			UBRR_Value = (uint16)(((F_CPU / (Config_Ptr -> Baud_Rate * 16UL))) - 1);
-		}
-		else if (Config_Ptr -> Speed == Double_Speed)
-		{
-			/* U2X = 1 -> Double Speed Mode */
-			SET_BIT(UCSRA, U2X);
-			UBRR_Value = (uint16)(((F_CPU / (Config_Ptr -> Baud_Rate * 8UL))) - 1);
-		}
+#if (UART_USE_2X == 1)
+		/* U2X = 1 -> Double Speed Mode */
+		UCSRA = (UCSRA & (1<<MPCM)) | (1<<U2X);
+#else
+		/* U2X = 0 -> Normal Speed Mode */
+		UCSRA = UCSRA & (1<<MPCM);
+#endif
+		UBRR_Value = UART_UBRR_VALUE;
 	}
 	else if (Config_Ptr -> Mode == Synchronous)
 	{
 		/* UMSEL = 1 -> Synchronous Operation */
 		SET_BIT(UCSRC, UMSEL);
-		UBRR_Value = (uint16)(((F_CPU / (Config_Ptr -> Baud_Rate * 2UL))) - 1);
+		UBRR_Value = UART_UBRR_SYNCHRONOUS;
 	}
 	else
 	{
@@ -135,31 +258,256 @@ void UART_Init(const UART_ConfigType *Config_Ptr)
 	}
 }
 
+/*
+ * Description:
+ * Enable the Multi-processor Communication Mode, the frame size must be Nine_Bit_7.
+ * 1. Frames with the ninth bit set are addresses, frames with the ninth bit cleared are data.
+ * 2. The MPCM bit is set, so the hardware ignores all data frames until an address frame is received.
+ * 3. The RXC interrupt compares the address with Address and UART_BROADCAST_ADDRESS, if it matches
+ *    the MPCM bit is cleared to receive the following data frames, otherwise it stays set.
+ * 4. The addresses of this node (and broadcasts) are put in the receive buffer with UART_STATUS_BIT8,
+ *    so the reader knows where a new frame starts. The other address frames are not.
+ */
+void UART_SetNodeAddress(uint8 Address)
+{
+	uint8 SREG_Value = SREG;
+
+	cli();
+	g_uartNodeAddress = Address;
+	UCSRA = (UCSRA & (1<<U2X)) | (1<<MPCM);
+	SREG = SREG_Value;
+}
+
+/*
+ * Description:
+ * Function to Send 9-bit character to the another device, the frame size must be Nine_Bit_7.
+ * 1. Wait in Idle sleep until the Tx Buffer is empty like UART_SendByte.
+ * 2. The ninth bit is written to TXB8 before the low 8 bits are written to UDR Register.
+ * 3. TXC is cleared and UDR is loaded with the interrupts disabled, so the MPCM bit written by the
+ *    RXC interrupt (address filter) is never overwritten with its old value.
+ */
+void UART_SendNineBit(uint16 Data)
+{
+	uint8 SREG_Value = SREG;
+
+	cli();
+	while BIT_IS_CLEAR(UCSRA,UDRE)
+	{
+		SET_BIT(UCSRB, UDRIE);
+		Power_Sleep(POWER_IDLE);
+	}
+
+	if (Data & 0x0100)
+	{
+		SET_BIT(UCSRB, TXB8);
+	}
+	else
+	{
+		CLEAR_BIT(UCSRB, TXB8);
+	}
+
+	/* The RXC interrupt writes MPCM, so UCSRA is read and written back with the interrupts still disabled */
+	UCSRA = (UCSRA & ((1<<U2X) | (1<<MPCM))) | (1<<TXC);
+	UDR = (uint8)Data;
+	SREG = SREG_Value;
+
+	TRACE_EVENT(TRACE_EVENT_UART_TX, Data);
+}
+
+/*
+ * Description:
+ * Send an address frame (ninth bit set) to select the receiving node, the frame size must be Nine_Bit_7.
+ */
+void UART_SendAddress(uint8 Address)
+{
+	UART_SendNineBit(0x0100 | Address);
+}
+
 /*
  * Description:
  * Function to Send byte to the another device.
  * 1. The UDRE is the flag which be set automatically when the Tx Buffer is empty and ready to send new byte.
- * 2. We wait until the buffer is empty, and flag is set to one.
- * 3. The required data is put in UDR Register and consequently, the UDRE flag is cleared while writing.
+ * 2. We wait in Idle sleep until the buffer is empty, the UDRE interrupt wakes the CPU up.
+ * 3. TXC flag is cleared by writing '1', so it tells later when the byte has completely left the shift register.
+ * 4. The required data is put in UDR Register and consequently, the UDRE flag is cleared while writing.
+ * In 9-bit frames the ninth bit is sent cleared, so the byte is a data frame.
  */
 void UART_SendByte(uint8 Byte)
 {
-	while BIT_IS_CLEAR(UCSRA,UDRE);
-	UDR = Byte;
+	UART_SendNineBit(Byte);
 }
 
 /*
  * Description:
  * Function to receive byte from the another device.
- * 1. RXC bit is set automatically when the received buffer Rx hasn't any unread data.
- * 2. We wait until the all data is read.
- * 3. Then, we can read the received data from the Rx buffer through UDR Register.
- * 4. After read the data, the RXC flag will be cleared.
+ * 1. The RXC interrupt moves every received byte from UDR Register to the receive ring buffer.
+ * 2. We wait in Idle sleep until the buffer has a byte, any interrupt wakes the CPU up to check again.
+ * 3. Then, we read the oldest received byte from the ring buffer.
  */
 uint8 UART_ReceiveByte(void)
 {
-	while BIT_IS_CLEAR(UCSRA,RXC);
-	return UDR;
+	uint8 Byte;
+	uint8 SREG_Value = SREG;
+
+	cli();
+	while (g_uartRxHead == g_uartRxTail)
+	{
+		Power_Sleep(POWER_IDLE);
+	}
+	Byte = g_uartRxBuffer[g_uartRxTail];
+	g_uartRxTail = (g_uartRxTail + 1) & (UART_RX_BUFFER_SIZE - 1);
+	SREG = SREG_Value;
+
+	TRACE_EVENT(TRACE_EVENT_UART_RX, Byte);
+
+	return Byte;
+}
+
+/*
+ * Description:
+ * Function to receive byte with a time limit.
+ * Same as UART_ReceiveByte, but the wait ends after Timeout_Ms milliseconds of the SysTick.
+ * Return TRUE and the byte in Byte_Ptr, or FALSE if no byte was received in time.
+ */
+boolean UART_ReceiveByteTimeout(uint8 *Byte_Ptr, uint16 Timeout_Ms)
+{
+	uint16 Start = SysTick_GetTicks();
+	uint8 SREG_Value = SREG;
+
+	cli();
+	while (g_uartRxHead == g_uartRxTail)
+	{
+		if (SysTick_HasElapsed(Start, Timeout_Ms))
+		{
+			SREG = SREG_Value;
+			return FALSE;
+		}
+
+		/* The SysTick interrupt wakes the CPU up every tick to check the time again */
+		Power_Sleep(POWER_IDLE);
+	}
+	*Byte_Ptr = g_uartRxBuffer[g_uartRxTail];
+	g_uartRxTail = (g_uartRxTail + 1) & (UART_RX_BUFFER_SIZE - 1);
+	SREG = SREG_Value;
+
+	TRACE_EVENT(TRACE_EVENT_UART_RX, *Byte_Ptr);
+
+	return TRUE;
+}
+
+/*
+ * Description:
+ * Function to receive 9-bit character from the another device.
+ * Same as UART_ReceiveByte, but the ninth bit saved by the RXC interrupt is returned in bit 8.
+ */
+uint16 UART_ReceiveNineBit(void)
+{
+	uint16 Data;
+	uint8 SREG_Value = SREG;
+
+	cli();
+	while (g_uartRxHead == g_uartRxTail)
+	{
+		Power_Sleep(POWER_IDLE);
+	}
+	Data = g_uartRxBuffer[g_uartRxTail];
+	if (g_uartRxStatus[g_uartRxTail] & UART_STATUS_BIT8)
+	{
+		Data |= 0x0100;
+	}
+	g_uartRxTail = (g_uartRxTail + 1) & (UART_RX_BUFFER_SIZE - 1);
+	SREG = SREG_Value;
+
+	TRACE_EVENT(TRACE_EVENT_UART_RX, Data);
+
+	return Data;
+}
+
+/*
+ * Description:
+ * Function to receive byte without waiting.
+ * If the receive buffer has a byte, it is copied to Byte_Ptr and the function returns TRUE,
+ * otherwise the function returns FALSE immediately.
+ */
+boolean UART_TryReceiveByte(uint8 *Byte_Ptr)
+{
+	/* Only the main loop moves the tail, so the head can be compared without disabling interrupts */
+	if (g_uartRxHead == g_uartRxTail)
+	{
+		return FALSE;
+	}
+
+	*Byte_Ptr = g_uartRxBuffer[g_uartRxTail];
+	g_uartRxTail = (g_uartRxTail + 1) & (UART_RX_BUFFER_SIZE - 1);
+
+	TRACE_EVENT(TRACE_EVENT_UART_RX, *Byte_Ptr);
+
+	return TRUE;
+}
+
+/*
+ * Description:
+ * Return the status saved with the oldest byte in the receive buffer without removing it:
+ * UART_STATUS_FRAME_ERROR, UART_STATUS_DATA_OVERRUN, UART_STATUS_PARITY_ERROR and UART_STATUS_BIT8.
+ * Return 0 if the buffer is empty.
+ */
+uint8 UART_GetRxStatus(void)
+{
+	if (g_uartRxHead == g_uartRxTail)
+	{
+		return 0;
+	}
+
+	return g_uartRxStatus[g_uartRxTail];
+}
+
+/*
+ * Description:
+ * Return the number of received bytes waiting in the receive buffer.
+ */
+uint8 UART_Available(void)
+{
+	return (g_uartRxHead - g_uartRxTail) & (UART_RX_BUFFER_SIZE - 1);
+}
+
+/*
+ * Description:
+ * Give a pointer to the oldest received bytes inside the receive buffer without copying them.
+ * Return the number of bytes which can be read in a row from Data_Ptr (the part before the
+ * buffer wraps around or before the first byte received with an error or the ninth bit), 0 if the
+ * buffer is empty or the oldest byte has an error or the ninth bit (check UART_GetRxStatus). The bytes stay in the buffer until
+ * UART_Consume is called, the RXC interrupt only writes after them.
+ */
+uint8 UART_Peek(const uint8 **Data_Ptr)
+{
+	uint8 Head = g_uartRxHead;
+	uint8 Tail = g_uartRxTail;
+	uint8 Count = 0;
+
+	/* The bytes between the tail and the head are not touched by the interrupt anymore */
+	*Data_Ptr = (const uint8 *)&g_uartRxBuffer[Tail];
+
+	while ((Tail != Head) && ((g_uartRxStatus[Tail] & (UART_STATUS_ERRORS | UART_STATUS_BIT8)) == 0))
+	{
+		Count++;
+		Tail++;
+		if (Tail == UART_RX_BUFFER_SIZE)
+		{
+			/* Stop at the end of the buffer, the rest is given by the next call */
+			break;
+		}
+	}
+
+	return Count;
+}
+
+/*
+ * Description:
+ * Release Count bytes given by UART_Peek, so the RXC interrupt can use their place again.
+ */
+void UART_Consume(uint8 Count)
+{
+	g_uartRxTail = (g_uartRxTail + Count) & (UART_RX_BUFFER_SIZE - 1);
 }
 
 /*
@@ -168,35 +516,108 @@ uint8 UART_ReceiveByte(void)
  */
 void UART_SendString(const uint8 *Str)
 {
-	uint8 i = 0;
+	/* Send the whole string */
+	while(*Str != '\0')
+	{
+		UART_SendByte(*Str);
+		Str++;
+	}
+}
+
+/*
+ * Description:
+ * Function to send string stored in the flash memory (PROGMEM / PSTR) to the another device.
+ * The characters are read with pgm_read_byte, so the string takes no RAM.
+ */
+void UART_SendString_P(const char *Str)
+{
+	uint8 Character = pgm_read_byte(Str);
 
 	/* Send the whole string */
-	while(Str[i] != '\0')
+	while(Character != '\0')
 	{
-		UART_SendByte(Str[i]);
-		i++;
+		UART_SendByte(Character);
+		Str++;
+		Character = pgm_read_byte(Str);
 	}
 }
 
 /*
- * Function to receive String from the another device.
+ * Description:
+ * Function to send Length bytes from Data_Ptr to the another device, the data may contain '\0'.
+ */
+void UART_SendBuffer(const uint8 *Data_Ptr, uint16 Length)
+{
+	while (Length != 0)
+	{
+		UART_SendByte(*Data_Ptr);
+		Data_Ptr++;
+		Length--;
+	}
+}
+
+/*
+ * Description:
+ * Function to receive String from the another device into a buffer of Size bytes.
  * 1. Receive the required string until the '#' symbol through UART from the other UART device.
- * 2. when the receiving process is finished, we should re-assign the last character to '\0' to read the actual data.
+ * 2. At most Size - 1 characters are saved, the rest of a too long string is received and dropped.
+ * 3. The '#' is replaced with '\0' to read the actual data.
+ * Return the number of saved characters (without the '\0').
  */
-void UART_ReceiveString(uint8 *Str)
+uint8 UART_ReceiveString(uint8 *Str, uint8 Size)
 {
 	uint8 i = 0;
+	uint8 Byte;
 
-	/* Receive the first byte */
-	Str[i] = UART_ReceiveByte();
+	if (Size == 0)
+	{
+		return 0;
+	}
 
 	/* Receive the whole string until the '#' */
-	while(Str[i] != '#')
+	Byte = UART_ReceiveByte();
+	while(Byte != '#')
 	{
-		i++;
-		Str[i] = UART_ReceiveByte();
+		if (i < (Size - 1))
+		{
+			Str[i] = Byte;
+			i++;
+		}
+		Byte = UART_ReceiveByte();
 	}
 
-	/* After receiving the whole string plus the '#', replace the '#' with '\0' */
+	/* After receiving the whole string plus the '#', terminate it with '\0' */
 	Str[i] = '\0';
+
+	return i;
+}
+
+/*
+ * Description:
+ * Function to receive up to Size bytes into Buffer_Ptr, waiting at most Timeout_Ms for every byte.
+ * Return the number of received bytes, less than Size if the other device stopped sending.
+ */
+uint8 UART_ReceiveBuffer(uint8 *Buffer_Ptr, uint8 Size, uint16 Timeout_Ms)
+{
+	uint8 Count = 0;
+
+	while ((Count < Size) && UART_ReceiveByteTimeout(&Buffer_Ptr[Count], Timeout_Ms))
+	{
+		Count++;
+	}
+
+	return Count;
+}
+
+/*
+ * Description:
+ * Copy the receive statistics, the copy is taken with interrupts disabled.
+ */
+void UART_GetErrorStatistics(UART_ErrorStatisticsType *Stats_Ptr)
+{
+	uint8 SREG_Value = SREG;
+
+	cli();
+	*Stats_Ptr = *(const UART_ErrorStatisticsType *)&g_uartErrorStats;
+	SREG = SREG_Value;
 }
@@ -0,0 +1,75 @@
+/*******************************************************************************************************************
+ * File Name: WDG.c
+ * Date: 19/10/2026
+ * Driver: ATmega32 Watchdog Timer Driver Source File
+ * Author: Youssef Zaki
+ ******************************************************************************************************************/
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/wdt.h>
+#include "WDG.h"
+
+#if ((WDG_RESET_POWER_ON != (1<<PORF)) || (WDG_RESET_EXTERNAL != (1<<EXTRF)) || (WDG_RESET_BROWN_OUT != (1<<BORF)) || \
+	(WDG_RESET_WATCHDOG != (1<<WDRF)) || (WDG_RESET_JTAG != (1<<JTRF)))
+
+#error "WDG_RESET_xxx flags do not match the reset flags of MCUCSR"
+
+#endif
+
+/****************************************************************************************
+ *                                     Functions Definitions                            *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Function to start the Watchdog Timer.
+ * 1. Reset the watchdog counter, so the first time-out is complete.
+ * 2. Select the time-out by WDP2:0 bits and set WDE bit in WDTCR Register.
+ * The MCU is reset when WDG_Refresh is not called within the time-out.
+ */
+void WDG_Enable(WDG_TimeoutType Timeout)
+{
+	wdt_reset();
+
+	WDTCR = (1<<WDE) | (Timeout & 0x07);
+}
+
+/*
+ * Description:
+ * Function to stop the Watchdog Timer with the timed sequence (WDTOE and WDE, then WDE = 0 within 4 cycles).
+ */
+void WDG_Disable(void)
+{
+	uint8 SREG_Value = SREG;
+
+	/* An interrupt between the two writes would break the 4 cycles sequence */
+	cli();
+	wdt_reset();
+	WDTCR = (1<<WDTOE) | (1<<WDE);
+	WDTCR = 0;
+	SREG = SREG_Value;
+}
+
+/*
+ * Description:
+ * Reset the watchdog counter (WDR instruction).
+ */
+void WDG_Refresh(void)
+{
+	wdt_reset();
+}
+
+/*
+ * Description:
+ * Return the reset flags of MCUCSR Register (WDG_RESET_xxx) and clear them,
+ * so the cause of the next reset is not mixed with this one. Call it once at startup.
+ */
+uint8 WDG_GetResetCause(void)
+{
+	uint8 Cause = MCUCSR & WDG_RESET_FLAGS;
+
+	/* The flags are cleared by writing zero, keep the other bits (JTD, ISC2) */
+	MCUCSR &= ~WDG_RESET_FLAGS;
+
+	return Cause;
+}
@@ -0,0 +1,564 @@
+/*******************************************************************************************************************
+ * File Name: Fuzz_Link.c
+ * Date: 19/10/2026
+ * Driver: Fuzz Target of the Link Receive Path and the MCU2 Dispatcher (libFuzzer)
+ * Author: Youssef Zaki
+ ******************************************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <avr/interrupt.h>
+#include "Mock.h"
+#include "GPIO.h"
+#include "UART.h"
+#include "TIMER1.h"
+#include "DC_Motor.h"
+#include "HYSTERESIS.h"
+#include "LINK.h"
+#include "CONFIG.h"
+#include "EEPROM.h"
+
+/*
+ * The input is a list of received characters, 2 bytes each {CONTROL, DATA}:
+ * CONTROL bit 0    -> ninth bit (address character)
+ * CONTROL bits 1:3 -> PE, DOR and FE flags of the character
+ * CONTROL bit 4    -> run one cycle of the node (Link_Poll and the dispatcher) after the character
+ * CONTROL bits 5:7 -> move the SysTick forward by this number of 100 ms after the character
+ * The first 2 bytes of the input are the potentiometer value of the node.
+ * A cycle is run at the end of the input, every cycle checks the outputs of the node.
+ */
+#define FUZZ_CONTROL_BIT8                    0x01
+#define FUZZ_CONTROL_ERRORS_SHIFT            1
+#define FUZZ_CONTROL_ERRORS_MASK             0x07
+#define FUZZ_CONTROL_CYCLE                   0x10
+#define FUZZ_CONTROL_TICKS_SHIFT             5
+#define FUZZ_TICKS_STEP_MS                   100
+
+/* Longer inputs are cut, the node sends at most one reply per received frame */
+#define FUZZ_MAX_INPUT                       1024
+
+/* The speeds of MCU2 are ADC values */
+#define FUZZ_MAX_SPEED                       1023
+
+/* EEPROM writes allowed to end a configuration save, more means the save never ends */
+#define FUZZ_MAX_EEPROM_STEPS                256
+
+/* Standalone build (no libFuzzer): number and size of the generated inputs */
+#define FUZZ_RANDOM_RUNS                     2000
+#define FUZZ_RANDOM_MAX_FRAMES               24
+
+/* A failed check stops the program, so the fuzzer keeps the input */
+#define FUZZ_CHECK(CONDITION)                Fuzz_Check((CONDITION) ? TRUE : FALSE, #CONDITION, __LINE__)
+
+/* LEDs of MCU2 on PORTD: Green, Yellow, Red */
+#define FUZZ_LED_MASK                        ((1<<PIN2_ID) | (1<<PIN3_ID) | (1<<PIN4_ID))
+
+/***************************************************************************************
+ *                                         Global Variables                            *
+ ***************************************************************************************/
+
+static const UART_ConfigType g_uartConfig = {Asynchronous, Disabled, One_Bit, Nine_Bit_7};
+static const Timer1_ConfigType g_timer1Config = {0, 0, TIMER1_Prescaler_8, TIMER1_Fast_Pwm_10_Bit_7};
+
+/* Publishing rules of MCU2 */
+static const Link_TopicConfigType g_linkTopics[LINK_NUM_OF_TOPICS] =
+{
+	{LINK_BROADCAST_ADDRESS,   1, 1000,                     LINK_MAX_TEMPERATURE},   /* LINK_TOPIC_TEMPERATURE */
+	{LINK_BROADCAST_ADDRESS,   1, 1000,                     LOGIC_HIGH},             /* LINK_TOPIC_EMERGENCY   */
+	{LINK_SENSOR_NODE_ADDRESS, 1, 1000,                     0xFF},                   /* LINK_TOPIC_FAN_STATE   */
+	{LINK_SENSOR_NODE_ADDRESS, 1, LINK_HEARTBEAT_PERIOD_MS, LINK_UP}                 /* LINK_TOPIC_HEARTBEAT   */
+};
+
+static const Link_ConfigType g_linkConfig = {LINK_ACTUATOR_BASE_ADDRESS, g_linkTopics, 0};
+
+/* Register of every port ID */
+static const Mock_RegisterId g_fuzzPorts[NUM_OF_PORTS] = {MOCK_PORTA, MOCK_PORTB, MOCK_PORTC, MOCK_PORTD};
+
+/* Dispatcher of MCU2: LED zones, emergency state of the sensor node and potentiometer */
+static Hysteresis_ConfigType g_ledZoneConfig = {&CONFIG_VALUE(CONFIG_LED_YELLOW_TEMPERATURE), 2, 0, 0};
+static Hysteresis_Type g_ledZone;
+static uint8 g_sensorEmergency;
+static uint16 g_potentiometer;
+
+/***************************************************************************************
+ *                                      Private Functions                              *
+ ***************************************************************************************/
+
+static void Fuzz_Check(boolean Passed, const char *Text, int Line)
+{
+	if (Passed == FALSE)
+	{
+		fprintf(stderr, "Fuzz_Link.c:%d: check failed: %s\n", Line, Text);
+		abort();
+	}
+}
+
+/* EEPROM hardware: a started write ends, then the EE_RDY interrupt fires while it is enabled */
+static void Fuzz_Hardware(void)
+{
+	uint8 Eecr = (uint8)Mock_Get(MOCK_EECR);
+
+	if (Eecr & (1<<EEWE))
+	{
+		Mock_Set(MOCK_EECR, Eecr & ~((1<<EEWE) | (1<<EEMWE) | (1<<EERE)));
+	}
+	else if (Eecr & (1<<EERIE))
+	{
+		EE_RDY_vect();
+	}
+}
+
+/* Receiver hardware (see Test_UART.c): in the Multi-processor Communication Mode the data frames are ignored */
+static void Fuzz_ReceiveCharacter(uint16 Data, uint8 Errors)
+{
+	uint8 Ucsra = (uint8)Mock_Get(MOCK_UCSRA);
+	uint8 Ucsrb = (uint8)Mock_Get(MOCK_UCSRB);
+
+	if ((Ucsra & (1<<MPCM)) && ((Data & 0x0100) == 0))
+	{
+		return;
+	}
+
+	Mock_Set(MOCK_UCSRA, (Ucsra & ~UART_STATUS_ERRORS) | Errors | (1<<RXC));
+	Mock_Set(MOCK_UCSRB, (Data & 0x0100) ? (Ucsrb | (1<<RXB8)) : (Ucsrb & ~(1<<RXB8)));
+	Mock_Set(MOCK_UDR, (uint8)Data);
+
+	USART_RXC_vect();
+
+	Ucsra = (uint8)Mock_Get(MOCK_UCSRA);
+	Mock_Set(MOCK_UCSRA, Ucsra & ~(UART_STATUS_ERRORS | (1<<RXC)));
+}
+
+/* Same as MCU2_ApplyConfig */
+static void Fuzz_ApplyConfig(void)
+{
+	g_ledZoneConfig.Band = CONFIG_VALUE(CONFIG_LED_HYSTERESIS);
+	g_ledZoneConfig.Confirm_Samples = CONFIG_VALUE(CONFIG_CONFIRM_SAMPLES);
+}
+
+/* Same as MCU2_LinkHandler and the entry of the SAFE state */
+static void Fuzz_LinkHandler(uint8 Source, Link_TopicId Topic, uint16 Value)
+{
+	if ((Topic == LINK_TOPIC_EMERGENCY) && (Source == LINK_SENSOR_NODE_ADDRESS))
+	{
+		g_sensorEmergency = (uint8)Value;
+		if (Value == LOGIC_HIGH)
+		{
+			DcMotor_Rotate(CW, CONFIG_VALUE(CONFIG_EMERGENCY_SPEED));
+		}
+	}
+}
+
+/* Same as MCU2_CommandHandler (the awake duty is not measured here) */
+static void Fuzz_CommandHandler(uint8 Source, const uint8 *Payload_Ptr, uint8 Length)
+{
+	Config_HandleCommand(Source, Payload_Ptr, Length);
+}
+
+/* Only the LED of the zone is on, like the entries of the LED states of MCU2 */
+static void Fuzz_ShowZone(uint8 Zone)
+{
+	GPIO_WritePin(PORTD_ID, PIN2_ID, (Zone == 0) ? LOGIC_HIGH : LOGIC_LOW);
+	GPIO_WritePin(PORTD_ID, PIN3_ID, (Zone == 1) ? LOGIC_HIGH : LOGIC_LOW);
+	GPIO_WritePin(PORTD_ID, PIN4_ID, (Zone == 2) ? LOGIC_HIGH : LOGIC_LOW);
+}
+
+/* The outputs of the node must stay valid whatever was received */
+static void Fuzz_CheckOutputs(void)
+{
+	uint8 In1 = (Mock_Get(g_fuzzPorts[DC_MOTOR_IN1_PORT_ID]) >> DC_MOTOR_IN1_PIN_ID) & 1;
+	uint8 In2 = (Mock_Get(g_fuzzPorts[DC_MOTOR_IN2_PORT_ID]) >> DC_MOTOR_IN2_PIN_ID) & 1;
+	uint8 Leds = (uint8)Mock_Get(MOCK_PORTD) & FUZZ_LED_MASK;
+	Link_TopicId Topic;
+	Link_ZonesType Zones;
+	uint16 Value;
+
+	/* Motor: a speed of MCU2 and never both driver inputs high (short circuit of the H-bridge) */
+	FUZZ_CHECK(Mock_Get(MOCK_OCR1A) <= DC_MOTOR_PWM_TOP);
+	FUZZ_CHECK(Mock_Get(MOCK_OCR1A) <= FUZZ_MAX_SPEED);
+	FUZZ_CHECK((In1 & In2) == 0);
+
+	/* LEDs: all off or one on */
+	FUZZ_CHECK((Leds & (Leds - 1)) == 0);
+
+	/* Cache: only values in the range of their topic */
+	for (Topic = 0; Topic < LINK_NUM_OF_TOPICS; Topic++)
+	{
+		if (Link_GetValue(Topic, &Value) == TRUE)
+		{
+			FUZZ_CHECK(Value <= g_linkTopics[Topic].Max_Value);
+		}
+	}
+
+	if (Link_GetZones(&Zones) == TRUE)
+	{
+		FUZZ_CHECK(Zones.Num_Of_Zones <= LINK_MAX_ZONES);
+		FUZZ_CHECK(Zones.Max_Zone < Zones.Num_Of_Zones);
+		FUZZ_CHECK((Zones.Max / 10) <= LINK_MAX_TEMPERATURE);
+	}
+
+	/* Configuration changed over the link: still a valid one */
+	FUZZ_CHECK(CONFIG_VALUE(CONFIG_EMERGENCY_SPEED) <= FUZZ_MAX_SPEED);
+	FUZZ_CHECK(CONFIG_VALUE(CONFIG_LED_YELLOW_TEMPERATURE) < CONFIG_VALUE(CONFIG_LED_RED_TEMPERATURE));
+	FUZZ_CHECK(CONFIG_VALUE(CONFIG_CONFIRM_SAMPLES) != 0);
+
+	FUZZ_CHECK(UART_Available() < UART_RX_BUFFER_SIZE);
+}
+
+/* One cycle of the MCU2 application */
+static void Fuzz_Cycle(void)
+{
+	uint16 Temperature;
+	uint16 Emergency;
+	uint16 Speed;
+
+	Link_Poll();
+
+	/* Link_Poll reads the whole receive buffer without waiting */
+	FUZZ_CHECK(UART_Available() == 0);
+
+	if ((Link_GetValue(LINK_TOPIC_TEMPERATURE, &Temperature) == TRUE) && Hysteresis_Update(&g_ledZone, Temperature))
+	{
+		Fuzz_ShowZone(Hysteresis_GetLevel(&g_ledZone));
+	}
+
+	if ((Link_GetState() != LINK_UP) ||
+		((Link_GetValue(LINK_TOPIC_EMERGENCY, &Emergency) == TRUE) && (g_sensorEmergency == LOGIC_HIGH)))
+	{
+		Speed = CONFIG_VALUE(CONFIG_EMERGENCY_SPEED);
+	}
+	else
+	{
+		Speed = g_potentiometer;
+	}
+	DcMotor_Rotate(CW, Speed);
+
+	Link_Publish(LINK_TOPIC_FAN_STATE, (Speed >= CONFIG_VALUE(CONFIG_FAN_SPEED_THRESHOLD)) ? CONFIG_VALUE(CONFIG_FAN_ON_CODE) : 0);
+
+	Config_Task();
+
+	Fuzz_CheckOutputs();
+
+	/* The register writes are not checked, keep the log short */
+	Mock_ClearLog();
+}
+
+/* Finish a configuration save started by the input, so the next input starts from an idle EEPROM */
+static void Fuzz_EndEepromWrites(void)
+{
+	uint16 Steps = 0;
+
+	do
+	{
+		Config_Task();
+		Fuzz_Hardware();
+		Steps++;
+		FUZZ_CHECK(Steps < FUZZ_MAX_EEPROM_STEPS);
+	}
+	while (EEPROM_IsBusy() == TRUE);
+}
+
+/* Boot of MCU2 without the blocking EEPROM read: defaults, motor, LEDs and link */
+static void Fuzz_Boot(void)
+{
+	Mock_Reset();
+	Mock_SetSleepHook(Fuzz_Hardware);
+
+	Config_RestoreDefaults();
+	Fuzz_ApplyConfig();
+	Config_SetCallBack(Fuzz_ApplyConfig);
+
+	Timer1_PWM_Mode_Init(&g_timer1Config);
+	DcMotor_Init();
+	DcMotor_Rotate(CW, CONFIG_VALUE(CONFIG_EMERGENCY_SPEED));
+
+	UART_Init(&g_uartConfig);
+
+	GPIO_SetupPinDirection(PORTD_ID, PIN2_ID, OUTPUT_PIN);
+	GPIO_SetupPinDirection(PORTD_ID, PIN3_ID, OUTPUT_PIN);
+	GPIO_SetupPinDirection(PORTD_ID, PIN4_ID, OUTPUT_PIN);
+
+	Hysteresis_Init(&g_ledZone, &g_ledZoneConfig);
+	g_sensorEmergency = LOGIC_LOW;
+
+	Link_Init(&g_linkConfig);
+	Link_SetCallBack(Fuzz_LinkHandler);
+	Link_SetCommandCallBack(Fuzz_CommandHandler);
+
+	Mock_ClearLog();
+}
+
+/****************************************************************************************
+ *                                     Functions Definitions                            *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Entry point of libFuzzer: boot the node, give it the characters of the input and check its
+ * outputs after every cycle. A wait which never ends is stopped by the sleep limit of the mock.
+ */
+int LLVMFuzzerTestOneInput(const uint8_t *Data, size_t Size)
+{
+	size_t i;
+	uint8 Control;
+
+	if (Size > FUZZ_MAX_INPUT)
+	{
+		Size = FUZZ_MAX_INPUT;
+	}
+
+	Fuzz_Boot();
+
+	if (Size >= 2)
+	{
+		g_potentiometer = (uint16)(Data[0] | (Data[1] << 8)) & FUZZ_MAX_SPEED;
+	}
+	else
+	{
+		g_potentiometer = 0;
+	}
+
+	for (i = 2; (i + 1) < Size; i += 2)
+	{
+		Control = Data[i];
+
+		Fuzz_ReceiveCharacter(((Control & FUZZ_CONTROL_BIT8) ? 0x0100 : 0) | Data[i + 1],
+				((Control >> FUZZ_CONTROL_ERRORS_SHIFT) & FUZZ_CONTROL_ERRORS_MASK) << PE);
+		Fuzz_Hardware();
+
+		if (Control & FUZZ_CONTROL_CYCLE)
+		{
+			Fuzz_Cycle();
+		}
+
+		Mock_AdvanceTicks((Control >> FUZZ_CONTROL_TICKS_SHIFT) * FUZZ_TICKS_STEP_MS);
+	}
+
+	Fuzz_Cycle();
+	Fuzz_EndEepromWrites();
+
+	return 0;
+}
+
+#ifndef FUZZ_LIBFUZZER
+
+/*******************************************************************************
+ *                   Standalone Driver (without libFuzzer)                      *
+ *******************************************************************************/
+
+/* Topics worth trying: the values, the link topics, and one more than the last of each group */
+static const uint8 g_fuzzTopics[] =
+{
+	LINK_TOPIC_TEMPERATURE, LINK_TOPIC_EMERGENCY, LINK_TOPIC_FAN_STATE, LINK_TOPIC_HEARTBEAT, LINK_NUM_OF_TOPICS,
+	LINK_POLL_TOPIC, LINK_TRACE_TOPIC, LINK_EMERGENCY_TOPIC, LINK_ZONES_TOPIC, LINK_REPLY_TOPIC,
+	LINK_COMMAND_TOPIC, LINK_NAK_TOPIC, LINK_SOF, LINK_BENCHMARK_TOPIC
+};
+
+static const uint8 g_fuzzCommands[] =
+{
+	CONFIG_COMMAND_GET, CONFIG_COMMAND_SET, CONFIG_COMMAND_SAVE, CONFIG_COMMAND_DEFAULTS, LINK_COMMAND_GET_STATISTICS
+};
+
+static uint32 g_fuzzSeed = 1;
+
+static uint8 Fuzz_Random(void)
+{
+	g_fuzzSeed = g_fuzzSeed * 1103515245UL + 12345UL;
+	return (uint8)(g_fuzzSeed >> 16);
+}
+
+static uint8 Fuzz_Crc8Update(uint8 Crc, uint8 Byte)
+{
+	uint8 Bit;
+
+	Crc ^= Byte;
+	for (Bit = 0; Bit < 8; Bit++)
+	{
+		Crc = (Crc & 0x80) ? (uint8)((Crc << 1) ^ 0x07) : (uint8)(Crc << 1);
+	}
+
+	return Crc;
+}
+
+/* Add one character {CONTROL, DATA} with a random cycle, time step and rare UART errors */
+static size_t Fuzz_AddCharacter(uint8 *Input_Ptr, size_t Size, uint8 Bit8, uint8 Data)
+{
+	uint8 Control = Bit8;
+
+	if ((Fuzz_Random() & 0x3F) == 0)
+	{
+		Control |= (Fuzz_Random() & FUZZ_CONTROL_ERRORS_MASK) << FUZZ_CONTROL_ERRORS_SHIFT;
+	}
+	if (Fuzz_Random() & 0x01)
+	{
+		Control |= FUZZ_CONTROL_CYCLE;
+	}
+	if ((Fuzz_Random() & 0x0F) == 0)
+	{
+		Control |= (Fuzz_Random() & 0x07) << FUZZ_CONTROL_TICKS_SHIFT;
+	}
+
+	if ((Size + 2) <= FUZZ_MAX_INPUT)
+	{
+		Input_Ptr[Size++] = Control;
+		Input_Ptr[Size++] = Data;
+	}
+
+	return Size;
+}
+
+/* Frames of the protocol with random fields, mostly with a good CRC, sometimes cut or changed */
+static size_t Fuzz_Generate(uint8 *Input_Ptr)
+{
+	uint8 Payload[LINK_MAX_PAYLOAD + 4];
+	uint8 Characters[LINK_FRAME_OVERHEAD + LINK_MAX_PAYLOAD];
+	uint8 Frames = (Fuzz_Random() % FUZZ_RANDOM_MAX_FRAMES) + 1;
+	uint8 Frame;
+	uint8 Topic;
+	uint8 Length;
+	uint8 Source;
+	uint8 Address;
+	uint8 Crc;
+	uint8 Number;
+	uint8 i;
+	size_t Size = 0;
+
+	Input_Ptr[Size++] = Fuzz_Random();
+	Input_Ptr[Size++] = Fuzz_Random();
+
+	for (Frame = 0; Frame < Frames; Frame++)
+	{
+		Topic = g_fuzzTopics[Fuzz_Random() % sizeof(g_fuzzTopics)];
+		Source = (Fuzz_Random() & 0x03) ? LINK_SENSOR_NODE_ADDRESS : Fuzz_Random();
+		Address = (Fuzz_Random() & 0x03) ? LINK_ACTUATOR_BASE_ADDRESS : ((Fuzz_Random() & 0x01) ? LINK_BROADCAST_ADDRESS : Fuzz_Random());
+
+		/* The right length of the topic most of the time */
+		switch (Topic)
+		{
+		case LINK_ZONES_TOPIC:
+			Length = LINK_ZONES_HEADER_SIZE + (Fuzz_Random() % (LINK_MAX_ZONES + 2));
+			break;
+
+		case LINK_EMERGENCY_TOPIC:
+			Length = 1;
+			break;
+
+		case LINK_POLL_TOPIC:
+		case LINK_NAK_TOPIC:
+			Length = 0;
+			break;
+
+		case LINK_COMMAND_TOPIC:
+			Length = (Fuzz_Random() % 5) + 1;
+			break;
+
+		default:
+			Length = 2;
+			break;
+		}
+		if ((Fuzz_Random() & 0x07) == 0)
+		{
+			Length = Fuzz_Random() % (LINK_MAX_PAYLOAD + 3);
+		}
+
+		for (i = 0; i < sizeof(Payload); i++)
+		{
+			Payload[i] = (Fuzz_Random() & 0x01) ? Fuzz_Random() : (Fuzz_Random() & 0x03);
+		}
+		if (Topic == LINK_COMMAND_TOPIC)
+		{
+			Payload[0] = g_fuzzCommands[Fuzz_Random() % sizeof(g_fuzzCommands)];
+			Payload[1] = Fuzz_Random() % (CONFIG_NUM_OF_PARAMS + 1);
+		}
+		if ((Topic == LINK_ZONES_TOPIC) && (Fuzz_Random() & 0x01))
+		{
+			Payload[0] = Length - LINK_ZONES_HEADER_SIZE;
+			Payload[1] = Fuzz_Random() % (Payload[0] + 1);
+		}
+
+		/* ADDRESS, SOF, SOURCE, TOPIC, LEN, PAYLOAD (LEN above the maximum is cut), CRC */
+		Number = 0;
+		Characters[Number++] = Address;
+		Characters[Number++] = LINK_SOF;
+		Characters[Number++] = Source;
+		Characters[Number++] = Topic;
+		Characters[Number++] = Length;
+		Crc = Fuzz_Crc8Update(Fuzz_Crc8Update(Fuzz_Crc8Update(0, Source), Topic), Length);
+		for (i = 0; (i < Length) && (i < LINK_MAX_PAYLOAD); i++)
+		{
+			Characters[Number++] = Payload[i];
+			Crc = Fuzz_Crc8Update(Crc, Payload[i]);
+		}
+		if ((Fuzz_Random() & 0x0F) == 0)
+		{
+			Crc ^= 1 << (Fuzz_Random() & 0x07);
+		}
+		Characters[Number++] = Crc;
+
+		/* A frame is sometimes cut by the next one */
+		if ((Fuzz_Random() & 0x0F) == 0)
+		{
+			Number = (Fuzz_Random() % Number) + 1;
+		}
+
+		for (i = 0; i < Number; i++)
+		{
+			Size = Fuzz_AddCharacter(Input_Ptr, Size, (i == 0) ? FUZZ_CONTROL_BIT8 : 0, Characters[i]);
+		}
+	}
+
+	return Size;
+}
+
+/* Read a whole input file, return its size */
+static size_t Fuzz_ReadFile(const char *Name, uint8 *Input_Ptr)
+{
+	FILE *File = fopen(Name, "rb");
+	size_t Size;
+
+	if (File == NULL)
+	{
+		fprintf(stderr, "Fuzz_Link: can not open %s\n", Name);
+		exit(1);
+	}
+
+	Size = fread(Input_Ptr, 1, FUZZ_MAX_INPUT, File);
+	fclose(File);
+
+	return Size;
+}
+
+/*
+ * Without libFuzzer (make test): replay the input files given as arguments (a crash found by
+ * make fuzz), or run FUZZ_RANDOM_RUNS generated inputs.
+ */
+int main(int argc, char **argv)
+{
+	static uint8 Input[FUZZ_MAX_INPUT];
+	size_t Size;
+	uint32 Run;
+	int i;
+
+	if (argc > 1)
+	{
+		for (i = 1; i < argc; i++)
+		{
+			Size = Fuzz_ReadFile(argv[i], Input);
+			LLVMFuzzerTestOneInput(Input, Size);
+		}
+		printf("%d inputs replayed\n", argc - 1);
+		return 0;
+	}
+
+	for (Run = 0; Run < FUZZ_RANDOM_RUNS; Run++)
+	{
+		Size = Fuzz_Generate(Input);
+		LLVMFuzzerTestOneInput(Input, Size);
+	}
+	printf("%u generated inputs, all checks passed\n", (unsigned)FUZZ_RANDOM_RUNS);
+
+	return 0;
+}
+
+#endif
@@ -0,0 +1,359 @@
+/*******************************************************************************************************************
+ * File Name: Mock.c
+ * Date: 19/10/2026
+ * Driver: Host Mock of the ATmega32 Registers Source File (Unit Tests)
+ * Author: Youssef Zaki
+ ******************************************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <avr/io.h>
+#include <util/delay.h>
+#include "Mock.h"
+#include "SYSTICK.h"
+#include "POWER.h"
+
+/*
+ * A register name in a driver is *Mock_Access(Id), a plain memory cell. C can not see the
+ * assignments to a cell, so every access first compares all the cells with their value at the
+ * previous access: a cell that changed was written by the driver in between and the write is
+ * logged. The log is then the sequence of the register writes in program order, a write of
+ * the value the register already has is not seen (start the test from another value).
+ * The EEPROM cells are modelled too: EERE loads EEDR from the cell at EEAR, EEWE with EEMWE set
+ * programs EEDR into it. Ending the write (clearing EEWE and EEMWE) is left to the sleep hook.
+ */
+
+/***************************************************************************************
+ *                                         Global Variables                            *
+ ***************************************************************************************/
+
+/* Registers as the driver sees them and their value at the previous access */
+static uint16 g_mockRegisters[MOCK_NUM_OF_REGISTERS];
+static uint16 g_mockShadow[MOCK_NUM_OF_REGISTERS];
+
+/* Bits owned by the hardware, a write of the driver does not change them */
+static const uint16 g_mockReadOnlyBits[MOCK_NUM_OF_REGISTERS] =
+{
+	[MOCK_PINA]  = 0xFF,
+	[MOCK_PINB]  = 0xFF,
+	[MOCK_PINC]  = 0xFF,
+	[MOCK_PIND]  = 0xFF,
+	[MOCK_UCSRA] = (1<<RXC) | (1<<TXC) | (1<<UDRE) | (1<<FE) | (1<<DOR) | (1<<PE),
+	[MOCK_UCSRB] = (1<<RXB8),
+	[MOCK_ADC]   = 0xFFFF
+};
+
+/* Byte given by a read of UDR (the receive buffer of the UART) */
+static uint8 g_mockUdrRead = 0;
+
+static uint8 g_mockEeprom[MOCK_EEPROM_SIZE];
+
+static Mock_EventType g_mockLog[MOCK_LOG_SIZE];
+static uint16 g_mockLogLength = 0;
+static uint32 g_mockLostEvents = 0;
+
+static uint16 g_mockTicks = 0;
+static uint32 g_mockSleeps = 0;
+static void (*g_mockSleepHook)(void) = NULL_PTR;
+
+static const char *const g_mockRegisterNames[MOCK_NUM_OF_REGISTERS] =
+{
+	"DDRA", "DDRB", "DDRC", "DDRD",
+	"PORTA", "PORTB", "PORTC", "PORTD",
+	"PINA", "PINB", "PINC", "PIND",
+	"UCSRA", "UCSRB", "UCSRC", "UDR", "UBRRH", "UBRRL",
+	"ADMUX", "ADCSRA", "ADC", "SFIOR",
+	"TCCR1A", "TCCR1B", "TCNT1", "OCR1A", "OCR1B", "ICR1",
+	"TIMSK", "TIFR", "TCCR0", "TCNT0", "OCR0",
+	"EEAR", "EEDR", "EECR",
+	"MCUCR", "MCUCSR", "GICR", "GIFR", "SREG"
+};
+
+/***************************************************************************************
+ *                                      Private Functions                              *
+ ***************************************************************************************/
+
+static void Mock_Log(Mock_EventKind Kind, Mock_RegisterId Id, uint32 Value)
+{
+	if (g_mockLogLength < MOCK_LOG_SIZE)
+	{
+		g_mockLog[g_mockLogLength].Kind = Kind;
+		g_mockLog[g_mockLogLength].Id = Id;
+		g_mockLog[g_mockLogLength].Value = Value;
+		g_mockLogLength++;
+	}
+	else
+	{
+		g_mockLostEvents++;
+	}
+}
+
+/****************************************************************************************
+ *                                      Functions Definitions                           *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Log the writes done since the previous access, then return the cell of the register Id.
+ * Every use of a register name in a driver goes through this function.
+ */
+volatile void *Mock_Access(Mock_RegisterId Id)
+{
+	Mock_Sync();
+
+	if (Id == MOCK_UDR)
+	{
+		/* A read gives the received byte, a write is seen as a change of it */
+		g_mockRegisters[MOCK_UDR] = g_mockUdrRead;
+		g_mockShadow[MOCK_UDR] = g_mockUdrRead;
+	}
+
+	return &g_mockRegisters[Id];
+}
+
+/*
+ * Description:
+ * Log the writes done since the last access of a register (call it before reading the log).
+ */
+void Mock_Sync(void)
+{
+	Mock_RegisterId Id;
+	uint16 Written;
+	uint16 Value;
+
+	for (Id = 0; Id < MOCK_NUM_OF_REGISTERS; Id++)
+	{
+		if (g_mockRegisters[Id] != g_mockShadow[Id])
+		{
+			Written = g_mockRegisters[Id];
+			Mock_Log(MOCK_EVENT_WRITE, Id, Written);
+
+			Value = (Written & ~g_mockReadOnlyBits[Id]) | (g_mockShadow[Id] & g_mockReadOnlyBits[Id]);
+
+			/* TXC is cleared by writing a logic one to it */
+			if ((Id == MOCK_UCSRA) && (Written & (1<<TXC)))
+			{
+				Value &= ~(1<<TXC);
+			}
+
+			if (Id == MOCK_EECR)
+			{
+				/* A read strobe gives the cell at once, a write is programmed when EEWE is set */
+				if (Written & (1<<EERE))
+				{
+					g_mockRegisters[MOCK_EEDR] = g_mockEeprom[g_mockRegisters[MOCK_EEAR] % MOCK_EEPROM_SIZE];
+					g_mockShadow[MOCK_EEDR] = g_mockRegisters[MOCK_EEDR];
+					Value &= ~(1<<EERE);
+				}
+				if ((Written & (1<<EEWE)) && (Written & (1<<EEMWE)) && !(g_mockShadow[Id] & (1<<EEWE)))
+				{
+					g_mockEeprom[g_mockRegisters[MOCK_EEAR] % MOCK_EEPROM_SIZE] = (uint8)g_mockRegisters[MOCK_EEDR];
+				}
+			}
+
+			g_mockRegisters[Id] = Value;
+			g_mockShadow[Id] = Value;
+		}
+	}
+}
+
+/*
+ * Description:
+ * Put every register in its reset state, clear the log, the SysTick and the sleep hook.
+ * The Global Interrupt Enable bit is set, like in the application after sei().
+ */
+void Mock_Reset(void)
+{
+	Mock_RegisterId Id;
+	uint16 Address;
+
+	for (Id = 0; Id < MOCK_NUM_OF_REGISTERS; Id++)
+	{
+		g_mockRegisters[Id] = 0;
+		g_mockShadow[Id] = 0;
+	}
+
+	/* Reset values of the ATmega32 datasheet which are not zero */
+	Mock_Set(MOCK_UCSRA, (1<<UDRE));
+	Mock_Set(MOCK_UCSRC, (1<<URSEL) | (1<<UCSZ1) | (1<<UCSZ0));
+	Mock_Set(MOCK_SREG, (1<<SREG_I));
+	g_mockUdrRead = 0;
+
+	for (Address = 0; Address < MOCK_EEPROM_SIZE; Address++)
+	{
+		g_mockEeprom[Address] = 0xFF;
+	}
+
+	g_mockLogLength = 0;
+	g_mockLostEvents = 0;
+	g_mockTicks = 0;
+	g_mockSleeps = 0;
+	g_mockSleepHook = NULL_PTR;
+}
+
+/*
+ * Description:
+ * Give a register a value like the hardware does (status flags, received data, input pins),
+ * the value is not logged. For UDR, Value is the byte read by the next accesses.
+ */
+void Mock_Set(Mock_RegisterId Id, uint16 Value)
+{
+	Mock_Sync();
+
+	if (Id == MOCK_UDR)
+	{
+		g_mockUdrRead = (uint8)Value;
+	}
+
+	g_mockRegisters[Id] = Value;
+	g_mockShadow[Id] = Value;
+}
+
+/*
+ * Description:
+ * Log the pending writes and return the value of the register.
+ */
+uint16 Mock_Get(Mock_RegisterId Id)
+{
+	Mock_Sync();
+
+	return g_mockRegisters[Id];
+}
+
+/*
+ * Description:
+ * Give the logged events and their number, the log is kept until Mock_ClearLog.
+ */
+const Mock_EventType *Mock_GetLog(uint16 *Length_Ptr)
+{
+	Mock_Sync();
+
+	if (g_mockLostEvents != 0)
+	{
+		fprintf(stderr, "mock: %lu events lost, MOCK_LOG_SIZE is too small\n", (unsigned long)g_mockLostEvents);
+	}
+
+	*Length_Ptr = g_mockLogLength;
+	return g_mockLog;
+}
+
+/*
+ * Description:
+ * Log the pending writes, then start an empty log.
+ */
+void Mock_ClearLog(void)
+{
+	Mock_Sync();
+
+	g_mockLogLength = 0;
+	g_mockLostEvents = 0;
+}
+
+/*
+ * Description:
+ * Return the name of the register Id for the messages of the tests.
+ */
+const char *Mock_GetRegisterName(Mock_RegisterId Id)
+{
+	return (Id < MOCK_NUM_OF_REGISTERS) ? g_mockRegisterNames[Id] : "?";
+}
+
+/*
+ * Description:
+ * Function called by every Power_Sleep after the SysTick tick, it models the interrupts
+ * which wake the CPU up (conversion completed, byte received, ...). NULL_PTR for none.
+ */
+void Mock_SetSleepHook(void (*Hook_Ptr)(void))
+{
+	g_mockSleepHook = Hook_Ptr;
+}
+
+/*
+ * Description:
+ * Move the SysTick forward by Ms milliseconds.
+ */
+void Mock_AdvanceTicks(uint16 Ms)
+{
+	g_mockTicks += Ms;
+}
+
+/*
+ * Description:
+ * Return the number of Power_Sleep calls since Mock_Reset.
+ */
+uint32 Mock_GetSleeps(void)
+{
+	return g_mockSleeps;
+}
+
+/*
+ * Description:
+ * Log a busy wait between the register writes instead of waiting.
+ */
+void Mock_DelayUs(uint32_t Us)
+{
+	Mock_Sync();
+	Mock_Log(MOCK_EVENT_DELAY_US, MOCK_NUM_OF_REGISTERS, Us);
+}
+
+void Mock_DelayCycles(uint32_t Cycles)
+{
+	Mock_Sync();
+	Mock_Log(MOCK_EVENT_DELAY_CYCLES, MOCK_NUM_OF_REGISTERS, Cycles);
+}
+
+/****************************************************************************************
+ *                              SysTick and Power Services Stubs                        *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Return the number of milliseconds of the mock SysTick.
+ */
+uint16 SysTick_GetTicks(void)
+{
+	return g_mockTicks;
+}
+
+/*
+ * Description:
+ * Return the mock SysTick in Timer0 counts.
+ */
+uint16 SysTick_GetFineTime(void)
+{
+	return (uint16)(g_mockTicks * SYSTICK_COUNTS_PER_TICK);
+}
+
+/*
+ * Description:
+ * Return TRUE if at least Period ticks passed since the Start tick (wrap-around safe).
+ */
+boolean SysTick_HasElapsed(uint16 Start, uint16 Period)
+{
+	return ((uint16)(g_mockTicks - Start) >= Period) ? TRUE : FALSE;
+}
+
+/*
+ * Description:
+ * Log the sleep, then let one SysTick period pass and the sleep hook raise the interrupts
+ * which would wake the CPU up. A wait which never ends stops the test.
+ */
+void Power_Sleep(Power_SleepMode Mode)
+{
+	Mock_Sync();
+	Mock_Log(MOCK_EVENT_SLEEP, MOCK_NUM_OF_REGISTERS, Mode);
+
+	g_mockSleeps++;
+	if (g_mockSleeps > MOCK_MAX_SLEEPS)
+	{
+		fprintf(stderr, "mock: more than %d sleeps, the driver waits for an event that never comes\n", MOCK_MAX_SLEEPS);
+		abort();
+	}
+
+	/* The SysTick interrupt wakes the CPU up every tick */
+	g_mockTicks++;
+
+	if (g_mockSleepHook != NULL_PTR)
+	{
+		g_mockSleepHook();
+	}
+}
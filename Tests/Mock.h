@@ -0,0 +1,115 @@
+/*******************************************************************************************************************
+ * File Name: Mock.h
+ * Date: 19/10/2026
+ * Driver: Host Mock of the ATmega32 Registers Header File (Unit Tests)
+ * Author: Youssef Zaki
+ ******************************************************************************************************************/
+#include <avr/io.h>
+#include "Standard_Types.h"
+
+#ifndef MOCK_H_
+#define MOCK_H_
+
+/******************************************************************************************
+ *                                    Macros Definitions                                  *
+ ******************************************************************************************/
+
+/* Number of events kept in the log, the next ones are counted as lost */
+#define MOCK_LOG_SIZE                        1024
+
+/*
+ * Sleeps allowed between two Mock_Reset, a driver which sleeps more is waiting for an
+ * event that never comes: the test stops with an error instead of hanging.
+ */
+#define MOCK_MAX_SLEEPS                      10000
+
+/* Bytes of the EEPROM, erased (0xFF) by Mock_Reset */
+#define MOCK_EEPROM_SIZE                     1024
+
+/******************************************************************************************
+ *                                     Types Declaration                                  *
+ ******************************************************************************************/
+
+typedef enum
+{
+	MOCK_EVENT_WRITE,              /* Id = register, Value = written value          */
+	MOCK_EVENT_DELAY_US,           /* Value = microseconds of _delay_us / _delay_ms */
+	MOCK_EVENT_DELAY_CYCLES,       /* Value = cycles of __builtin_avr_delay_cycles  */
+	MOCK_EVENT_SLEEP               /* Value = Power_SleepMode                       */
+}Mock_EventKind;
+
+typedef struct
+{
+	Mock_EventKind Kind;
+	Mock_RegisterId Id;
+	uint32 Value;
+}Mock_EventType;
+
+/******************************************************************************************
+ *                                    Functions Prototypes                                *
+ ******************************************************************************************/
+
+/*
+ * Description:
+ * Put every register in its reset state, clear the log, the SysTick and the sleep hook.
+ * The Global Interrupt Enable bit is set, like in the application after sei().
+ */
+void Mock_Reset(void);
+
+/*
+ * Description:
+ * Give a register a value like the hardware does (status flags, received data, input pins),
+ * the value is not logged. For UDR, Value is the byte read by the next accesses.
+ */
+void Mock_Set(Mock_RegisterId Id, uint16 Value);
+
+/*
+ * Description:
+ * Log the pending writes and return the value of the register.
+ */
+uint16 Mock_Get(Mock_RegisterId Id);
+
+/*
+ * Description:
+ * Log the writes done since the last access of a register (call it before reading the log).
+ */
+void Mock_Sync(void);
+
+/*
+ * Description:
+ * Give the logged events and their number, the log is kept until Mock_ClearLog.
+ */
+const Mock_EventType *Mock_GetLog(uint16 *Length_Ptr);
+
+/*
+ * Description:
+ * Log the pending writes, then start an empty log.
+ */
+void Mock_ClearLog(void);
+
+/*
+ * Description:
+ * Return the name of the register Id for the messages of the tests.
+ */
+const char *Mock_GetRegisterName(Mock_RegisterId Id);
+
+/*
+ * Description:
+ * Function called by every Power_Sleep after the SysTick tick, it models the interrupts
+ * which wake the CPU up (conversion completed, byte received, ...). NULL_PTR for none.
+ */
+void Mock_SetSleepHook(void (*Hook_Ptr)(void));
+
+/*
+ * Description:
+ * Move the SysTick forward by Ms milliseconds.
+ */
+void Mock_AdvanceTicks(uint16 Ms);
+
+/*
+ * Description:
+ * Return the number of Power_Sleep calls since Mock_Reset.
+ */
+uint32 Mock_GetSleeps(void);
+
+#endif /* MOCK_H_ */
@@ -0,0 +1,156 @@
+/*******************************************************************************************************************
+ * File Name: Test.c
+ * Date: 19/10/2026
+ * Driver: Host Unit Tests Checks Source File
+ * Author: Youssef Zaki
+ ******************************************************************************************************************/
+#include <stdio.h>
+#include "Test.h"
+
+/***************************************************************************************
+ *                                         Global Variables                            *
+ ***************************************************************************************/
+
+static Mock_EventType g_testExpected[TEST_MAX_EXPECTED];
+static uint16 g_testExpectedLength = 0;
+
+static uint16 g_testRun = 0;
+static uint16 g_testFailed = 0;
+
+/* Failed checks of the running test */
+static uint16 g_testErrors = 0;
+
+/***************************************************************************************
+ *                                      Private Functions                              *
+ ***************************************************************************************/
+
+static void Test_PrintEvent(const char *Prefix, uint16 Index, const Mock_EventType *Event_Ptr)
+{
+	switch (Event_Ptr -> Kind)
+	{
+	case MOCK_EVENT_WRITE:
+		printf("    %s %3u: %-6s = 0x%02lX\n", Prefix, Index, Mock_GetRegisterName(Event_Ptr -> Id),
+				(unsigned long)Event_Ptr -> Value);
+		break;
+	case MOCK_EVENT_DELAY_US:
+		printf("    %s %3u: delay %lu us\n", Prefix, Index, (unsigned long)Event_Ptr -> Value);
+		break;
+	case MOCK_EVENT_DELAY_CYCLES:
+		printf("    %s %3u: delay %lu cycles\n", Prefix, Index, (unsigned long)Event_Ptr -> Value);
+		break;
+	case MOCK_EVENT_SLEEP:
+		printf("    %s %3u: sleep mode %lu\n", Prefix, Index, (unsigned long)Event_Ptr -> Value);
+		break;
+	}
+}
+
+static boolean Test_SameEvent(const Mock_EventType *First_Ptr, const Mock_EventType *Second_Ptr)
+{
+	return ((First_Ptr -> Kind == Second_Ptr -> Kind) && (First_Ptr -> Id == Second_Ptr -> Id) &&
+			(First_Ptr -> Value == Second_Ptr -> Value)) ? TRUE : FALSE;
+}
+
+/****************************************************************************************
+ *                                      Functions Definitions                           *
+ ****************************************************************************************/
+
+/*
+ * Description:
+ * Reset the mock registers, run one test and report it.
+ */
+void Test_Run(const char *Name, void (*Test_Ptr)(void))
+{
+	Mock_Reset();
+	g_testExpectedLength = 0;
+	g_testErrors = 0;
+
+	Test_Ptr();
+
+	g_testRun++;
+	if (g_testErrors != 0)
+	{
+		g_testFailed++;
+		printf("FAIL %s\n", Name);
+	}
+	else
+	{
+		printf("ok   %s\n", Name);
+	}
+}
+
+/*
+ * Description:
+ * Print the result of all the tests, return the exit code of the test program.
+ */
+int Test_Summary(void)
+{
+	printf("%u tests, %u failed\n", g_testRun, g_testFailed);
+
+	return (g_testFailed == 0) ? 0 : 1;
+}
+
+void Test_Check(boolean Passed, const char *Text, const char *File, int Line)
+{
+	if (Passed == FALSE)
+	{
+		g_testErrors++;
+		printf("  %s:%d: check failed: %s\n", File, Line, Text);
+	}
+}
+
+void Test_CheckEqual(uint32 Actual, uint32 Expected, const char *Text, const char *File, int Line)
+{
+	if (Actual != Expected)
+	{
+		g_testErrors++;
+		printf("  %s:%d: %s is %lu (0x%lX), expected %lu (0x%lX)\n", File, Line, Text,
+				(unsigned long)Actual, (unsigned long)Actual, (unsigned long)Expected, (unsigned long)Expected);
+	}
+}
+
+/*
+ * Description:
+ * Append an event to the expected log (see the EXPECT_xxx macros).
+ */
+void Test_Expect(Mock_EventKind Kind, Mock_RegisterId Id, uint32 Value)
+{
+	if (g_testExpectedLength < TEST_MAX_EXPECTED)
+	{
+		g_testExpected[g_testExpectedLength].Kind = Kind;
+		g_testExpected[g_testExpectedLength].Id = Id;
+		g_testExpected[g_testExpectedLength].Value = Value;
+		g_testExpectedLength++;
+	}
+}
+
+void Test_CheckLog(const char *File, int Line)
+{
+	uint16 Length;
+	const Mock_EventType *Log_Ptr = Mock_GetLog(&Length);
+	uint16 i;
+	uint16 First_Difference = 0;
+
+	while ((First_Difference < Length) && (First_Difference < g_testExpectedLength) &&
+			(Test_SameEvent(&Log_Ptr[First_Difference], &g_testExpected[First_Difference]) == TRUE))
+	{
+		First_Difference++;
+	}
+
+	if ((First_Difference != Length) || (First_Difference != g_testExpectedLength))
+	{
+		g_testErrors++;
+		printf("  %s:%d: register log differs at event %u\n", File, Line, First_Difference);
+
+		for (i = First_Difference; (i < g_testExpectedLength) && (i < First_Difference + 8); i++)
+		{
+			Test_PrintEvent("expected", i, &g_testExpected[i]);
+		}
+		for (i = First_Difference; (i < Length) && (i < First_Difference + 8); i++)
+		{
+			Test_PrintEvent("actual  ", i, &Log_Ptr[i]);
+		}
+	}
+
+	Mock_ClearLog();
+	g_testExpectedLength = 0;
+}
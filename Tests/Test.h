@@ -0,0 +1,59 @@
+/*******************************************************************************************************************
+ * File Name: Test.h
+ * Date: 19/10/2026
+ * Driver: Host Unit Tests Checks Header File
+ * Author: Youssef Zaki
+ ******************************************************************************************************************/
+#include "Standard_Types.h"
+#include "Mock.h"
+
+#ifndef TEST_H_
+#define TEST_H_
+
+/******************************************************************************************
+ *                                    Macros Definitions                                  *
+ ******************************************************************************************/
+
+/* Number of events one test can expect before its log is checked */
+#define TEST_MAX_EXPECTED                    MOCK_LOG_SIZE
+
+#define TEST_CHECK(CONDITION)                Test_Check((CONDITION) ? TRUE : FALSE, #CONDITION, __FILE__, __LINE__)
+#define TEST_CHECK_EQUAL(ACTUAL, EXPECTED)   Test_CheckEqual((uint32)(ACTUAL), (uint32)(EXPECTED), #ACTUAL, __FILE__, __LINE__)
+
+/* Events expected in the register log, in order (REGISTER is the register name, e.g. PORTB) */
+#define EXPECT_WRITE(REGISTER, VALUE)        Test_Expect(MOCK_EVENT_WRITE, MOCK_##REGISTER, (VALUE))
+#define EXPECT_DELAY_US(US)                  Test_Expect(MOCK_EVENT_DELAY_US, MOCK_NUM_OF_REGISTERS, (US))
+#define EXPECT_DELAY_CYCLES(CYCLES)          Test_Expect(MOCK_EVENT_DELAY_CYCLES, MOCK_NUM_OF_REGISTERS, (CYCLES))
+#define EXPECT_SLEEP(MODE)                   Test_Expect(MOCK_EVENT_SLEEP, MOCK_NUM_OF_REGISTERS, (MODE))
+
+/* Compare the log with the expected events, then start again with an empty log and no expectation */
+#define TEST_CHECK_LOG()                     Test_CheckLog(__FILE__, __LINE__)
+
+/******************************************************************************************
+ *                                    Functions Prototypes                                *
+ ******************************************************************************************/
+
+/*
+ * Description:
+ * Reset the mock registers, run one test and report it.
+ */
+void Test_Run(const char *Name, void (*Test_Ptr)(void));
+
+/*
+ * Description:
+ * Print the result of all the tests, return the exit code of the test program.
+ */
+int Test_Summary(void);
+
+void Test_Check(boolean Passed, const char *Text, const char *File, int Line);
+void Test_CheckEqual(uint32 Actual, uint32 Expected, const char *Text, const char *File, int Line);
+
+/*
+ * Description:
+ * Append an event to the expected log (see the EXPECT_xxx macros).
+ */
+void Test_Expect(Mock_EventKind Kind, Mock_RegisterId Id, uint32 Value);
+
+void Test_CheckLog(const char *File, int Line);
+
+#endif /* TEST_H_ */
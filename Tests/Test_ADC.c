@@ -0,0 +1,184 @@
+/*******************************************************************************************************************
+ * File Name: Test_ADC.c
+ * Date: 19/10/2026
+ * Driver: ADC Driver Unit Tests
+ * Author: Youssef Zaki
+ ******************************************************************************************************************/
+#include <avr/interrupt.h>
+#include "Test.h"
+#include "ADC.h"
+#include "POWER.h"
+
+/* Digital value of every channel and the number of wake-ups a conversion takes */
+static uint16 g_adcInputs[8];
+static uint8 g_adcWakeUpsPerConversion;
+static uint8 g_adcWakeUps;
+
+/* Hardware of the ADC: a started conversion ends with ADSC cleared and the ADC interrupt */
+static void Test_AdcHardware(void)
+{
+	uint8 Adcsra = (uint8)Mock_Get(MOCK_ADCSRA);
+
+	if ((Adcsra & (1<<ADSC)) == 0)
+	{
+		return;
+	}
+
+	g_adcWakeUps++;
+	if (g_adcWakeUps < g_adcWakeUpsPerConversion)
+	{
+		return;
+	}
+	g_adcWakeUps = 0;
+
+	Mock_Set(MOCK_ADC, g_adcInputs[Mock_Get(MOCK_ADMUX) & 0x07]);
+	Mock_Set(MOCK_ADCSRA, Adcsra & ~(1<<ADSC));
+	ADC_vect();
+}
+
+static void Test_Setup(void)
+{
+	uint8 Channel;
+
+	for (Channel = 0; Channel < 8; Channel++)
+	{
+		g_adcInputs[Channel] = 100 * Channel + 12;
+	}
+	g_adcWakeUpsPerConversion = 1;
+	g_adcWakeUps = 0;
+
+	Mock_SetSleepHook(Test_AdcHardware);
+}
+
+static void Test_InitSingleConversion(void)
+{
+	const ADC_ConfigType Config = {ADC_AVCC, CLK_8, Single_Conversion};
+
+	ADC_Init(&Config);
+
+	EXPECT_WRITE(ADMUX, 0x40);
+	EXPECT_WRITE(ADCSRA, 0x80);
+	EXPECT_WRITE(ADCSRA, 0x88);
+	EXPECT_WRITE(ADCSRA, 0x8B);
+	TEST_CHECK_LOG();
+}
+
+static void Test_InitAutoTrigger(void)
+{
+	const ADC_ConfigType Config = {ADC_AREF, CLK_128, TIMER0_OVF};
+
+	/* The channel and ADLAR are kept, the old reference is replaced */
+	Mock_Set(MOCK_ADMUX, 0xE5);
+
+	ADC_Init(&Config);
+
+	EXPECT_WRITE(ADMUX, 0x25);
+	EXPECT_WRITE(ADCSRA, 0x80);
+	EXPECT_WRITE(ADCSRA, 0x88);
+	EXPECT_WRITE(ADCSRA, 0x8F);
+	EXPECT_WRITE(ADCSRA, 0xAF);
+	/* ADTS2:0 = 100 */
+	EXPECT_WRITE(SFIOR, 0x80);
+	TEST_CHECK_LOG();
+}
+
+static void Test_ReadChannel(void)
+{
+	Test_Setup();
+	Mock_Set(MOCK_ADMUX, 0x40);
+	Mock_Set(MOCK_ADCSRA, 0x8B);
+
+	TEST_CHECK_EQUAL(ADC_ReadChannel(ADC2), 212);
+
+	/* The conversion is started with the interrupts disabled, then the CPU sleeps in Idle */
+	EXPECT_WRITE(ADMUX, 0x42);
+	EXPECT_WRITE(SREG, 0x00);
+	EXPECT_WRITE(ADCSRA, 0xCB);
+	EXPECT_SLEEP(POWER_IDLE);
+	EXPECT_WRITE(SREG, 0x80);
+	TEST_CHECK_LOG();
+}
+
+static void Test_ReadChannelWaits(void)
+{
+	Test_Setup();
+	g_adcWakeUpsPerConversion = 3;
+	Mock_Set(MOCK_ADMUX, 0x67);
+	Mock_Set(MOCK_ADCSRA, 0x8B);
+
+	/* Other interrupts wake the CPU up before the end of the conversion: it sleeps again */
+	TEST_CHECK_EQUAL(ADC_ReadChannel(ADC1), 112);
+
+	EXPECT_WRITE(ADMUX, 0x61);
+	EXPECT_WRITE(SREG, 0x00);
+	EXPECT_WRITE(ADCSRA, 0xCB);
+	EXPECT_SLEEP(POWER_IDLE);
+	EXPECT_SLEEP(POWER_IDLE);
+	EXPECT_SLEEP(POWER_IDLE);
+	EXPECT_WRITE(SREG, 0x80);
+	TEST_CHECK_LOG();
+}
+
+static void Test_Scan(void)
+{
+	static const InputChannel_Select Channels[] = {ADC0, ADC3, ADC7};
+	static volatile uint16 Results[3];
+
+	Test_Setup();
+	Mock_Set(MOCK_ADMUX, 0x47);
+	Mock_Set(MOCK_ADCSRA, 0x8B);
+
+	ADC_StartScan(Channels, 3, Results);
+	TEST_CHECK(ADC_IsScanComplete() == FALSE);
+
+	EXPECT_WRITE(SREG, 0x00);
+	EXPECT_WRITE(ADMUX, 0x40);
+	EXPECT_WRITE(ADCSRA, 0xCB);
+	EXPECT_WRITE(SREG, 0x80);
+	TEST_CHECK_LOG();
+
+	/* Every ADC interrupt saves its result and starts the next channel */
+	Test_AdcHardware();
+	EXPECT_WRITE(ADMUX, 0x43);
+	EXPECT_WRITE(ADCSRA, 0xCB);
+	TEST_CHECK_LOG();
+	TEST_CHECK(ADC_IsScanComplete() == FALSE);
+
+	Test_AdcHardware();
+	EXPECT_WRITE(ADMUX, 0x47);
+	EXPECT_WRITE(ADCSRA, 0xCB);
+	TEST_CHECK_LOG();
+	TEST_CHECK(ADC_IsScanComplete() == FALSE);
+
+	/* The last result ends the scan without a new conversion */
+	Test_AdcHardware();
+	TEST_CHECK_LOG();
+	TEST_CHECK(ADC_IsScanComplete() == TRUE);
+
+	TEST_CHECK_EQUAL(Results[0], 12);
+	TEST_CHECK_EQUAL(Results[1], 312);
+	TEST_CHECK_EQUAL(Results[2], 712);
+	TEST_CHECK_EQUAL(g_ADC_Value, 712);
+}
+
+static void Test_EmptyScan(void)
+{
+	static volatile uint16 Results[1];
+
+	ADC_StartScan(NULL_PTR, 0, Results);
+
+	TEST_CHECK(ADC_IsScanComplete() == TRUE);
+	TEST_CHECK_LOG();
+}
+
+int main(void)
+{
+	Test_Run("ADC init single conversion", Test_InitSingleConversion);
+	Test_Run("ADC init auto trigger", Test_InitAutoTrigger);
+	Test_Run("ADC read channel", Test_ReadChannel);
+	Test_Run("ADC read channel waits", Test_ReadChannelWaits);
+	Test_Run("ADC scan", Test_Scan);
+	Test_Run("ADC empty scan", Test_EmptyScan);
+
+	return Test_Summary();
+}
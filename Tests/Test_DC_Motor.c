@@ -0,0 +1,153 @@
+/*******************************************************************************************************************
+ * File Name: Test_DC_Motor.c
+ * Date: 19/10/2026
+ * Driver: DC Motor Driver Unit Tests
+ * Author: Youssef Zaki
+ ******************************************************************************************************************/
+#include "Test.h"
+#include "GPIO.h"
+#include "DC_Motor.h"
+
+/*
+ * Built twice: with the pins of the boards (IN1 PB0, IN2 PB1) and with IN2 moved to PC1
+ * (Test_DC_Motor_Split). The second build catches IN2 written through the port of IN1.
+ */
+#if ((DC_MOTOR_IN1_PORT_ID != PORTB_ID) || (DC_MOTOR_IN1_PIN_ID != PIN0_ID) || (DC_MOTOR_IN2_PIN_ID != PIN1_ID))
+#error "Test_DC_Motor expects IN1 on PB0 and IN2 on pin 1 of PORTB or PORTC"
+#endif
+
+#if (DC_MOTOR_IN2_PORT_ID == PORTB_ID)
+
+static void Test_Init(void)
+{
+	Mock_Set(MOCK_PORTB, 0xFF);
+
+	DcMotor_Init();
+
+	/* Both driver inputs are outputs and low: the motor is stopped */
+	EXPECT_WRITE(DDRB, 0x01);
+	EXPECT_WRITE(DDRB, 0x03);
+	EXPECT_WRITE(PORTB, 0xFE);
+	EXPECT_WRITE(PORTB, 0xFC);
+	TEST_CHECK_LOG();
+}
+
+static void Test_Rotate(void)
+{
+	/* IN1 high from a previous A_CW, the other pins of PORTB must be kept */
+	Mock_Set(MOCK_PORTB, 0xF5);
+
+	DcMotor_Rotate(CW, 512);
+	EXPECT_WRITE(PORTB, 0xF4);
+	EXPECT_WRITE(PORTB, 0xF6);
+	EXPECT_WRITE(ICR1, 2499);
+	EXPECT_WRITE(OCR1A, 512);
+	TEST_CHECK_LOG();
+
+	DcMotor_Rotate(A_CW, 100);
+	EXPECT_WRITE(PORTB, 0xF7);
+	EXPECT_WRITE(PORTB, 0xF5);
+	EXPECT_WRITE(OCR1A, 100);
+	TEST_CHECK_LOG();
+
+	DcMotor_Rotate(STOP, 0);
+	EXPECT_WRITE(PORTB, 0xF4);
+	EXPECT_WRITE(OCR1A, 0);
+	TEST_CHECK_LOG();
+}
+
+static void Test_InvalidState(void)
+{
+	Mock_Set(MOCK_PORTB, 0x03);
+	Mock_Set(MOCK_OCR1A, 300);
+
+	/* A state out of the enum stops the motor */
+	DcMotor_Rotate((DcMotor_State)7, 200);
+	EXPECT_WRITE(PORTB, 0x02);
+	EXPECT_WRITE(PORTB, 0x00);
+	EXPECT_WRITE(ICR1, 2499);
+	EXPECT_WRITE(OCR1A, 200);
+	TEST_CHECK_LOG();
+}
+
+#else
+
+static void Test_Init(void)
+{
+	Mock_Set(MOCK_PORTB, 0xFF);
+	Mock_Set(MOCK_PORTC, 0xFF);
+
+	DcMotor_Init();
+
+	EXPECT_WRITE(DDRB, 0x01);
+	EXPECT_WRITE(DDRC, 0x02);
+	EXPECT_WRITE(PORTB, 0xFE);
+	EXPECT_WRITE(PORTC, 0xFD);
+	TEST_CHECK_LOG();
+}
+
+static void Test_Rotate(void)
+{
+	/* PB1 is not a motor pin in this build, it must never be written */
+	Mock_Set(MOCK_PORTB, 0x01);
+	Mock_Set(MOCK_PORTC, 0x00);
+
+	DcMotor_Rotate(CW, 512);
+	EXPECT_WRITE(PORTB, 0x00);
+	EXPECT_WRITE(PORTC, 0x02);
+	EXPECT_WRITE(ICR1, 2499);
+	EXPECT_WRITE(OCR1A, 512);
+	TEST_CHECK_LOG();
+
+	DcMotor_Rotate(A_CW, 100);
+	EXPECT_WRITE(PORTB, 0x01);
+	EXPECT_WRITE(PORTC, 0x00);
+	EXPECT_WRITE(OCR1A, 100);
+	TEST_CHECK_LOG();
+
+	Mock_Set(MOCK_PORTC, 0x02);
+	DcMotor_Rotate(STOP, 0);
+	EXPECT_WRITE(PORTB, 0x00);
+	EXPECT_WRITE(PORTC, 0x00);
+	EXPECT_WRITE(OCR1A, 0);
+	TEST_CHECK_LOG();
+}
+
+static void Test_InvalidState(void)
+{
+	Mock_Set(MOCK_PORTB, 0x01);
+	Mock_Set(MOCK_PORTC, 0x02);
+	Mock_Set(MOCK_OCR1A, 300);
+
+	DcMotor_Rotate((DcMotor_State)7, 200);
+	EXPECT_WRITE(PORTB, 0x00);
+	EXPECT_WRITE(PORTC, 0x00);
+	EXPECT_WRITE(ICR1, 2499);
+	EXPECT_WRITE(OCR1A, 200);
+	TEST_CHECK_LOG();
+}
+
+#endif
+
+static void Test_SpeedLimit(void)
+{
+	Mock_Set(MOCK_ICR1, 2499);
+
+	/* A speed above the PWM TOP is limited to it */
+	DcMotor_Rotate(CW, 5000);
+	DcMotor_Rotate(CW, DC_MOTOR_PWM_TOP + 1);
+	TEST_CHECK_EQUAL(Mock_Get(MOCK_OCR1A), DC_MOTOR_PWM_TOP);
+
+	DcMotor_Rotate(CW, DC_MOTOR_PWM_TOP - 1);
+	TEST_CHECK_EQUAL(Mock_Get(MOCK_OCR1A), DC_MOTOR_PWM_TOP - 1);
+}
+
+int main(void)
+{
+	Test_Run("DC motor init", Test_Init);
+	Test_Run("DC motor rotate", Test_Rotate);
+	Test_Run("DC motor invalid state", Test_InvalidState);
+	Test_Run("DC motor speed limit", Test_SpeedLimit);
+
+	return Test_Summary();
+}
@@ -0,0 +1,108 @@
+/*******************************************************************************************************************
+ * File Name: Test_GPIO.c
+ * Date: 19/10/2026
+ * Driver: GPIO Driver Unit Tests
+ * Author: Youssef Zaki
+ ******************************************************************************************************************/
+#include "Test.h"
+#include "GPIO.h"
+
+static void Test_PinDirection(void)
+{
+	GPIO_SetupPinDirection(PORTA_ID, PIN0_ID, OUTPUT_PIN);
+	GPIO_SetupPinDirection(PORTB_ID, PIN3_ID, OUTPUT_PIN);
+	GPIO_SetupPinDirection(PORTC_ID, PIN5_ID, OUTPUT_PIN);
+	GPIO_SetupPinDirection(PORTD_ID, PIN7_ID, OUTPUT_PIN);
+	GPIO_SetupPinDirection(PORTD_ID, PIN6_ID, OUTPUT_PIN);
+	GPIO_SetupPinDirection(PORTD_ID, PIN7_ID, INPUT_PIN);
+
+	EXPECT_WRITE(DDRA, 0x01);
+	EXPECT_WRITE(DDRB, 0x08);
+	EXPECT_WRITE(DDRC, 0x20);
+	EXPECT_WRITE(DDRD, 0x80);
+	EXPECT_WRITE(DDRD, 0xC0);
+	EXPECT_WRITE(DDRD, 0x40);
+	TEST_CHECK_LOG();
+}
+
+static void Test_WrongPortOrPin(void)
+{
+	Mock_Set(MOCK_PORTD, 0x0F);
+
+	GPIO_SetupPinDirection(NUM_OF_PORTS, PIN0_ID, OUTPUT_PIN);
+	GPIO_SetupPinDirection(PORTA_ID, NUM_OF_PINS_PER_PORT, OUTPUT_PIN);
+	GPIO_WritePin(NUM_OF_PORTS, PIN0_ID, LOGIC_HIGH);
+	GPIO_WritePin(PORTD_ID, NUM_OF_PINS_PER_PORT, LOGIC_LOW);
+	GPIO_SetupPortDirection(NUM_OF_PORTS, OUTPUT_PORT);
+	GPIO_WritePORT(NUM_OF_PORTS, 0x55);
+
+	TEST_CHECK_EQUAL(GPIO_ReadPin(NUM_OF_PORTS, PIN0_ID), LOGIC_LOW);
+	TEST_CHECK_LOG();
+}
+
+static void Test_WritePin(void)
+{
+	Mock_Set(MOCK_PORTC, 0xF0);
+
+	GPIO_WritePin(PORTC_ID, PIN0_ID, LOGIC_HIGH);
+	GPIO_WritePin(PORTC_ID, PIN7_ID, LOGIC_LOW);
+	GPIO_WritePin(PORTA_ID, PIN2_ID, LOGIC_HIGH);
+	GPIO_WritePin(PORTB_ID, PIN1_ID, LOGIC_HIGH);
+	GPIO_WritePin(PORTD_ID, PIN4_ID, LOGIC_HIGH);
+
+	/* Only the required bit is changed, the other pins of the port are kept */
+	EXPECT_WRITE(PORTC, 0xF1);
+	EXPECT_WRITE(PORTC, 0x71);
+	EXPECT_WRITE(PORTA, 0x04);
+	EXPECT_WRITE(PORTB, 0x02);
+	EXPECT_WRITE(PORTD, 0x10);
+	TEST_CHECK_LOG();
+}
+
+static void Test_ReadPin(void)
+{
+	Mock_Set(MOCK_PINA, 0x80);
+	Mock_Set(MOCK_PINB, 0x04);
+	Mock_Set(MOCK_PINC, 0xFE);
+	Mock_Set(MOCK_PIND, 0x01);
+
+	TEST_CHECK_EQUAL(GPIO_ReadPin(PORTA_ID, PIN7_ID), LOGIC_HIGH);
+	TEST_CHECK_EQUAL(GPIO_ReadPin(PORTB_ID, PIN2_ID), LOGIC_HIGH);
+	TEST_CHECK_EQUAL(GPIO_ReadPin(PORTB_ID, PIN3_ID), LOGIC_LOW);
+	TEST_CHECK_EQUAL(GPIO_ReadPin(PORTC_ID, PIN0_ID), LOGIC_LOW);
+	TEST_CHECK_EQUAL(GPIO_ReadPin(PORTD_ID, PIN0_ID), LOGIC_HIGH);
+
+	/* Reading never writes a register */
+	TEST_CHECK_LOG();
+}
+
+static void Test_Port(void)
+{
+	Mock_Set(MOCK_PINC, 0x3C);
+
+	GPIO_SetupPortDirection(PORTA_ID, OUTPUT_PORT);
+	GPIO_SetupPortDirection(PORTB_ID, OUTPUT_PORT);
+	GPIO_SetupPortDirection(PORTB_ID, INPUT_PORT);
+	GPIO_WritePORT(PORTD_ID, 0x5A);
+	GPIO_WritePORT(PORTC_ID, 0xA5);
+
+	TEST_CHECK_EQUAL(GPIO_ReadPORT(PORTC_ID), 0x3C);
+
+	EXPECT_WRITE(DDRA, 0xFF);
+	EXPECT_WRITE(DDRB, 0xFF);
+	EXPECT_WRITE(DDRB, 0x00);
+	EXPECT_WRITE(PORTD, 0x5A);
+	EXPECT_WRITE(PORTC, 0xA5);
+	TEST_CHECK_LOG();
+}
+
+int main(void)
+{
+	Test_Run("GPIO pin direction", Test_PinDirection);
+	Test_Run("GPIO wrong port or pin", Test_WrongPortOrPin);
+	Test_Run("GPIO write pin", Test_WritePin);
+	Test_Run("GPIO read pin", Test_ReadPin);
+	Test_Run("GPIO port", Test_Port);
+
+	return Test_Summary();
+}
@@ -0,0 +1,406 @@
+/*******************************************************************************************************************
+ * File Name: Test_LCD.c
+ * Date: 19/10/2026
+ * Driver: LCD Driver Unit Tests
+ * Author: Youssef Zaki
+ ******************************************************************************************************************/
+#include <avr/pgmspace.h>
+#include <string.h>
+#include "Test.h"
+#include "GPIO.h"
+#include "LCD.h"
+
+/*
+ * Built with the pins of MCU1 (Test_LCD), of MCU2 (Test_LCD_MCU2) and of MCU2 in 4-bit mode
+ * (Test_LCD_4Bit). The expected writes follow the pins of LCD.h.
+ */
+
+/* The bus times of the HD44780 (60, 450 and 550 ns) are shorter than one cycle at 1 MHz */
+#if (F_CPU != 1000000UL)
+#error "Test_LCD expects F_CPU = 1 MHz"
+#endif
+#define TEST_T_AS_CYCLES                     1
+#define TEST_T_PWEH_CYCLES                   1
+#define TEST_T_E_LOW_CYCLES                  1
+
+#define TEST_T_EXECUTION_US                  40
+#define TEST_T_CLEAR_US                      2000
+
+#if (LCD_BIT_MODE == 4)
+#if ((LCD_DB5_PIN_ID != LCD_DB4_PIN_ID + 1) || (LCD_DB6_PIN_ID != LCD_DB4_PIN_ID + 2) || (LCD_DB7_PIN_ID != LCD_DB4_PIN_ID + 3))
+#error "Test_LCD expects DB4 .. DB7 on consecutive pins"
+#endif
+#define TEST_DATA_MASK                       (0x0F << LCD_DB4_PIN_ID)
+#endif
+
+/* Size of the bytes decoded from the bus */
+#define TEST_MAX_BUS_BYTES                   64
+
+/* Register of every port ID */
+static const Mock_RegisterId g_lcdPorts[NUM_OF_PORTS] = {MOCK_PORTA, MOCK_PORTB, MOCK_PORTC, MOCK_PORTD};
+static const Mock_RegisterId g_lcdDirections[NUM_OF_PORTS] = {MOCK_DDRA, MOCK_DDRB, MOCK_DDRC, MOCK_DDRD};
+
+/* Registers as they must be after the expected writes, a write which changes nothing is not logged */
+static uint16 g_lcdModel[MOCK_NUM_OF_REGISTERS];
+
+/*******************************************************************************
+ *                          Expected Writes of the Bus                          *
+ *******************************************************************************/
+
+/* Start the expected writes (and the log) from the registers of now */
+static void Test_ModelRegisters(void)
+{
+	Mock_RegisterId Id;
+
+	for (Id = 0; Id < MOCK_NUM_OF_REGISTERS; Id++)
+	{
+		g_lcdModel[Id] = Mock_Get(Id);
+	}
+
+	Mock_ClearLog();
+}
+
+static void Expect_Value(Mock_RegisterId Id, uint8 Value)
+{
+	if (g_lcdModel[Id] != Value)
+	{
+		g_lcdModel[Id] = Value;
+		Test_Expect(MOCK_EVENT_WRITE, Id, Value);
+	}
+}
+
+static void Expect_Bit(Mock_RegisterId Id, uint8 Bit, uint8 Value)
+{
+	Expect_Value(Id, (Value == LOGIC_HIGH) ? (g_lcdModel[Id] | (1 << Bit)) : (g_lcdModel[Id] & ~(1 << Bit)));
+}
+
+/* E pulse: the LCD latches the data when E falls */
+static void Expect_Enable(void)
+{
+	Expect_Bit(g_lcdPorts[LCD_E_PORT], LCD_E_PIN, LOGIC_HIGH);
+	EXPECT_DELAY_CYCLES(TEST_T_PWEH_CYCLES);
+	Expect_Bit(g_lcdPorts[LCD_E_PORT], LCD_E_PIN, LOGIC_LOW);
+	EXPECT_DELAY_CYCLES(TEST_T_E_LOW_CYCLES);
+}
+
+#if (LCD_BIT_MODE == 4)
+
+/* The nibble is written in one read-modify-write of the port with the interrupts disabled */
+static void Expect_Nibble(uint8 Nibble)
+{
+	Mock_RegisterId Port = g_lcdPorts[LCD_DATA_PORT];
+
+	EXPECT_WRITE(SREG, 0x00);
+	Expect_Value(Port, (g_lcdModel[Port] & ~TEST_DATA_MASK) | ((Nibble & 0x0F) << LCD_DB4_PIN_ID));
+	EXPECT_WRITE(SREG, 0x80);
+	Expect_Enable();
+}
+
+#endif
+
+static void Expect_Write(uint8 Data, uint8 RS)
+{
+	Expect_Bit(g_lcdPorts[LCD_RS_PORT], LCD_RS_PIN, RS);
+	EXPECT_DELAY_CYCLES(TEST_T_AS_CYCLES);
+
+#if (LCD_BIT_MODE == 8)
+	Expect_Value(g_lcdPorts[LCD_DATA_PORT], Data);
+	Expect_Enable();
+#else
+	Expect_Nibble(Data >> 4);
+	Expect_Nibble(Data);
+#endif
+
+	EXPECT_DELAY_US(TEST_T_EXECUTION_US);
+}
+
+/*******************************************************************************
+ *                               Bus Decoder                                    *
+ *******************************************************************************/
+
+/*
+ * Replay the log on the registers taken by Test_ModelRegisters and read the bus like the LCD:
+ * at every falling edge of E, RS and the data pins are latched. Return the number of bytes,
+ * every one is RS << 8 | byte.
+ */
+static uint8 Test_DecodeBus(uint16 *Bytes_Ptr)
+{
+	uint16 Length;
+	const Mock_EventType *Log_Ptr = Mock_GetLog(&Length);
+	uint16 Ports[NUM_OF_PORTS];
+	uint8 Port;
+	uint16 i;
+	uint8 Count = 0;
+	uint8 E_Before;
+	uint8 Latched;
+#if (LCD_BIT_MODE == 4)
+	uint8 High_Nibble = 0;
+	boolean Have_High_Nibble = FALSE;
+#endif
+
+	for (Port = 0; Port < NUM_OF_PORTS; Port++)
+	{
+		Ports[Port] = g_lcdModel[g_lcdPorts[Port]];
+	}
+
+	for (i = 0; i < Length; i++)
+	{
+		if (Log_Ptr[i].Kind != MOCK_EVENT_WRITE)
+		{
+			continue;
+		}
+
+		for (Port = 0; Port < NUM_OF_PORTS; Port++)
+		{
+			if (Log_Ptr[i].Id != g_lcdPorts[Port])
+			{
+				continue;
+			}
+
+			E_Before = (Ports[LCD_E_PORT] >> LCD_E_PIN) & 1;
+			Ports[Port] = Log_Ptr[i].Value;
+
+			if ((Port != LCD_E_PORT) || (E_Before == 0) || ((Ports[LCD_E_PORT] >> LCD_E_PIN) & 1))
+			{
+				continue;
+			}
+
+#if (LCD_BIT_MODE == 8)
+			Latched = Ports[LCD_DATA_PORT];
+#else
+			Latched = (Ports[LCD_DATA_PORT] & TEST_DATA_MASK) >> LCD_DB4_PIN_ID;
+			if (Have_High_Nibble == FALSE)
+			{
+				High_Nibble = Latched;
+				Have_High_Nibble = TRUE;
+				continue;
+			}
+			Latched = (High_Nibble << 4) | Latched;
+			Have_High_Nibble = FALSE;
+#endif
+			if (Count < TEST_MAX_BUS_BYTES)
+			{
+				Bytes_Ptr[Count++] = (((Ports[LCD_RS_PORT] >> LCD_RS_PIN) & 1) << 8) | Latched;
+			}
+		}
+	}
+
+	/* The next decode starts from the ports of now */
+	for (Port = 0; Port < NUM_OF_PORTS; Port++)
+	{
+		g_lcdModel[g_lcdPorts[Port]] = Ports[Port];
+	}
+
+	Mock_ClearLog();
+	return Count;
+}
+
+/* Check that the bus carried the characters of Text (RS = 1) and nothing else */
+static void Test_CheckDisplayed(const char *Text)
+{
+	uint16 Bytes[TEST_MAX_BUS_BYTES];
+	uint8 Count = Test_DecodeBus(Bytes);
+	uint8 i;
+
+	TEST_CHECK_EQUAL(Count, strlen(Text));
+
+	for (i = 0; (i < Count) && (Text[i] != '\0'); i++)
+	{
+		TEST_CHECK_EQUAL(Bytes[i], 0x0100 | (uint8)Text[i]);
+	}
+}
+
+/*******************************************************************************
+ *                                   Tests                                     *
+ *******************************************************************************/
+
+static void Test_StartInit(void)
+{
+	Mock_Set(g_lcdPorts[LCD_E_PORT], 0xFF);
+	Test_ModelRegisters();
+
+	LCD_StartInit();
+
+	Expect_Bit(g_lcdDirections[LCD_RS_PORT], LCD_RS_PIN, LOGIC_HIGH);
+	Expect_Bit(g_lcdDirections[LCD_E_PORT], LCD_E_PIN, LOGIC_HIGH);
+	Expect_Bit(g_lcdPorts[LCD_E_PORT], LCD_E_PIN, LOGIC_LOW);
+#if (LCD_BIT_MODE == 8)
+	Expect_Value(g_lcdDirections[LCD_DATA_PORT], 0xFF);
+#else
+	Expect_Bit(g_lcdDirections[LCD_DATA_PORT], LCD_DB4_PIN_ID, LOGIC_HIGH);
+	Expect_Bit(g_lcdDirections[LCD_DATA_PORT], LCD_DB5_PIN_ID, LOGIC_HIGH);
+	Expect_Bit(g_lcdDirections[LCD_DATA_PORT], LCD_DB6_PIN_ID, LOGIC_HIGH);
+	Expect_Bit(g_lcdDirections[LCD_DATA_PORT], LCD_DB7_PIN_ID, LOGIC_HIGH);
+#endif
+	TEST_CHECK_LOG();
+	TEST_CHECK(LCD_IsReady() == FALSE);
+
+	/* Nothing is sent during the power-on time (20 ms and the started tick) */
+	Mock_AdvanceTicks(20);
+	TEST_CHECK(LCD_InitTask() == FALSE);
+	TEST_CHECK_LOG();
+}
+
+static void Test_InitSequence(void)
+{
+	/* The first step is sent 21 ms after the start */
+	LCD_StartInit();
+	Mock_AdvanceTicks(21);
+	Test_ModelRegisters();
+
+#if (LCD_BIT_MODE == 8)
+
+	TEST_CHECK(LCD_InitTask() == FALSE);
+	Expect_Write(LCD_TWO_LINES_EIGHT_BIT_MODE, LOGIC_LOW);
+	Expect_Write(CLEAR_DISPLAY_SCREEN, LOGIC_LOW);
+	TEST_CHECK_LOG();
+
+#else
+
+	/* Three "8-bit mode" nibbles with the waits of the datasheet, then 4-bit mode */
+	TEST_CHECK(LCD_InitTask() == FALSE);
+	Expect_Bit(g_lcdPorts[LCD_RS_PORT], LCD_RS_PIN, LOGIC_LOW);
+	Expect_Nibble(0x3);
+	EXPECT_DELAY_US(TEST_T_EXECUTION_US);
+	TEST_CHECK_LOG();
+
+	Mock_AdvanceTicks(5);
+	TEST_CHECK(LCD_InitTask() == FALSE);
+	TEST_CHECK_LOG();
+
+	Mock_AdvanceTicks(1);
+	TEST_CHECK(LCD_InitTask() == FALSE);
+	Expect_Nibble(0x3);
+	EXPECT_DELAY_US(TEST_T_EXECUTION_US);
+	TEST_CHECK_LOG();
+
+	Mock_AdvanceTicks(2);
+	TEST_CHECK(LCD_InitTask() == FALSE);
+	Expect_Nibble(0x3);
+	EXPECT_DELAY_US(TEST_T_EXECUTION_US);
+	Expect_Nibble(0x2);
+	EXPECT_DELAY_US(TEST_T_EXECUTION_US);
+	Expect_Write(LCD_TWO_LINES_FOUR_BIT_MODE, LOGIC_LOW);
+	Expect_Write(CLEAR_DISPLAY_SCREEN, LOGIC_LOW);
+	TEST_CHECK_LOG();
+
+#endif
+
+	/* Clear Display takes 2 ms, one more tick is waited */
+	Mock_AdvanceTicks(2);
+	TEST_CHECK(LCD_InitTask() == FALSE);
+	TEST_CHECK_LOG();
+
+	Mock_AdvanceTicks(1);
+	TEST_CHECK(LCD_InitTask() == TRUE);
+	Expect_Write(DISPLAY_ON_CURSOR_OFF, LOGIC_LOW);
+	TEST_CHECK_LOG();
+	TEST_CHECK(LCD_IsReady() == TRUE);
+
+	/* Ready: nothing more is sent */
+	Mock_AdvanceTicks(100);
+	TEST_CHECK(LCD_InitTask() == TRUE);
+	TEST_CHECK_LOG();
+}
+
+static void Test_Commands(void)
+{
+	/* The other pins of the ports are kept */
+	Mock_Set(g_lcdPorts[LCD_RS_PORT], 0x81);
+	Mock_Set(g_lcdPorts[LCD_E_PORT], Mock_Get(g_lcdPorts[LCD_E_PORT]) | 0x81);
+	Test_ModelRegisters();
+
+	LCD_SendCommand(DISPLAY_ON_CURSOR_BLINKING);
+	LCD_ClearString();
+	LCD_SendCommand(RETURN_HOME);
+	LCD_MoveCursor(1, 5);
+	LCD_MoveCursor(3, 2);
+
+	Expect_Write(DISPLAY_ON_CURSOR_BLINKING, LOGIC_LOW);
+	Expect_Write(CLEAR_DISPLAY_SCREEN, LOGIC_LOW);
+	EXPECT_DELAY_US(TEST_T_CLEAR_US);
+	Expect_Write(RETURN_HOME, LOGIC_LOW);
+	EXPECT_DELAY_US(TEST_T_CLEAR_US);
+	Expect_Write(SET_CURSOR_POSITION | 0x45, LOGIC_LOW);
+	Expect_Write(SET_CURSOR_POSITION | 0x52, LOGIC_LOW);
+	TEST_CHECK_LOG();
+
+	TEST_CHECK_EQUAL(Mock_Get(g_lcdPorts[LCD_RS_PORT]) & 0x81, 0x81);
+}
+
+static void Test_Characters(void)
+{
+	Test_ModelRegisters();
+
+	LCD_DisplayCharacter('A');
+	LCD_DisplayStringRowColumn(0, 3, "Hi");
+
+	Expect_Write('A', LOGIC_HIGH);
+	Expect_Write(SET_CURSOR_POSITION | 0x03, LOGIC_LOW);
+	Expect_Write('H', LOGIC_HIGH);
+	Expect_Write('i', LOGIC_HIGH);
+	TEST_CHECK_LOG();
+}
+
+static void Test_Numbers(void)
+{
+	Test_ModelRegisters();
+
+	LCD_DisplayNumber(42, 4);
+	Test_CheckDisplayed("  42");
+
+	LCD_DisplayNumber(12345, 2);
+	Test_CheckDisplayed("12345");
+
+	LCD_DisplayNumber(0, 0);
+	Test_CheckDisplayed("0");
+
+	LCD_DisplayFixedPoint(235, 1, 5);
+	Test_CheckDisplayed(" 23.5");
+
+	LCD_DisplayFixedPoint(-5, 1, 0);
+	Test_CheckDisplayed("-0.5");
+
+	LCD_DisplayFixedPoint(7, 2, 0);
+	Test_CheckDisplayed("0.07");
+
+	LCD_IntegerToString(-123);
+	Test_CheckDisplayed("-123");
+
+	LCD_IntegerToString(32767);
+	Test_CheckDisplayed("32767");
+
+	LCD_DisplayString_P(PSTR("Temp"));
+	Test_CheckDisplayed("Temp");
+}
+
+static void Test_CreateCharacter(void)
+{
+	static const uint8 Pattern[LCD_GLYPH_ROWS] = {0xFF, 0x11, 0x0A, 0x04, 0x00, 0x1F, 0xE0, 0x15};
+	uint16 Bytes[TEST_MAX_BUS_BYTES];
+	uint8 i;
+
+	Test_ModelRegisters();
+
+	LCD_CreateCharacter(2, Pattern);
+
+	/* CGRAM address of glyph 2, then its rows limited to 5 dots */
+	TEST_CHECK_EQUAL(Test_DecodeBus(Bytes), 1 + LCD_GLYPH_ROWS);
+	TEST_CHECK_EQUAL(Bytes[0], SET_CGRAM_ADDRESS | (2 * LCD_GLYPH_ROWS));
+	for (i = 0; i < LCD_GLYPH_ROWS; i++)
+	{
+		TEST_CHECK_EQUAL(Bytes[1 + i], 0x0100 | (Pattern[i] & 0x1F));
+	}
+}
+
+int main(void)
+{
+	Test_Run("LCD start init", Test_StartInit);
+	Test_Run("LCD init sequence", Test_InitSequence);
+	Test_Run("LCD commands", Test_Commands);
+	Test_Run("LCD characters", Test_Characters);
+	Test_Run("LCD numbers", Test_Numbers);
+	Test_Run("LCD create character", Test_CreateCharacter);
+
+	return Test_Summary();
+}
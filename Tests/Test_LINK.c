@@ -0,0 +1,645 @@
+/*******************************************************************************************************************
+ * File Name: Test_LINK.c
+ * Date: 19/10/2026
+ * Driver: Inter-MCU Link Unit Tests (receive path of an actuator node, turns and relays of the sensor node)
+ * Author: Youssef Zaki
+ ******************************************************************************************************************/
+#include <avr/interrupt.h>
+#include "Test.h"
+#include "UART.h"
+#include "LINK.h"
+#include "CONFIG.h"
+
+#define TEST_NODE_ADDRESS                    LINK_ACTUATOR_BASE_ADDRESS
+
+/* Ninth bit of a character given to the receiver or written by the transmitter */
+#define TEST_ADDRESS                         0x0100
+
+/*
+ * UDR read by the driver outside the RXC interrupt: a byte written to UDR with this value is not
+ * a change of the register, Test_TakeSent finds it from the TXC write which goes before every byte.
+ */
+#define TEST_UDR_IDLE                        0x00
+
+/* Characters kept from the transmitter between two Test_TakeSent */
+#define TEST_MAX_SENT                        128
+
+/* Actuator nodes polled by the sensor node of the tests */
+#define TEST_NUM_OF_POLLED_NODES             2
+
+/* Time between two turns given by the sensor node of the tests: the actuator nodes and the service PC */
+#define TEST_POLL_PERIOD_MS                  (LINK_HEARTBEAT_PERIOD_MS / (TEST_NUM_OF_POLLED_NODES + 1))
+
+static const UART_ConfigType g_uartLinkConfig = {Asynchronous, Disabled, One_Bit, Nine_Bit_7};
+
+/* Publishing rules of MCU2 */
+static const Link_TopicConfigType g_linkTopics[LINK_NUM_OF_TOPICS] =
+{
+	{LINK_BROADCAST_ADDRESS,   1, 1000,                     LINK_MAX_TEMPERATURE},   /* LINK_TOPIC_TEMPERATURE */
+	{LINK_BROADCAST_ADDRESS,   1, 1000,                     LOGIC_HIGH},             /* LINK_TOPIC_EMERGENCY   */
+	{LINK_SENSOR_NODE_ADDRESS, 1, 1000,                     0xFF},                   /* LINK_TOPIC_FAN_STATE   */
+	{LINK_SENSOR_NODE_ADDRESS, 1, LINK_HEARTBEAT_PERIOD_MS, LINK_UP}                 /* LINK_TOPIC_HEARTBEAT   */
+};
+
+static const Link_ConfigType g_linkConfig = {TEST_NODE_ADDRESS, g_linkTopics, 0};
+
+/* Publishing rules of MCU1 */
+static const Link_TopicConfigType g_sensorTopics[LINK_NUM_OF_TOPICS] =
+{
+	{LINK_BROADCAST_ADDRESS,   1, 1000,                     LINK_MAX_TEMPERATURE},   /* LINK_TOPIC_TEMPERATURE */
+	{LINK_BROADCAST_ADDRESS,   1, 1000,                     LOGIC_HIGH},             /* LINK_TOPIC_EMERGENCY   */
+	{LINK_SENSOR_NODE_ADDRESS, 1, 1000,                     0xFF},                   /* LINK_TOPIC_FAN_STATE   */
+	{LINK_BROADCAST_ADDRESS,   1, LINK_HEARTBEAT_PERIOD_MS, LINK_UP}                 /* LINK_TOPIC_HEARTBEAT   */
+};
+
+static const Link_ConfigType g_sensorConfig = {LINK_SENSOR_NODE_ADDRESS, g_sensorTopics, TEST_NUM_OF_POLLED_NODES};
+
+/* Address of the node under test, the received frames are sent to it */
+static uint8 g_nodeAddress;
+
+/* Transmitter: UCSRB at the last write seen in the log (TXB8) and the characters taken from the log */
+static uint8 g_txUcsrb;
+static uint16 g_sent[TEST_MAX_SENT];
+static uint8 g_sentCount;
+
+/* Values given to the Call Back */
+static uint8 g_callBacks;
+static uint8 g_lastSource;
+static Link_TopicId g_lastTopic;
+static uint16 g_lastValue;
+
+static void Test_CallBack(uint8 Source, Link_TopicId Topic, uint16 Value)
+{
+	g_callBacks++;
+	g_lastSource = Source;
+	g_lastTopic = Topic;
+	g_lastValue = Value;
+}
+
+/* Command dispatcher of the actuator node: the configuration commands of MCU2 */
+static void Test_CommandCallBack(uint8 Source, const uint8 *Payload_Ptr, uint8 Length)
+{
+	Config_HandleCommand(Source, Payload_Ptr, Length);
+}
+
+/*******************************************************************************
+ *                               Bus Model                                      *
+ *******************************************************************************/
+
+/*
+ * Receiver hardware (see Test_UART.c): in the Multi-processor Communication Mode the data frames
+ * are ignored, otherwise the character goes through UDR to the RXC interrupt. The node polls the
+ * link after every character like MCU2 does after every wake-up.
+ */
+static void Test_ReceiveCharacter(uint16 Data, uint8 Errors)
+{
+	uint8 Ucsra = (uint8)Mock_Get(MOCK_UCSRA);
+	uint8 Ucsrb = (uint8)Mock_Get(MOCK_UCSRB);
+
+	if (((Ucsra & (1<<MPCM)) == 0) || (Data & TEST_ADDRESS))
+	{
+		Mock_Set(MOCK_UCSRA, (Ucsra & ~UART_STATUS_ERRORS) | Errors | (1<<RXC));
+		Mock_Set(MOCK_UCSRB, (Data & TEST_ADDRESS) ? (Ucsrb | (1<<RXB8)) : (Ucsrb & ~(1<<RXB8)));
+		Mock_Set(MOCK_UDR, (uint8)Data);
+
+		USART_RXC_vect();
+
+		Ucsra = (uint8)Mock_Get(MOCK_UCSRA);
+		Mock_Set(MOCK_UCSRA, Ucsra & ~(UART_STATUS_ERRORS | (1<<RXC)));
+		Mock_Set(MOCK_UDR, TEST_UDR_IDLE);
+	}
+
+	Link_Poll();
+}
+
+static uint8 Test_Crc8Update(uint8 Crc, uint8 Byte)
+{
+	uint8 Bit;
+
+	Crc ^= Byte;
+	for (Bit = 0; Bit < 8; Bit++)
+	{
+		Crc = (Crc & 0x80) ? (uint8)((Crc << 1) ^ 0x07) : (uint8)(Crc << 1);
+	}
+
+	return Crc;
+}
+
+/*
+ * Receive the first Count characters of a frame to this node: ADDRESS, SOF, SOURCE, TOPIC, LEN,
+ * PAYLOAD, CRC (LEN is given apart from the payload size to build wrong frames).
+ */
+static void Test_ReceivePartialFrame(uint8 Source, uint8 Topic, uint8 Length, const uint8 *Payload_Ptr, uint8 Size, uint8 Count)
+{
+	uint16 Characters[6 + LINK_MAX_PAYLOAD + 4];
+	uint8 Crc = 0;
+	uint8 Number = 0;
+	uint8 i;
+
+	Characters[Number++] = TEST_ADDRESS | g_nodeAddress;
+	Characters[Number++] = LINK_SOF;
+	Characters[Number++] = Source;
+	Characters[Number++] = Topic;
+	Characters[Number++] = Length;
+	Crc = Test_Crc8Update(Test_Crc8Update(Test_Crc8Update(Crc, Source), Topic), Length);
+	for (i = 0; i < Size; i++)
+	{
+		Characters[Number++] = Payload_Ptr[i];
+		Crc = Test_Crc8Update(Crc, Payload_Ptr[i]);
+	}
+	Characters[Number++] = Crc;
+
+	for (i = 0; (i < Number) && (i < Count); i++)
+	{
+		Test_ReceiveCharacter(Characters[i], 0);
+	}
+}
+
+static void Test_ReceiveFrame(uint8 Source, uint8 Topic, const uint8 *Payload_Ptr, uint8 Length)
+{
+	Test_ReceivePartialFrame(Source, Topic, Length, Payload_Ptr, Length, 0xFF);
+}
+
+static void Test_ReceiveValue(Link_TopicId Topic, uint16 Value)
+{
+	uint8 Payload[2] = {(uint8)Value, (uint8)(Value >> 8)};
+
+	Test_ReceiveFrame(LINK_SENSOR_NODE_ADDRESS, Topic, Payload, 2);
+}
+
+/*
+ * Take the characters sent since the last call from the log, with TXB8 as their ninth bit.
+ * UART_SendNineBit clears TXC just before it writes UDR, a byte without a UDR write is TEST_UDR_IDLE.
+ */
+static void Test_TakeSent(void)
+{
+	const Mock_EventType *Log_Ptr;
+	uint16 Length;
+	uint16 i;
+	uint8 Byte;
+
+	Mock_Sync();
+	Log_Ptr = Mock_GetLog(&Length);
+	g_sentCount = 0;
+
+	for (i = 0; i < Length; i++)
+	{
+		if ((Log_Ptr[i].Kind == MOCK_EVENT_WRITE) && (Log_Ptr[i].Id == MOCK_UCSRB))
+		{
+			g_txUcsrb = (uint8)Log_Ptr[i].Value;
+		}
+		else if ((Log_Ptr[i].Kind == MOCK_EVENT_WRITE) && (Log_Ptr[i].Id == MOCK_UCSRA) && (Log_Ptr[i].Value & (1<<TXC)) &&
+				(g_sentCount < TEST_MAX_SENT))
+		{
+			Byte = TEST_UDR_IDLE;
+			if (((i + 1) < Length) && (Log_Ptr[i + 1].Kind == MOCK_EVENT_WRITE) && (Log_Ptr[i + 1].Id == MOCK_UDR))
+			{
+				Byte = (uint8)Log_Ptr[i + 1].Value;
+			}
+			g_sent[g_sentCount++] = ((g_txUcsrb & (1<<TXB8)) ? TEST_ADDRESS : 0) | Byte;
+		}
+	}
+
+	Mock_ClearLog();
+}
+
+/*
+ * Find a frame with a good CRC to Address on Topic in the characters taken by Test_TakeSent,
+ * copy its source and payload. Return its payload length, 0xFF if there is no such frame.
+ */
+static uint8 Test_FindSent(uint8 Address, uint8 Topic, uint8 *Source_Ptr, uint8 *Payload_Ptr)
+{
+	uint8 Length;
+	uint8 Crc;
+	uint8 i;
+	uint8 j;
+
+	for (i = 0; (i + LINK_FRAME_OVERHEAD) <= g_sentCount; i++)
+	{
+		Length = (uint8)g_sent[i + 4];
+		if ((g_sent[i] != (TEST_ADDRESS | Address)) || (g_sent[i + 1] != LINK_SOF) || (g_sent[i + 3] != Topic) ||
+			(Length > LINK_MAX_PAYLOAD) || ((i + LINK_FRAME_OVERHEAD + Length) > g_sentCount))
+		{
+			continue;
+		}
+
+		Crc = 0;
+		for (j = 2; j < (5 + Length); j++)
+		{
+			Crc = Test_Crc8Update(Crc, (uint8)g_sent[i + j]);
+		}
+
+		if (Crc == g_sent[i + 5 + Length])
+		{
+			*Source_Ptr = (uint8)g_sent[i + 2];
+			for (j = 0; j < Length; j++)
+			{
+				Payload_Ptr[j] = (uint8)g_sent[i + 5 + j];
+			}
+			return Length;
+		}
+	}
+
+	return 0xFF;
+}
+
+/* Init the UART and the link of a node, the log starts empty */
+static void Test_SetupNode(const Link_ConfigType *Config_Ptr)
+{
+	UART_Init(&g_uartLinkConfig);
+	Link_Init(Config_Ptr);
+	Link_SetCallBack(Test_CallBack);
+	g_callBacks = 0;
+	g_nodeAddress = Config_Ptr -> Node_Address;
+	Mock_Set(MOCK_UDR, TEST_UDR_IDLE);
+	g_txUcsrb = (uint8)Mock_Get(MOCK_UCSRB);
+	Mock_ClearLog();
+}
+
+static void Test_Setup(void)
+{
+	Test_SetupNode(&g_linkConfig);
+}
+
+/*******************************************************************************
+ *                                   Tests                                     *
+ *******************************************************************************/
+
+static void Test_ValueFrame(void)
+{
+	uint16 Value = 0;
+
+	Test_Setup();
+
+	TEST_CHECK(Link_GetValue(LINK_TOPIC_TEMPERATURE, &Value) == FALSE);
+
+	Test_ReceiveValue(LINK_TOPIC_TEMPERATURE, 35);
+
+	TEST_CHECK(Link_GetValue(LINK_TOPIC_TEMPERATURE, &Value) == TRUE);
+	TEST_CHECK_EQUAL(Value, 35);
+	TEST_CHECK_EQUAL(g_callBacks, 1);
+	TEST_CHECK_EQUAL(g_lastSource, LINK_SENSOR_NODE_ADDRESS);
+	TEST_CHECK_EQUAL(g_lastTopic, LINK_TOPIC_TEMPERATURE);
+	TEST_CHECK_EQUAL(g_lastValue, 35);
+}
+
+static void Test_MaxValue(void)
+{
+	Link_StatisticsType Stats;
+	uint16 Value = 0;
+
+	Test_Setup();
+	Test_ReceiveValue(LINK_TOPIC_TEMPERATURE, LINK_MAX_TEMPERATURE);
+	Test_ReceiveValue(LINK_TOPIC_EMERGENCY, LOGIC_HIGH);
+	g_callBacks = 0;
+
+	/* Above the Max_Value of their topic: counted, never cached or given to the Call Back */
+	Test_ReceiveValue(LINK_TOPIC_TEMPERATURE, LINK_MAX_TEMPERATURE + 1);
+	Test_ReceiveValue(LINK_TOPIC_EMERGENCY, 2);
+	Test_ReceiveValue(LINK_TOPIC_HEARTBEAT, 0xFFFF);
+
+	TEST_CHECK_EQUAL(g_callBacks, 0);
+	TEST_CHECK(Link_GetValue(LINK_TOPIC_TEMPERATURE, &Value) == TRUE);
+	TEST_CHECK_EQUAL(Value, LINK_MAX_TEMPERATURE);
+	TEST_CHECK(Link_GetValue(LINK_TOPIC_EMERGENCY, &Value) == TRUE);
+	TEST_CHECK_EQUAL(Value, LOGIC_HIGH);
+	TEST_CHECK(Link_GetValue(LINK_TOPIC_HEARTBEAT, &Value) == FALSE);
+
+	Link_GetStatistics(&Stats);
+	TEST_CHECK_EQUAL(Stats.Bad_Values, 3);
+	TEST_CHECK_EQUAL(Stats.Crc_Errors, 0);
+}
+
+static void Test_ZonesOutOfRange(void)
+{
+	/* 2 zones, hottest zone 1, MAX = 151.0 C */
+	const uint8 Hot[LINK_ZONES_HEADER_SIZE + 2] = {2, 1, 0xE6, 0x05, 0x10, 0x02, 30, 151};
+	Link_ZonesType Zones;
+	Link_StatisticsType Stats;
+	uint16 Value;
+
+	Test_Setup();
+
+	Test_ReceiveFrame(LINK_SENSOR_NODE_ADDRESS, LINK_ZONES_TOPIC, Hot, sizeof(Hot));
+
+	/* The summary goes with its temperature */
+	TEST_CHECK(Link_GetZones(&Zones) == FALSE);
+	TEST_CHECK(Link_GetValue(LINK_TOPIC_TEMPERATURE, &Value) == FALSE);
+	Link_GetStatistics(&Stats);
+	TEST_CHECK_EQUAL(Stats.Bad_Values, 1);
+}
+
+static void Test_Lengths(void)
+{
+	/* 9 zones, more than LINK_MAX_ZONES */
+	const uint8 Too_Many_Zones[LINK_ZONES_HEADER_SIZE + 9] = {9, 0, 0xFA, 0x00, 0xFA, 0x00, 25, 25, 25, 25, 25, 25, 25, 25, 25};
+	/* The hottest zone is not one of the zones */
+	const uint8 Bad_Max_Zone[LINK_ZONES_HEADER_SIZE + 2] = {2, 2, 0xFA, 0x00, 0xFA, 0x00, 25, 25};
+	/* The zone count does not match LEN */
+	const uint8 Short_Zones[LINK_ZONES_HEADER_SIZE + 1] = {2, 0, 0xFA, 0x00, 0xFA, 0x00, 25};
+	const uint8 Payload[3] = {30, 0, 0};
+	Link_StatisticsType Stats;
+	uint16 Value;
+
+	Test_Setup();
+
+	/* A value needs LEN = 2, the emergency frame LEN = 1 */
+	Test_ReceiveFrame(LINK_SENSOR_NODE_ADDRESS, LINK_TOPIC_TEMPERATURE, Payload, 3);
+	Test_ReceiveFrame(LINK_SENSOR_NODE_ADDRESS, LINK_TOPIC_TEMPERATURE, Payload, 1);
+	Test_ReceiveFrame(LINK_SENSOR_NODE_ADDRESS, LINK_EMERGENCY_TOPIC, Payload, 2);
+	Test_ReceiveFrame(LINK_SENSOR_NODE_ADDRESS, LINK_ZONES_TOPIC, Too_Many_Zones, sizeof(Too_Many_Zones));
+	Test_ReceiveFrame(LINK_SENSOR_NODE_ADDRESS, LINK_ZONES_TOPIC, Bad_Max_Zone, sizeof(Bad_Max_Zone));
+	Test_ReceiveFrame(LINK_SENSOR_NODE_ADDRESS, LINK_ZONES_TOPIC, Short_Zones, sizeof(Short_Zones));
+
+	TEST_CHECK_EQUAL(g_callBacks, 0);
+	TEST_CHECK(Link_GetValue(LINK_TOPIC_TEMPERATURE, &Value) == FALSE);
+	TEST_CHECK(Link_GetValue(LINK_TOPIC_EMERGENCY, &Value) == FALSE);
+	Link_GetStatistics(&Stats);
+	TEST_CHECK_EQUAL(Stats.Bad_Values, 6);
+	TEST_CHECK_EQUAL(Stats.Received_Frames, 6);
+}
+
+static void Test_LengthAboveMax(void)
+{
+	Link_StatisticsType Stats;
+	uint16 Value = 0;
+
+	Test_Setup();
+
+	/* LEN above LINK_MAX_PAYLOAD: the frame is dropped at LEN and the payload is not stored */
+	Test_ReceivePartialFrame(LINK_SENSOR_NODE_ADDRESS, LINK_TOPIC_TEMPERATURE, LINK_MAX_PAYLOAD + 1, NULL_PTR, 0, 5);
+	TEST_CHECK_EQUAL(UART_Available(), 0);
+
+	/* Its data bytes do not start a frame without a SOF, the next frame is received */
+	Test_ReceiveCharacter(0x22, 0);
+	Test_ReceiveCharacter(0x00, 0);
+	Test_ReceiveValue(LINK_TOPIC_TEMPERATURE, 34);
+
+	TEST_CHECK(Link_GetValue(LINK_TOPIC_TEMPERATURE, &Value) == TRUE);
+	TEST_CHECK_EQUAL(Value, 34);
+	Link_GetStatistics(&Stats);
+	TEST_CHECK_EQUAL(Stats.Received_Frames, 1);
+	TEST_CHECK_EQUAL(Stats.Crc_Errors, 0);
+	TEST_CHECK_EQUAL(Stats.Bad_Values, 0);
+}
+
+static void Test_Resync(void)
+{
+	const uint8 Payload[2] = {45, 0};
+	Link_StatisticsType Stats;
+	uint16 Value = 0;
+
+	Test_Setup();
+
+	/* The end of a frame is lost: the address of the next frame starts it again */
+	Test_ReceivePartialFrame(LINK_SENSOR_NODE_ADDRESS, LINK_TOPIC_TEMPERATURE, 2, Payload, 2, 6);
+	Test_ReceiveValue(LINK_TOPIC_TEMPERATURE, 36);
+
+	TEST_CHECK(Link_GetValue(LINK_TOPIC_TEMPERATURE, &Value) == TRUE);
+	TEST_CHECK_EQUAL(Value, 36);
+	TEST_CHECK_EQUAL(g_callBacks, 1);
+	Link_GetStatistics(&Stats);
+	TEST_CHECK_EQUAL(Stats.Broken_Frames, 1);
+	TEST_CHECK_EQUAL(Stats.Received_Frames, 1);
+	TEST_CHECK_EQUAL(Stats.Crc_Errors, 0);
+
+	/* An address between two frames is not a broken frame */
+	Test_ReceiveValue(LINK_TOPIC_TEMPERATURE, 37);
+	Link_GetStatistics(&Stats);
+	TEST_CHECK_EQUAL(Stats.Broken_Frames, 1);
+	TEST_CHECK_EQUAL(Stats.Received_Frames, 2);
+}
+
+static void Test_BadBytes(void)
+{
+	const uint8 Payload[2] = {50, 0};
+	Link_StatisticsType Stats;
+	uint16 Value = 0;
+
+	Test_Setup();
+
+	/* A framing error in the payload drops the frame */
+	Test_ReceivePartialFrame(LINK_SENSOR_NODE_ADDRESS, LINK_TOPIC_TEMPERATURE, 2, Payload, 2, 5);
+	Test_ReceiveCharacter(50, UART_STATUS_FRAME_ERROR);
+	Test_ReceiveCharacter(0, 0);
+	Test_ReceiveCharacter(0x5A, 0);
+
+	/* A wrong CRC drops the frame */
+	Test_ReceivePartialFrame(LINK_SENSOR_NODE_ADDRESS, LINK_TOPIC_TEMPERATURE, 2, Payload, 2, 7);
+	Test_ReceiveCharacter(0x00, 0);
+
+	TEST_CHECK(Link_GetValue(LINK_TOPIC_TEMPERATURE, &Value) == FALSE);
+	TEST_CHECK_EQUAL(g_callBacks, 0);
+
+	Test_ReceiveValue(LINK_TOPIC_TEMPERATURE, 38);
+	TEST_CHECK(Link_GetValue(LINK_TOPIC_TEMPERATURE, &Value) == TRUE);
+	TEST_CHECK_EQUAL(Value, 38);
+
+	Link_GetStatistics(&Stats);
+	TEST_CHECK_EQUAL(Stats.Bad_Bytes, 1);
+	TEST_CHECK_EQUAL(Stats.Crc_Errors, 1);
+	TEST_CHECK_EQUAL(Stats.Broken_Frames, 0);
+	TEST_CHECK_EQUAL(Stats.Received_Frames, 1);
+}
+
+static void Test_OtherNode(void)
+{
+	uint16 Value = 0;
+
+	Test_Setup();
+
+	/* The frames to another node are dropped by the address filter */
+	Test_ReceiveCharacter(TEST_ADDRESS | (TEST_NODE_ADDRESS + 1), 0);
+	Test_ReceiveCharacter(LINK_SOF, 0);
+	Test_ReceiveCharacter(LINK_SENSOR_NODE_ADDRESS, 0);
+	TEST_CHECK_EQUAL(UART_Available(), 0);
+
+	Test_ReceiveValue(LINK_TOPIC_TEMPERATURE, 39);
+	TEST_CHECK(Link_GetValue(LINK_TOPIC_TEMPERATURE, &Value) == TRUE);
+	TEST_CHECK_EQUAL(Value, 39);
+}
+
+static void Test_AliveNodes(void)
+{
+	const uint8 Heartbeat[2] = {LINK_UP, 0};
+	const uint8 Fan_On[2] = {70, 0};
+	uint8 Payload[LINK_MAX_PAYLOAD];
+	uint8 Source;
+
+	Test_SetupNode(&g_sensorConfig);
+	TEST_CHECK_EQUAL(Link_GetAliveNodes(), 0);
+
+	/* Node 0 has not been heard yet: a NAK goes before its poll, it does not answer */
+	Mock_AdvanceTicks(TEST_POLL_PERIOD_MS);
+	Link_Poll();
+	Test_TakeSent();
+	TEST_CHECK_EQUAL(Test_FindSent(LINK_ACTUATOR_BASE_ADDRESS, LINK_NAK_TOPIC, &Source, Payload), 0);
+	TEST_CHECK_EQUAL(Test_FindSent(LINK_ACTUATOR_BASE_ADDRESS, LINK_POLL_TOPIC, &Source, Payload), 0);
+	TEST_CHECK_EQUAL(Source, LINK_SENSOR_NODE_ADDRESS);
+
+	/* Node 1 gets the turn after the timeout, its heartbeat ends the turn and shows it is alive */
+	Mock_AdvanceTicks(LINK_POLL_TIMEOUT_MS);
+	Link_Poll();
+	Test_TakeSent();
+	TEST_CHECK_EQUAL(Test_FindSent(LINK_ACTUATOR_BASE_ADDRESS + 1, LINK_POLL_TOPIC, &Source, Payload), 0);
+	Test_ReceiveFrame(LINK_ACTUATOR_BASE_ADDRESS + 1, LINK_TOPIC_HEARTBEAT, Heartbeat, 2);
+	TEST_CHECK_EQUAL(Link_GetAliveNodes(), 0x02);
+
+	/* The service PC does not answer, node 0 answers its next turn */
+	Mock_AdvanceTicks(TEST_POLL_PERIOD_MS);
+	Link_Poll();
+	Mock_AdvanceTicks(LINK_POLL_TIMEOUT_MS);
+	Link_Poll();
+	Test_ReceiveFrame(LINK_ACTUATOR_BASE_ADDRESS, LINK_TOPIC_FAN_STATE, Fan_On, 2);
+	TEST_CHECK_EQUAL(g_lastSource, LINK_ACTUATOR_BASE_ADDRESS);
+	Test_ReceiveFrame(LINK_ACTUATOR_BASE_ADDRESS, LINK_TOPIC_HEARTBEAT, Heartbeat, 2);
+	TEST_CHECK_EQUAL(Link_GetAliveNodes(), 0x03);
+
+	/* An alive node is polled without a NAK */
+	Mock_ClearLog();
+	Mock_AdvanceTicks(TEST_POLL_PERIOD_MS);
+	Link_Poll();
+	Test_TakeSent();
+	TEST_CHECK_EQUAL(Test_FindSent(LINK_ACTUATOR_BASE_ADDRESS + 1, LINK_NAK_TOPIC, &Source, Payload), 0xFF);
+	TEST_CHECK_EQUAL(Test_FindSent(LINK_ACTUATOR_BASE_ADDRESS + 1, LINK_POLL_TOPIC, &Source, Payload), 0);
+
+	/* Node 1 dies while node 0 keeps the link up: node 1 is dead after its turn */
+	Mock_AdvanceTicks(LINK_POLL_TIMEOUT_MS);
+	Link_Poll();
+	TEST_CHECK_EQUAL(Link_GetAliveNodes(), 0x01);
+	TEST_CHECK_EQUAL(Link_GetState(), LINK_UP);
+
+	/* Without any frame the link is lost and no node is alive */
+	Mock_AdvanceTicks(LINK_TIMEOUT_MS);
+	Link_Poll();
+	TEST_CHECK_EQUAL(Link_GetState(), LINK_DOWN);
+	TEST_CHECK_EQUAL(Link_GetAliveNodes(), 0);
+}
+
+static void Test_ServiceTurn(void)
+{
+	const uint8 Heartbeat[2] = {LINK_UP, 0};
+	uint8 Payload[LINK_MAX_PAYLOAD];
+	uint8 Source;
+	uint8 Node;
+
+	Test_SetupNode(&g_sensorConfig);
+
+	/* The actuator nodes answer their turns */
+	for (Node = 0; Node < TEST_NUM_OF_POLLED_NODES; Node++)
+	{
+		Mock_AdvanceTicks(TEST_POLL_PERIOD_MS);
+		Link_Poll();
+		Test_ReceiveFrame(LINK_ACTUATOR_BASE_ADDRESS + Node, LINK_TOPIC_HEARTBEAT, Heartbeat, 2);
+	}
+
+	/* Then the service PC has the turn, it is never sent a NAK */
+	Mock_ClearLog();
+	Mock_AdvanceTicks(TEST_POLL_PERIOD_MS);
+	Link_Poll();
+	Test_TakeSent();
+	TEST_CHECK_EQUAL(Test_FindSent(LINK_SERVICE_ADDRESS, LINK_POLL_TOPIC, &Source, Payload), 0);
+	TEST_CHECK_EQUAL(Test_FindSent(LINK_SERVICE_ADDRESS, LINK_NAK_TOPIC, &Source, Payload), 0xFF);
+
+	/* The turn is kept until the heartbeat of the service PC */
+	Mock_AdvanceTicks(TEST_POLL_PERIOD_MS);
+	Link_Poll();
+	Test_TakeSent();
+	TEST_CHECK_EQUAL(Test_FindSent(LINK_ACTUATOR_BASE_ADDRESS, LINK_POLL_TOPIC, &Source, Payload), 0xFF);
+
+	Test_ReceiveFrame(LINK_SERVICE_ADDRESS, LINK_TOPIC_HEARTBEAT, Heartbeat, 2);
+	Test_TakeSent();
+	TEST_CHECK_EQUAL(Test_FindSent(LINK_ACTUATOR_BASE_ADDRESS, LINK_NAK_TOPIC, &Source, Payload), 0xFF);
+	TEST_CHECK_EQUAL(Test_FindSent(LINK_ACTUATOR_BASE_ADDRESS, LINK_POLL_TOPIC, &Source, Payload), 0);
+	TEST_CHECK_EQUAL(Link_GetAliveNodes(), 0x03);
+}
+
+/* Give all the characters taken by Test_TakeSent to the receiver of the node under test */
+static void Test_ReceiveSent(void)
+{
+	uint16 Characters[TEST_MAX_SENT];
+	uint8 Count = g_sentCount;
+	uint8 i;
+
+	for (i = 0; i < Count; i++)
+	{
+		Characters[i] = g_sent[i];
+	}
+
+	for (i = 0; i < Count; i++)
+	{
+		Test_ReceiveCharacter(Characters[i], 0);
+	}
+}
+
+static void Test_ForwardSet(void)
+{
+	const uint8 Forward[5] = {LINK_ACTUATOR_BASE_ADDRESS, CONFIG_COMMAND_SET, CONFIG_FAN_SPEED_THRESHOLD, 0x20, 0x03};
+	const uint8 Not_Polled[3] = {LINK_ACTUATOR_BASE_ADDRESS + TEST_NUM_OF_POLLED_NODES, CONFIG_COMMAND_GET, 0};
+	uint8 Payload[LINK_MAX_PAYLOAD];
+	uint8 Source;
+	Link_StatisticsType Stats;
+
+	Config_RestoreDefaults();
+
+	/* Sensor node: the service PC asks in its turn to set the fan threshold of node 0 to 800 */
+	Test_SetupNode(&g_sensorConfig);
+	Test_ReceiveFrame(LINK_SERVICE_ADDRESS, LINK_FORWARD_TOPIC, Forward, sizeof(Forward));
+	Test_TakeSent();
+	TEST_CHECK_EQUAL(Test_FindSent(LINK_ACTUATOR_BASE_ADDRESS, LINK_COMMAND_TOPIC, &Source, Payload), 4);
+	TEST_CHECK_EQUAL(Source, LINK_SERVICE_ADDRESS);
+	TEST_CHECK_EQUAL(Payload[0], CONFIG_COMMAND_SET);
+	TEST_CHECK_EQUAL(Payload[1], CONFIG_FAN_SPEED_THRESHOLD);
+	TEST_CHECK_EQUAL(Payload[2] | (Payload[3] << 8), 800);
+
+	/* Actuator node: the command is applied at once */
+	Test_SetupNode(&g_linkConfig);
+	Link_SetCommandCallBack(Test_CommandCallBack);
+	Test_ReceiveSent();
+	TEST_CHECK_EQUAL(CONFIG_VALUE(CONFIG_FAN_SPEED_THRESHOLD), 800);
+
+	/* Its reply waits for its turn and goes to the sensor node */
+	Test_TakeSent();
+	TEST_CHECK_EQUAL(g_sentCount, 0);
+	Test_ReceiveFrame(LINK_SENSOR_NODE_ADDRESS, LINK_POLL_TOPIC, NULL_PTR, 0);
+	Test_TakeSent();
+	TEST_CHECK_EQUAL(Test_FindSent(LINK_SENSOR_NODE_ADDRESS, LINK_REPLY_TOPIC, &Source, Payload), 5);
+	TEST_CHECK_EQUAL(Source, LINK_ACTUATOR_BASE_ADDRESS);
+
+	/* Sensor node: the reply goes on to the service PC with the address of the actuator node */
+	Test_SetupNode(&g_sensorConfig);
+	Test_ReceiveSent();
+	Test_TakeSent();
+	TEST_CHECK_EQUAL(Test_FindSent(LINK_SERVICE_ADDRESS, LINK_REPLY_TOPIC, &Source, Payload), 5);
+	TEST_CHECK_EQUAL(Source, LINK_ACTUATOR_BASE_ADDRESS);
+	TEST_CHECK_EQUAL(Payload[0], CONFIG_COMMAND_SET);
+	TEST_CHECK_EQUAL(Payload[1], CONFIG_FAN_SPEED_THRESHOLD);
+	TEST_CHECK_EQUAL(Payload[2] | (Payload[3] << 8), 800);
+	TEST_CHECK_EQUAL(Payload[4], CONFIG_STATUS_OK);
+
+	/* A node which is not polled is not sent the command */
+	Test_ReceiveFrame(LINK_SERVICE_ADDRESS, LINK_FORWARD_TOPIC, Not_Polled, sizeof(Not_Polled));
+	Test_TakeSent();
+	TEST_CHECK_EQUAL(Test_FindSent(LINK_ACTUATOR_BASE_ADDRESS + TEST_NUM_OF_POLLED_NODES, LINK_COMMAND_TOPIC, &Source, Payload), 0xFF);
+	Link_GetStatistics(&Stats);
+	TEST_CHECK_EQUAL(Stats.Bad_Values, 1);
+
+	Config_RestoreDefaults();
+}
+
+int main(void)
+{
+	Test_Run("LINK value frame", Test_ValueFrame);
+	Test_Run("LINK max value", Test_MaxValue);
+	Test_Run("LINK zones out of range", Test_ZonesOutOfRange);
+	Test_Run("LINK lengths", Test_Lengths);
+	Test_Run("LINK length above max", Test_LengthAboveMax);
+	Test_Run("LINK resync", Test_Resync);
+	Test_Run("LINK bad bytes", Test_BadBytes);
+	Test_Run("LINK other node", Test_OtherNode);
+	Test_Run("LINK alive nodes", Test_AliveNodes);
+	Test_Run("LINK service turn", Test_ServiceTurn);
+	Test_Run("LINK forwarded SET", Test_ForwardSet);
+
+	return Test_Summary();
+}
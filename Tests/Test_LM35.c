@@ -0,0 +1,116 @@
+/*******************************************************************************************************************
+ * File Name: Test_LM35.c
+ * Date: 19/10/2026
+ * Driver: LM35 Temperature Sensor Driver Unit Tests
+ * Author: Youssef Zaki
+ ******************************************************************************************************************/
+#include <avr/interrupt.h>
+#include "Test.h"
+#include "LM35.h"
+#include "POWER.h"
+
+/* Digital value of every channel */
+static uint16 g_adcInputs[8];
+
+/* Hardware of the ADC: a started conversion ends at the next wake-up with the ADC interrupt */
+static void Test_AdcHardware(void)
+{
+	uint8 Adcsra = (uint8)Mock_Get(MOCK_ADCSRA);
+
+	if ((Adcsra & (1<<ADSC)) == 0)
+	{
+		return;
+	}
+
+	Mock_Set(MOCK_ADC, g_adcInputs[Mock_Get(MOCK_ADMUX) & 0x07]);
+	Mock_Set(MOCK_ADCSRA, Adcsra & ~(1<<ADSC));
+	ADC_vect();
+}
+
+static void Test_Setup(void)
+{
+	Mock_Set(MOCK_ADMUX, 0x40);
+	Mock_Set(MOCK_ADCSRA, 0x8B);
+	Mock_SetSleepHook(Test_AdcHardware);
+}
+
+static void Test_GetTemperatureTenths(void)
+{
+	Test_Setup();
+
+	/* 1.5 V (150 C) on the 5 V reference */
+	g_adcInputs[LM35_SENSOR_READ_CHANNEL] = 307;
+	TEST_CHECK_EQUAL(LM35_GetTemperatureTenths(), 1500);
+
+	/* The sensor of the board is read */
+	EXPECT_WRITE(ADMUX, 0x40 | LM35_SENSOR_READ_CHANNEL);
+	EXPECT_WRITE(SREG, 0x00);
+	EXPECT_WRITE(ADCSRA, 0xCB);
+	EXPECT_SLEEP(POWER_IDLE);
+	EXPECT_WRITE(SREG, 0x80);
+	TEST_CHECK_LOG();
+
+	g_adcInputs[LM35_SENSOR_READ_CHANNEL] = 41;
+	TEST_CHECK_EQUAL(LM35_GetTemperatureTenths(), 200);
+	TEST_CHECK_EQUAL(LM35_GetTemperature(), 20);
+}
+
+static void Test_Zones(void)
+{
+	static const InputChannel_Select Channels[] = {ADC0, ADC2, ADC5};
+	const LM35_ConfigType Config = {Channels, 3};
+	LM35_SummaryType Summary;
+
+	Test_Setup();
+	g_adcInputs[0] = 100;
+	g_adcInputs[2] = 400;
+	g_adcInputs[5] = 250;
+
+	/* The other pins of PORTA are kept as they are, the last conversion was on ADC2 */
+	Mock_Set(MOCK_DDRA, 0xFF);
+	Mock_Set(MOCK_ADMUX, 0x42);
+
+	LM35_Init(&Config);
+
+	EXPECT_WRITE(DDRA, 0xFE);
+	EXPECT_WRITE(DDRA, 0xFA);
+	EXPECT_WRITE(DDRA, 0xDA);
+	/* The first scan starts from the first zone */
+	EXPECT_WRITE(SREG, 0x00);
+	EXPECT_WRITE(ADMUX, 0x40);
+	EXPECT_WRITE(ADCSRA, 0xCB);
+	EXPECT_WRITE(SREG, 0x80);
+	TEST_CHECK_LOG();
+
+	/* No summary before the scan is completed */
+	TEST_CHECK(LM35_Task() == FALSE);
+	Test_AdcHardware();
+	Test_AdcHardware();
+	TEST_CHECK(LM35_Task() == FALSE);
+	Test_AdcHardware();
+	Mock_ClearLog();
+
+	TEST_CHECK(LM35_Task() == TRUE);
+	LM35_GetSummary(&Summary);
+	TEST_CHECK_EQUAL(Summary.Max, 1955);
+	TEST_CHECK_EQUAL(Summary.Max_Zone, 1);
+	TEST_CHECK_EQUAL(Summary.Mean, 1221);
+	TEST_CHECK_EQUAL(LM35_GetZoneTemperatureTenths(0), 488);
+	TEST_CHECK_EQUAL(LM35_GetZoneTemperatureTenths(2), 1221);
+
+	/* The next scan is started at once */
+	EXPECT_WRITE(SREG, 0x00);
+	EXPECT_WRITE(ADMUX, 0x40);
+	EXPECT_WRITE(ADCSRA, 0xCB);
+	EXPECT_WRITE(SREG, 0x80);
+	TEST_CHECK_LOG();
+	TEST_CHECK(LM35_Task() == FALSE);
+}
+
+int main(void)
+{
+	Test_Run("LM35 temperature tenths", Test_GetTemperatureTenths);
+	Test_Run("LM35 zones", Test_Zones);
+
+	return Test_Summary();
+}
@@ -0,0 +1,209 @@
+/*******************************************************************************************************************
+ * File Name: Test_LOGGER.c
+ * Date: 19/10/2026
+ * Driver: EEPROM History Log Unit Tests (records written through the EEPROM write queue, decoded back)
+ * Author: Youssef Zaki
+ ******************************************************************************************************************/
+#include <avr/interrupt.h>
+#include "Test.h"
+#include "EEPROM.h"
+#include "LOGGER.h"
+
+#define TEST_SAMPLE_PERIOD_MS                10
+
+/* Samples offered by the tests, the steps are all different so a delta decoded from the wrong sample is seen */
+#define TEST_NUM_OF_SAMPLES                  48
+#define TEST_FIRST_SAMPLE                    20
+
+/* EEPROM writes allowed to empty the write queue, more means it never ends */
+#define TEST_MAX_EEPROM_STEPS                256
+
+static const Logger_ConfigType g_loggerConfig = {TEST_SAMPLE_PERIOD_MS};
+static const uint8 g_testSteps[] = {1, 4, 2, 6, 3, 5, 7};
+
+static uint8 g_testSamples[TEST_NUM_OF_SAMPLES];
+
+/* EEPROM hardware: a started write ends, then the EE_RDY interrupt fires while it is enabled */
+static void Test_EepromHardware(void)
+{
+	uint8 Eecr = (uint8)Mock_Get(MOCK_EECR);
+
+	if (Eecr & (1<<EEWE))
+	{
+		Mock_Set(MOCK_EECR, Eecr & ~((1<<EEWE) | (1<<EEMWE)));
+	}
+	else if (Eecr & (1<<EERIE))
+	{
+		EE_RDY_vect();
+	}
+}
+
+/* Let the EEPROM write every queued byte */
+static void Test_EndWrites(void)
+{
+	uint16 Steps = 0;
+
+	while ((EEPROM_IsBusy() == TRUE) && (Steps < TEST_MAX_EEPROM_STEPS))
+	{
+		Test_EepromHardware();
+		Steps++;
+	}
+	TEST_CHECK(EEPROM_IsBusy() == FALSE);
+}
+
+static void Test_Setup(void)
+{
+	uint8 Sample;
+
+	g_testSamples[0] = TEST_FIRST_SAMPLE;
+	for (Sample = 1; Sample < TEST_NUM_OF_SAMPLES; Sample++)
+	{
+		g_testSamples[Sample] = g_testSamples[Sample - 1] + g_testSteps[Sample % sizeof(g_testSteps)];
+	}
+
+	Mock_SetSleepHook(Test_EepromHardware);
+	Logger_Init(&g_loggerConfig);
+}
+
+/* Offer one sample and let the SysTick reach the next sample time */
+static void Test_Sample(uint8 Sample)
+{
+	Logger_Sample(g_testSamples[Sample]);
+	Mock_AdvanceTicks(TEST_SAMPLE_PERIOD_MS);
+}
+
+/* Place of a temperature in g_testSamples, TEST_NUM_OF_SAMPLES if it was never offered */
+static uint8 Test_FindSample(uint8 Temperature)
+{
+	uint8 Sample;
+
+	for (Sample = 0; (Sample < TEST_NUM_OF_SAMPLES) && (g_testSamples[Sample] != Temperature); Sample++)
+	{
+	}
+
+	return Sample;
+}
+
+/*
+ * Decode the log like Tools/log_decode.py and check every sample: an absolute one must be an offered
+ * sample, a delta one must be the sample offered right after the previous decoded one.
+ * Return the number of decoded samples, the last one in Last_Ptr.
+ */
+static uint16 Test_DecodeLog(uint8 *Last_Ptr)
+{
+	uint8 Record[LOGGER_RECORD_SIZE];
+	uint8 Deltas[2];
+	uint8 Delta;
+	uint8 Sample = TEST_NUM_OF_SAMPLES;
+	uint16 Decoded = 0;
+	uint16 Index;
+	boolean Have_Temperature = FALSE;
+	uint8 Temperature = 0;
+
+	for (Index = 0; Index < Logger_GetCount(); Index++)
+	{
+		TEST_CHECK(Logger_ReadRecord(Index, Record) == TRUE);
+
+		switch (Record[0] & LOGGER_TYPE_MASK)
+		{
+		case LOGGER_TYPE_ABSOLUTE:
+			Temperature = Record[1];
+			Have_Temperature = TRUE;
+			Sample = Test_FindSample(Temperature);
+			TEST_CHECK(Sample < TEST_NUM_OF_SAMPLES);
+			Decoded++;
+			break;
+
+		case LOGGER_TYPE_DELTA:
+			Deltas[0] = Record[1] >> 4;
+			Deltas[1] = Record[1] & 0x0F;
+			for (Delta = 0; Delta < 2; Delta++)
+			{
+				if (Deltas[Delta] == LOGGER_DELTA_NONE)
+				{
+					continue;
+				}
+				TEST_CHECK(Have_Temperature == TRUE);
+
+				Temperature += (Deltas[Delta] & 0x08) ? (sint8)(Deltas[Delta] - 16) : (sint8)Deltas[Delta];
+				TEST_CHECK((Sample + 1 < TEST_NUM_OF_SAMPLES) && (g_testSamples[Sample + 1] == Temperature));
+				Sample++;
+				Decoded++;
+			}
+			break;
+
+		case LOGGER_TYPE_EVENT:
+			TEST_CHECK_EQUAL(Record[1], LOGGER_EVENT_BOOT);
+			break;
+
+		default:
+			TEST_CHECK(FALSE);
+			break;
+		}
+	}
+
+	*Last_Ptr = Temperature;
+	return Decoded;
+}
+
+static void Test_Deltas(void)
+{
+	uint8 Sample;
+	uint8 Last;
+
+	Test_Setup();
+
+	for (Sample = 0; Sample < TEST_NUM_OF_SAMPLES; Sample++)
+	{
+		Test_Sample(Sample);
+		Test_EndWrites();
+	}
+	/* The last delta is still in RAM, an event writes it */
+	Logger_Event(LOGGER_EVENT_BOOT);
+
+	TEST_CHECK_EQUAL(Logger_GetDropped(), 0);
+	TEST_CHECK_EQUAL(Test_DecodeLog(&Last), TEST_NUM_OF_SAMPLES);
+	TEST_CHECK_EQUAL(Last, g_testSamples[TEST_NUM_OF_SAMPLES - 1]);
+}
+
+static void Test_FullQueue(void)
+{
+	/* Samples offered without any EEPROM write in between, the queue fills at different places of the pairs */
+	static const uint8 Bursts[] = {13, 2, 9, 1, 11, 4};
+	uint8 Burst;
+	uint8 Sample = 0;
+	uint8 Count;
+	uint8 Last;
+
+	Test_Setup();
+
+	for (Burst = 0; Burst < sizeof(Bursts); Burst++)
+	{
+		for (Count = 0; Count < Bursts[Burst]; Count++)
+		{
+			Test_Sample(Sample);
+			Sample++;
+		}
+		Test_EndWrites();
+	}
+	while (Sample < TEST_NUM_OF_SAMPLES)
+	{
+		Test_Sample(Sample);
+		Test_EndWrites();
+		Sample++;
+	}
+	Logger_Event(LOGGER_EVENT_BOOT);
+
+	/* Samples are lost, but every decoded one is right and the newest one is in the log */
+	TEST_CHECK(Logger_GetDropped() != 0);
+	TEST_CHECK(Test_DecodeLog(&Last) < TEST_NUM_OF_SAMPLES);
+	TEST_CHECK_EQUAL(Last, g_testSamples[TEST_NUM_OF_SAMPLES - 1]);
+}
+
+int main(void)
+{
+	Test_Run("LOGGER deltas", Test_Deltas);
+	Test_Run("LOGGER full queue", Test_FullQueue);
+
+	return Test_Summary();
+}
@@ -0,0 +1,164 @@
+/*******************************************************************************************************************
+ * File Name: Test_TIMER1.c
+ * Date: 19/10/2026
+ * Driver: TIMER1 Driver Unit Tests
+ * Author: Youssef Zaki
+ ******************************************************************************************************************/
+#include <avr/interrupt.h>
+#include "Test.h"
+#include "TIMER1.h"
+
+static uint8 g_callBacks = 0;
+
+static void Test_CallBack(void)
+{
+	g_callBacks++;
+}
+
+static void Test_FastPwm10Bit(void)
+{
+	const Timer1_ConfigType Config = {5, 0, TIMER1_Prescaler_8, TIMER1_Fast_Pwm_10_Bit_7};
+
+	Mock_Set(MOCK_TCCR1A, (1<<FOC1A) | (1<<FOC1B));
+
+	Timer1_PWM_Mode_Init(&Config);
+
+	EXPECT_WRITE(TCNT1, 5);
+	EXPECT_WRITE(TCCR1A, 0x04);
+	EXPECT_WRITE(TCCR1A, 0x00);
+	EXPECT_WRITE(TCCR1B, 0x02);
+	/* OC1A (PD5) is an output */
+	EXPECT_WRITE(DDRD, 0x20);
+	/* WGM13:0 = 0111, COM1A1:0 = 10 (non-inverting) */
+	EXPECT_WRITE(TCCR1A, 0x01);
+	EXPECT_WRITE(TCCR1A, 0x03);
+	EXPECT_WRITE(TCCR1B, 0x0A);
+	EXPECT_WRITE(TCCR1A, 0x83);
+	TEST_CHECK_LOG();
+}
+
+static void Test_FastPwmIcr1FromOldMode(void)
+{
+	const Timer1_ConfigType Config = {0, 0, TIMER1_Prescaler_1, TIMER1_Fast_PWM_14};
+
+	/* Another mode was configured before: its WGM and COM1A bits must be cleared, COM1B kept */
+	Mock_Set(MOCK_TCNT1, 0x1234);
+	Mock_Set(MOCK_TCCR1A, 0xF3);
+	Mock_Set(MOCK_TCCR1B, 0x1F);
+
+	Timer1_PWM_Mode_Init(&Config);
+
+	EXPECT_WRITE(TCNT1, 0);
+	EXPECT_WRITE(TCCR1B, 0x19);
+	EXPECT_WRITE(DDRD, 0x20);
+	EXPECT_WRITE(TCCR1A, 0x30);
+	EXPECT_WRITE(TCCR1B, 0x01);
+	/* WGM13:0 = 1110 */
+	EXPECT_WRITE(TCCR1A, 0x32);
+	EXPECT_WRITE(TCCR1B, 0x09);
+	EXPECT_WRITE(TCCR1B, 0x19);
+	EXPECT_WRITE(TCCR1A, 0xB2);
+	TEST_CHECK_LOG();
+}
+
+static void Test_PhaseCorrect8Bit(void)
+{
+	const Timer1_ConfigType Config = {0, 0, TIMER1_Prescaler_64, TIMER1_PWM_Phase_Correct_8_Bit_1};
+
+	Timer1_PWM_Mode_Init(&Config);
+
+	EXPECT_WRITE(TCCR1B, 0x03);
+	EXPECT_WRITE(DDRD, 0x20);
+	EXPECT_WRITE(TCCR1A, 0x01);
+	EXPECT_WRITE(TCCR1A, 0x81);
+	TEST_CHECK_LOG();
+}
+
+static void Test_PwmStart(void)
+{
+	TIMER1_PWM_Start(300);
+
+	/* TOP first, then the compare value */
+	EXPECT_WRITE(ICR1, 2499);
+	EXPECT_WRITE(OCR1A, 300);
+	TEST_CHECK_LOG();
+}
+
+static void Test_Ctc(void)
+{
+	const Timer1_ConfigType Config = {10, 999, TIMER1_Prescaler_64, TIMER1_CTC_4};
+
+	/* The Timer0 interrupt bits are kept */
+	Mock_Set(MOCK_TIMSK, (1<<OCIE0) | (1<<TOIE0));
+
+	Timer1_NonPWm_Mode_Init(&Config);
+
+	EXPECT_WRITE(TCNT1, 10);
+	EXPECT_WRITE(TCCR1A, 0x0C);
+	EXPECT_WRITE(TCCR1B, 0x03);
+	EXPECT_WRITE(OCR1A, 999);
+	EXPECT_WRITE(TCCR1B, 0x0B);
+	EXPECT_WRITE(TIMSK, 0x13);
+	TEST_CHECK_LOG();
+}
+
+static void Test_Normal(void)
+{
+	const Timer1_ConfigType Config = {0, 0, TIMER1_Prescaler_1024, TIMER1_Normal_0};
+
+	/* CTC was configured before */
+	Mock_Set(MOCK_TCNT1, 7);
+	Mock_Set(MOCK_TCCR1B, 0x0B);
+
+	Timer1_NonPWm_Mode_Init(&Config);
+
+	EXPECT_WRITE(TCNT1, 0);
+	EXPECT_WRITE(TCCR1A, 0x0C);
+	EXPECT_WRITE(TCCR1B, 0x0D);
+	EXPECT_WRITE(TCCR1B, 0x05);
+	EXPECT_WRITE(TIMSK, 0x10);
+	TEST_CHECK_LOG();
+}
+
+static void Test_DeInit(void)
+{
+	Mock_Set(MOCK_TCCR1A, 0x83);
+	Mock_Set(MOCK_TCCR1B, 0x0A);
+	Mock_Set(MOCK_TIMSK, 0xFF);
+
+	Timer1_DeInit();
+
+	/* Timer1 stopped, only TICIE1, OCIE1A, OCIE1B and TOIE1 are cleared */
+	EXPECT_WRITE(TCCR1A, 0x00);
+	EXPECT_WRITE(TCCR1B, 0x00);
+	EXPECT_WRITE(TIMSK, 0xC3);
+	TEST_CHECK_LOG();
+}
+
+static void Test_CallBacks(void)
+{
+	/* No call back yet: the interrupts do nothing */
+	TIMER1_OVF_vect();
+	TIMER1_COMPA_vect();
+	TEST_CHECK_EQUAL(g_callBacks, 0);
+
+	Timer1_SetCallBack(Test_CallBack);
+	TIMER1_OVF_vect();
+	TIMER1_COMPA_vect();
+	TEST_CHECK_EQUAL(g_callBacks, 2);
+	TEST_CHECK_LOG();
+}
+
+int main(void)
+{
+	Test_Run("TIMER1 fast PWM 10-bit", Test_FastPwm10Bit);
+	Test_Run("TIMER1 fast PWM ICR1 from another mode", Test_FastPwmIcr1FromOldMode);
+	Test_Run("TIMER1 phase correct PWM 8-bit", Test_PhaseCorrect8Bit);
+	Test_Run("TIMER1 PWM start", Test_PwmStart);
+	Test_Run("TIMER1 CTC", Test_Ctc);
+	Test_Run("TIMER1 normal", Test_Normal);
+	Test_Run("TIMER1 de-init", Test_DeInit);
+	Test_Run("TIMER1 call back", Test_CallBacks);
+
+	return Test_Summary();
+}
@@ -0,0 +1,341 @@
+/*******************************************************************************************************************
+ * File Name: Test_UART.c
+ * Date: 19/10/2026
+ * Driver: UART Driver Unit Tests
+ * Author: Youssef Zaki
+ ******************************************************************************************************************/
+#include <avr/interrupt.h>
+#include "Test.h"
+#include "UART.h"
+#include "POWER.h"
+
+/* 9600 baud at 1 MHz: Double Speed with UBRR = 12 (9615 baud, +0.2%) */
+#define TEST_UBRR                            12
+
+static const UART_ConfigType g_uartLinkConfig = {Asynchronous, Disabled, One_Bit, Nine_Bit_7};
+
+/* Character given by the sleep hook, 0xFFFF for none */
+static uint16 g_uartPendingCharacter;
+
+/*
+ * Receiver hardware: in the Multi-processor Communication Mode the data frames are ignored,
+ * otherwise the character is put in UDR with its flags and RXB8, the RXC interrupt reads it.
+ */
+static void Test_ReceiveCharacter(uint16 Data, uint8 Errors)
+{
+	uint8 Ucsra = (uint8)Mock_Get(MOCK_UCSRA);
+	uint8 Ucsrb = (uint8)Mock_Get(MOCK_UCSRB);
+
+	if ((Ucsra & (1<<MPCM)) && ((Data & 0x0100) == 0))
+	{
+		return;
+	}
+
+	Mock_Set(MOCK_UCSRA, (Ucsra & ~UART_STATUS_ERRORS) | Errors | (1<<RXC));
+	Mock_Set(MOCK_UCSRB, (Data & 0x0100) ? (Ucsrb | (1<<RXB8)) : (Ucsrb & ~(1<<RXB8)));
+	Mock_Set(MOCK_UDR, (uint8)Data);
+
+	USART_RXC_vect();
+
+	/* Reading UDR clears RXC and the flags of the character */
+	Ucsra = (uint8)Mock_Get(MOCK_UCSRA);
+	Mock_Set(MOCK_UCSRA, Ucsra & ~(UART_STATUS_ERRORS | (1<<RXC)));
+}
+
+/* Transmitter hardware: the character in the shift register is sent, UDR is empty again */
+static void Test_TransmitterReady(void)
+{
+	Mock_Set(MOCK_UCSRA, Mock_Get(MOCK_UCSRA) | (1<<UDRE));
+
+	if (Mock_Get(MOCK_UCSRB) & (1<<UDRIE))
+	{
+		USART_UDRE_vect();
+	}
+}
+
+static void Test_DeliverPending(void)
+{
+	if (g_uartPendingCharacter != 0xFFFF)
+	{
+		Test_ReceiveCharacter(g_uartPendingCharacter, 0);
+		g_uartPendingCharacter = 0xFFFF;
+	}
+}
+
+/* UART_Init of the link, then an empty log */
+static void Test_InitLink(void)
+{
+	UART_Init(&g_uartLinkConfig);
+	Mock_ClearLog();
+}
+
+static void Test_InitNineBit(void)
+{
+	UART_Init(&g_uartLinkConfig);
+
+	EXPECT_WRITE(UCSRB, 0x10);
+	EXPECT_WRITE(UCSRB, 0x18);
+	EXPECT_WRITE(UCSRB, 0x98);
+	/* No address filtering, then Double Speed */
+	EXPECT_WRITE(UCSRA, 0x00);
+	EXPECT_WRITE(UCSRA, 0x02);
+	EXPECT_WRITE(UBRRL, TEST_UBRR);
+	/* UCSZ2:0 = 111, UCSZ1:0 are already set after reset */
+	EXPECT_WRITE(UCSRB, 0x9C);
+	TEST_CHECK_LOG();
+
+	TEST_CHECK_EQUAL(Mock_Get(MOCK_UBRRH), 0);
+	TEST_CHECK_EQUAL(Mock_Get(MOCK_UCSRC), 0x86);
+}
+
+static void Test_InitEvenParityTwoStopBits(void)
+{
+	const UART_ConfigType Config = {Asynchronous, Even_Parity, Two_Bits, Eight_Bit_3};
+
+	UART_Init(&Config);
+
+	EXPECT_WRITE(UCSRB, 0x10);
+	EXPECT_WRITE(UCSRB, 0x18);
+	EXPECT_WRITE(UCSRB, 0x98);
+	EXPECT_WRITE(UCSRA, 0x00);
+	EXPECT_WRITE(UCSRA, 0x02);
+	EXPECT_WRITE(UBRRL, TEST_UBRR);
+	/* UPM1:0 = 10, then USBS */
+	EXPECT_WRITE(UCSRC, 0xA6);
+	EXPECT_WRITE(UCSRC, 0xAE);
+	TEST_CHECK_LOG();
+}
+
+static void Test_SetNodeAddress(void)
+{
+	Test_InitLink();
+
+	UART_SetNodeAddress(0x10);
+
+	EXPECT_WRITE(SREG, 0x00);
+	EXPECT_WRITE(UCSRA, 0x03);
+	EXPECT_WRITE(SREG, 0x80);
+	TEST_CHECK_LOG();
+}
+
+static void Test_SendNineBit(void)
+{
+	Test_InitLink();
+	UART_SetNodeAddress(0x10);
+	Mock_ClearLog();
+
+	UART_SendAddress(0x55);
+
+	/* TXB8 before UDR, TXC cleared and MPCM kept with the interrupts disabled */
+	EXPECT_WRITE(SREG, 0x00);
+	EXPECT_WRITE(UCSRB, 0x9D);
+	EXPECT_WRITE(UCSRA, 0x43);
+	EXPECT_WRITE(UDR, 0x55);
+	EXPECT_WRITE(SREG, 0x80);
+	TEST_CHECK_LOG();
+
+	/* Two equal data bytes are two writes of UDR */
+	UART_SendByte(0x7E);
+	UART_SendByte(0x7E);
+
+	EXPECT_WRITE(SREG, 0x00);
+	EXPECT_WRITE(UCSRB, 0x9C);
+	EXPECT_WRITE(UCSRA, 0x43);
+	EXPECT_WRITE(UDR, 0x7E);
+	EXPECT_WRITE(SREG, 0x80);
+	EXPECT_WRITE(SREG, 0x00);
+	EXPECT_WRITE(UCSRA, 0x43);
+	EXPECT_WRITE(UDR, 0x7E);
+	EXPECT_WRITE(SREG, 0x80);
+	TEST_CHECK_LOG();
+}
+
+static void Test_SendWaitsForUdre(void)
+{
+	Test_InitLink();
+	Mock_Set(MOCK_UCSRA, Mock_Get(MOCK_UCSRA) & ~(1<<UDRE));
+	Mock_SetSleepHook(Test_TransmitterReady);
+
+	UART_SendByte(0x41);
+
+	/* Idle sleep with the UDRE interrupt enabled, the interrupt disables itself */
+	EXPECT_WRITE(SREG, 0x00);
+	EXPECT_WRITE(UCSRB, 0xBC);
+	EXPECT_SLEEP(POWER_IDLE);
+	EXPECT_WRITE(UCSRB, 0x9C);
+	EXPECT_WRITE(UCSRA, 0x42);
+	EXPECT_WRITE(UDR, 0x41);
+	EXPECT_WRITE(SREG, 0x80);
+	TEST_CHECK_LOG();
+}
+
+static void Test_Receive(void)
+{
+	UART_ErrorStatisticsType Stats;
+
+	Test_InitLink();
+
+	Test_ReceiveCharacter(0x31, 0);
+	Test_ReceiveCharacter(0x32, UART_STATUS_FRAME_ERROR);
+	Test_ReceiveCharacter(0x33, UART_STATUS_DATA_OVERRUN | UART_STATUS_PARITY_ERROR);
+
+	/* The RXC interrupt writes no register when no address is set */
+	TEST_CHECK_LOG();
+
+	TEST_CHECK_EQUAL(UART_Available(), 3);
+	TEST_CHECK_EQUAL(UART_GetRxStatus(), 0);
+	TEST_CHECK_EQUAL(UART_ReceiveByte(), 0x31);
+	EXPECT_WRITE(SREG, 0x00);
+	EXPECT_WRITE(SREG, 0x80);
+	TEST_CHECK_LOG();
+
+	/* UART_RX_ERROR_TAG: the bytes with an error are kept with their flags */
+	TEST_CHECK_EQUAL(UART_GetRxStatus(), UART_STATUS_FRAME_ERROR);
+	TEST_CHECK_EQUAL(UART_ReceiveByte(), 0x32);
+	TEST_CHECK_EQUAL(UART_GetRxStatus(), UART_STATUS_DATA_OVERRUN | UART_STATUS_PARITY_ERROR);
+	TEST_CHECK_EQUAL(UART_ReceiveNineBit(), 0x33);
+	TEST_CHECK_EQUAL(UART_Available(), 0);
+
+	UART_GetErrorStatistics(&Stats);
+	TEST_CHECK_EQUAL(Stats.Received_Bytes, 3);
+	TEST_CHECK_EQUAL(Stats.Frame_Errors, 1);
+	TEST_CHECK_EQUAL(Stats.Data_Overruns, 1);
+	TEST_CHECK_EQUAL(Stats.Parity_Errors, 1);
+	TEST_CHECK_EQUAL(Stats.Buffer_Overflows, 0);
+}
+
+static void Test_AddressFilter(void)
+{
+	UART_ErrorStatisticsType Stats;
+
+	Test_InitLink();
+	UART_SetNodeAddress(0x10);
+	Mock_ClearLog();
+
+	/* Address of another node: MPCM stays set and the data frames never reach the driver */
+	Test_ReceiveCharacter(0x0111, 0);
+	Test_ReceiveCharacter(0x0055, 0);
+	EXPECT_WRITE(UCSRA, 0x03);
+	TEST_CHECK_LOG();
+	TEST_CHECK_EQUAL(UART_Available(), 0);
+
+	/* Own address: MPCM cleared, the address is buffered with the ninth bit, then the data */
+	Test_ReceiveCharacter(0x0110, 0);
+	Test_ReceiveCharacter(0x007E, 0);
+	EXPECT_WRITE(UCSRA, 0x02);
+	TEST_CHECK_LOG();
+	TEST_CHECK_EQUAL(UART_Available(), 2);
+	TEST_CHECK_EQUAL(UART_GetRxStatus(), UART_STATUS_BIT8);
+	TEST_CHECK_EQUAL(UART_ReceiveNineBit(), 0x0110);
+	TEST_CHECK_EQUAL(UART_ReceiveNineBit(), 0x007E);
+	Mock_ClearLog();
+
+	/* A corrupted own address is not taken */
+	Test_ReceiveCharacter(0x0110, UART_STATUS_FRAME_ERROR);
+	Test_ReceiveCharacter(0x0042, 0);
+	EXPECT_WRITE(UCSRA, 0x03);
+	TEST_CHECK_LOG();
+	TEST_CHECK_EQUAL(UART_Available(), 0);
+
+	/* Broadcast */
+	Test_ReceiveCharacter(0x0100 | UART_BROADCAST_ADDRESS, 0);
+	Test_ReceiveCharacter(0x0043, 0);
+	EXPECT_WRITE(UCSRA, 0x02);
+	TEST_CHECK_LOG();
+	TEST_CHECK_EQUAL(UART_ReceiveNineBit(), 0x0100 | UART_BROADCAST_ADDRESS);
+	TEST_CHECK_EQUAL(UART_ReceiveNineBit(), 0x0043);
+
+	/* The data frames ignored in MPCM are never received by the driver */
+	UART_GetErrorStatistics(&Stats);
+	TEST_CHECK_EQUAL(Stats.Received_Bytes, 6);
+	TEST_CHECK_EQUAL(Stats.Frame_Errors, 1);
+}
+
+static void Test_BufferOverflow(void)
+{
+	UART_ErrorStatisticsType Stats;
+	uint8 i;
+
+	Test_InitLink();
+
+	for (i = 0; i < UART_RX_BUFFER_SIZE + 4; i++)
+	{
+		Test_ReceiveCharacter(i, 0);
+	}
+
+	/* One place is kept free to tell a full buffer from an empty one */
+	TEST_CHECK_EQUAL(UART_Available(), UART_RX_BUFFER_SIZE - 1);
+	UART_GetErrorStatistics(&Stats);
+	TEST_CHECK_EQUAL(Stats.Buffer_Overflows, 5);
+
+	for (i = 0; i < UART_RX_BUFFER_SIZE - 1; i++)
+	{
+		TEST_CHECK_EQUAL(UART_ReceiveByte(), i);
+	}
+}
+
+static void Test_Peek(void)
+{
+	const uint8 *Data_Ptr;
+
+	Test_InitLink();
+
+	Test_ReceiveCharacter(0x0A, 0);
+	Test_ReceiveCharacter(0x0B, 0);
+	Test_ReceiveCharacter(0x0110, 0);
+	Test_ReceiveCharacter(0x0C, 0);
+
+	/* The run of plain bytes stops before the ninth bit */
+	TEST_CHECK_EQUAL(UART_Peek(&Data_Ptr), 2);
+	TEST_CHECK_EQUAL(Data_Ptr[0], 0x0A);
+	TEST_CHECK_EQUAL(Data_Ptr[1], 0x0B);
+	UART_Consume(2);
+
+	TEST_CHECK_EQUAL(UART_Peek(&Data_Ptr), 0);
+	TEST_CHECK_EQUAL(UART_GetRxStatus(), UART_STATUS_BIT8);
+	TEST_CHECK_EQUAL(UART_ReceiveNineBit(), 0x0110);
+	TEST_CHECK_EQUAL(UART_Peek(&Data_Ptr), 1);
+	TEST_CHECK_EQUAL(Data_Ptr[0], 0x0C);
+}
+
+static void Test_ReceiveTimeout(void)
+{
+	uint8 Byte = 0;
+
+	Test_InitLink();
+	g_uartPendingCharacter = 0xFFFF;
+	Mock_SetSleepHook(Test_DeliverPending);
+
+	/* Nothing received: one Idle sleep per SysTick until the timeout */
+	TEST_CHECK(UART_ReceiveByteTimeout(&Byte, 3) == FALSE);
+	EXPECT_WRITE(SREG, 0x00);
+	EXPECT_SLEEP(POWER_IDLE);
+	EXPECT_SLEEP(POWER_IDLE);
+	EXPECT_SLEEP(POWER_IDLE);
+	EXPECT_WRITE(SREG, 0x80);
+	TEST_CHECK_LOG();
+
+	g_uartPendingCharacter = 0x5A;
+	TEST_CHECK(UART_ReceiveByteTimeout(&Byte, 3) == TRUE);
+	TEST_CHECK_EQUAL(Byte, 0x5A);
+	EXPECT_WRITE(SREG, 0x00);
+	EXPECT_SLEEP(POWER_IDLE);
+	EXPECT_WRITE(SREG, 0x80);
+	TEST_CHECK_LOG();
+}
+
+int main(void)
+{
+	Test_Run("UART init 9-bit", Test_InitNineBit);
+	Test_Run("UART init even parity two stop bits", Test_InitEvenParityTwoStopBits);
+	Test_Run("UART set node address", Test_SetNodeAddress);
+	Test_Run("UART send nine bit", Test_SendNineBit);
+	Test_Run("UART send waits for UDRE", Test_SendWaitsForUdre);
+	Test_Run("UART receive", Test_Receive);
+	Test_Run("UART address filter", Test_AddressFilter);
+	Test_Run("UART buffer overflow", Test_BufferOverflow);
+	Test_Run("UART peek", Test_Peek);
+	Test_Run("UART receive timeout", Test_ReceiveTimeout);
+
+	return Test_Summary();
+}
@@ -0,0 +1,27 @@
+/*******************************************************************************************************************
+ * File Name: interrupt.h
+ * Date: 19/10/2026
+ * Driver: Host Mock of <avr/interrupt.h> for the ATmega32 Unit Tests
+ * Author: Youssef Zaki
+ ******************************************************************************************************************/
+#ifndef MOCK_AVR_INTERRUPT_H_
+#define MOCK_AVR_INTERRUPT_H_
+
+#include <avr/io.h>
+
+/* The Global Interrupt Enable bit is written in SREG, so the tests see it in the register log */
+#define sei()                                (SREG |= (1 << SREG_I))
+#define cli()                                (SREG &= (uint8_t)~(1 << SREG_I))
+
+/* An interrupt service routine is a plain function, the tests call it to raise the interrupt */
+#define ISR(VECTOR)                          void VECTOR(void)
+
+/* Vectors of the drivers under test */
+void ADC_vect(void);
+void USART_RXC_vect(void);
+void USART_UDRE_vect(void);
+void TIMER1_OVF_vect(void);
+void TIMER1_COMPA_vect(void);
+void EE_RDY_vect(void);
+
+#endif /* MOCK_AVR_INTERRUPT_H_ */
@@ -0,0 +1,218 @@
+/*******************************************************************************************************************
+ * File Name: io.h
+ * Date: 19/10/2026
+ * Driver: Host Mock of <avr/io.h> for the ATmega32 Unit Tests
+ * Author: Youssef Zaki
+ ******************************************************************************************************************/
+#ifndef MOCK_AVR_IO_H_
+#define MOCK_AVR_IO_H_
+
+#include <stdint.h>
+
+/*******************************************************************************************
+ *                                      Types Declaration                                  *
+ *******************************************************************************************/
+
+/* Registers of the ATmega32 used by the drivers, every one is a cell of Mock_Registers */
+typedef enum
+{
+	MOCK_DDRA, MOCK_DDRB, MOCK_DDRC, MOCK_DDRD,
+	MOCK_PORTA, MOCK_PORTB, MOCK_PORTC, MOCK_PORTD,
+	MOCK_PINA, MOCK_PINB, MOCK_PINC, MOCK_PIND,
+	MOCK_UCSRA, MOCK_UCSRB, MOCK_UCSRC, MOCK_UDR, MOCK_UBRRH, MOCK_UBRRL,
+	MOCK_ADMUX, MOCK_ADCSRA, MOCK_ADC, MOCK_SFIOR,
+	MOCK_TCCR1A, MOCK_TCCR1B, MOCK_TCNT1, MOCK_OCR1A, MOCK_OCR1B, MOCK_ICR1,
+	MOCK_TIMSK, MOCK_TIFR, MOCK_TCCR0, MOCK_TCNT0, MOCK_OCR0,
+	MOCK_EEAR, MOCK_EEDR, MOCK_EECR,
+	MOCK_MCUCR, MOCK_MCUCSR, MOCK_GICR, MOCK_GIFR, MOCK_SREG,
+	MOCK_NUM_OF_REGISTERS
+}Mock_RegisterId;
+
+/*******************************************************************************************
+ *                                      Functions Prototypes                               *
+ *******************************************************************************************/
+
+/*
+ * Description:
+ * Log the writes done since the previous access, then return the cell of the register Id.
+ * Every use of a register name in a driver goes through this function (see Mock.c).
+ */
+volatile void *Mock_Access(Mock_RegisterId Id);
+
+/*******************************************************************************************
+ *                                    Registers Definitions                                *
+ *******************************************************************************************/
+
+/* The cells are 16 bits wide, the 8-bit registers are their low byte */
+#if (__BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__)
+#error "The register mock needs a little endian host"
+#endif
+
+#define MOCK_REGISTER8(ID)                   (*(volatile uint8_t *)Mock_Access(ID))
+#define MOCK_REGISTER16(ID)                  (*(volatile uint16_t *)Mock_Access(ID))
+
+#define DDRA                                 MOCK_REGISTER8(MOCK_DDRA)
+#define DDRB                                 MOCK_REGISTER8(MOCK_DDRB)
+#define DDRC                                 MOCK_REGISTER8(MOCK_DDRC)
+#define DDRD                                 MOCK_REGISTER8(MOCK_DDRD)
+#define PORTA                                MOCK_REGISTER8(MOCK_PORTA)
+#define PORTB                                MOCK_REGISTER8(MOCK_PORTB)
+#define PORTC                                MOCK_REGISTER8(MOCK_PORTC)
+#define PORTD                                MOCK_REGISTER8(MOCK_PORTD)
+#define PINA                                 MOCK_REGISTER8(MOCK_PINA)
+#define PINB                                 MOCK_REGISTER8(MOCK_PINB)
+#define PINC                                 MOCK_REGISTER8(MOCK_PINC)
+#define PIND                                 MOCK_REGISTER8(MOCK_PIND)
+#define UCSRA                                MOCK_REGISTER8(MOCK_UCSRA)
+#define UCSRB                                MOCK_REGISTER8(MOCK_UCSRB)
+#define UCSRC                                MOCK_REGISTER8(MOCK_UCSRC)
+#define UDR                                  MOCK_REGISTER8(MOCK_UDR)
+#define UBRRH                                MOCK_REGISTER8(MOCK_UBRRH)
+#define UBRRL                                MOCK_REGISTER8(MOCK_UBRRL)
+#define ADMUX                                MOCK_REGISTER8(MOCK_ADMUX)
+#define ADCSRA                               MOCK_REGISTER8(MOCK_ADCSRA)
+#define ADC                                  MOCK_REGISTER16(MOCK_ADC)
+#define SFIOR                                MOCK_REGISTER8(MOCK_SFIOR)
+#define TCCR1A                               MOCK_REGISTER8(MOCK_TCCR1A)
+#define TCCR1B                               MOCK_REGISTER8(MOCK_TCCR1B)
+#define TCNT1                                MOCK_REGISTER16(MOCK_TCNT1)
+#define OCR1A                                MOCK_REGISTER16(MOCK_OCR1A)
+#define OCR1B                                MOCK_REGISTER16(MOCK_OCR1B)
+#define ICR1                                 MOCK_REGISTER16(MOCK_ICR1)
+#define TIMSK                                MOCK_REGISTER8(MOCK_TIMSK)
+#define TIFR                                 MOCK_REGISTER8(MOCK_TIFR)
+#define TCCR0                                MOCK_REGISTER8(MOCK_TCCR0)
+#define TCNT0                                MOCK_REGISTER8(MOCK_TCNT0)
+#define OCR0                                 MOCK_REGISTER8(MOCK_OCR0)
+#define EEAR                                 MOCK_REGISTER16(MOCK_EEAR)
+#define EEDR                                 MOCK_REGISTER8(MOCK_EEDR)
+#define EECR                                 MOCK_REGISTER8(MOCK_EECR)
+#define MCUCR                                MOCK_REGISTER8(MOCK_MCUCR)
+#define MCUCSR                               MOCK_REGISTER8(MOCK_MCUCSR)
+#define GICR                                 MOCK_REGISTER8(MOCK_GICR)
+#define GIFR                                 MOCK_REGISTER8(MOCK_GIFR)
+#define SREG                                 MOCK_REGISTER8(MOCK_SREG)
+
+/*******************************************************************************************
+ *                                      Bits Definitions                                   *
+ *******************************************************************************************/
+
+/* UCSRA */
+#define RXC                                  7
+#define TXC                                  6
+#define UDRE                                 5
+#define FE                                   4
+#define DOR                                  3
+#define PE                                   2
+#define U2X                                  1
+#define MPCM                                 0
+
+/* UCSRB */
+#define RXCIE                                7
+#define TXCIE                                6
+#define UDRIE                                5
+#define RXEN                                 4
+#define TXEN                                 3
+#define UCSZ2                                2
+#define RXB8                                 1
+#define TXB8                                 0
+
+/* UCSRC */
+#define URSEL                                7
+#define UMSEL                                6
+#define UPM1                                 5
+#define UPM0                                 4
+#define USBS                                 3
+#define UCSZ1                                2
+#define UCSZ0                                1
+#define UCPOL                                0
+
+/* ADMUX */
+#define REFS1                                7
+#define REFS0                                6
+#define ADLAR                                5
+
+/* ADCSRA */
+#define ADEN                                 7
+#define ADSC                                 6
+#define ADATE                                5
+#define ADIF                                 4
+#define ADIE                                 3
+#define ADPS2                                2
+#define ADPS1                                1
+#define ADPS0                                0
+
+/* TCCR1A */
+#define COM1A1                               7
+#define COM1A0                               6
+#define COM1B1                               5
+#define COM1B0                               4
+#define FOC1A                                3
+#define FOC1B                                2
+#define WGM11                                1
+#define WGM10                                0
+
+/* TCCR1B */
+#define ICNC1                                7
+#define ICES1                                6
+#define WGM13                                4
+#define WGM12                                3
+#define CS12                                 2
+#define CS11                                 1
+#define CS10                                 0
+
+/* TIMSK */
+#define OCIE2                                7
+#define TOIE2                                6
+#define TICIE1                               5
+#define OCIE1A                               4
+#define OCIE1B                               3
+#define TOIE1                                2
+#define OCIE0                                1
+#define TOIE0                                0
+
+/* TIFR */
+#define OCF2                                 7
+#define TOV2                                 6
+#define ICF1                                 5
+#define OCF1A                                4
+#define OCF1B                                3
+#define TOV1                                 2
+#define OCF0                                 1
+#define TOV0                                 0
+
+/* TCCR0 */
+#define FOC0                                 7
+#define WGM00                                6
+#define COM01                                5
+#define COM00                                4
+#define WGM01                                3
+#define CS02                                 2
+#define CS01                                 1
+#define CS00                                 0
+
+/* EECR */
+#define EERIE                                3
+#define EEMWE                                2
+#define EEWE                                 1
+#define EERE                                 0
+
+/* MCUCR */
+#define SE                                   7
+#define SM2                                  6
+#define SM1                                  5
+#define SM0                                  4
+#define ISC11                                3
+#define ISC10                                2
+#define ISC01                                1
+#define ISC00                                0
+
+/* GICR */
+#define INT1                                 7
+#define INT0                                 6
+#define INT2                                 5
+
+/* SREG */
+#define SREG_I                               7
+
+#endif /* MOCK_AVR_IO_H_ */
@@ -0,0 +1,20 @@
+/*******************************************************************************************************************
+ * File Name: pgmspace.h
+ * Date: 19/10/2026
+ * Driver: Host Mock of <avr/pgmspace.h> for the ATmega32 Unit Tests
+ * Author: Youssef Zaki
+ ******************************************************************************************************************/
+#ifndef MOCK_AVR_PGMSPACE_H_
+#define MOCK_AVR_PGMSPACE_H_
+
+#include <stdint.h>
+
+/* The host has one address space, the flash data is plain constant data */
+#define PROGMEM
+#define PSTR(STR)                            (STR)
+
+#define pgm_read_byte(ADDRESS)               (*(const uint8_t *)(ADDRESS))
+#define pgm_read_word(ADDRESS)               (*(const uint16_t *)(ADDRESS))
+#define pgm_read_ptr(ADDRESS)                (*(const void * const *)(ADDRESS))
+
+#endif /* MOCK_AVR_PGMSPACE_H_ */
@@ -0,0 +1,23 @@
+/*******************************************************************************************************************
+ * File Name: delay.h
+ * Date: 19/10/2026
+ * Driver: Host Mock of <util/delay.h> for the ATmega32 Unit Tests
+ * Author: Youssef Zaki
+ ******************************************************************************************************************/
+#ifndef MOCK_UTIL_DELAY_H_
+#define MOCK_UTIL_DELAY_H_
+
+#include <stdint.h>
+
+/*
+ * Description:
+ * Log a busy wait between the register writes instead of waiting (see Mock.c).
+ */
+void Mock_DelayUs(uint32_t Us);
+void Mock_DelayCycles(uint32_t Cycles);
+
+#define _delay_us(US)                        Mock_DelayUs((uint32_t)(US))
+#define _delay_ms(MS)                        Mock_DelayUs((uint32_t)(MS) * 1000UL)
+#define __builtin_avr_delay_cycles(CYCLES)   Mock_DelayCycles((uint32_t)(CYCLES))
+
+#endif /* MOCK_UTIL_DELAY_H_ */
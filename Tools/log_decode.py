@@ -0,0 +1,133 @@
+#!/usr/bin/env python3
+"""
+File Name: log_decode.py
+Date: 19/10/2026
+Description: Host-side decoder for the EEPROM history log dump of MCU1 (LOGGER.c).
+Author: Youssef Zaki
+
+Capture the bytes of the bus after sending the dump command to MCU1:
+    ADDRESS=0x01, SOF=0x7E, SOURCE=0x7F, TOPIC=0x7C, LEN=1, PAYLOAD=0x01, CRC8
+(the address character has the ninth bit set). The dump comes back as link frames
+    SOF SOURCE TOPIC=0x7B LEN PAYLOAD CRC8
+with PAYLOAD = 0x01 <index:u16> <records>, where every record is <tag:u8> <data:u8>:
+    tag bits 7..6 = 00 absolute temperature, 01 two 4-bit signed deltas (0x8 = none),
+                    10 event, 11 erased; tag bits 5..0 = sequence number.
+The last frame has no records and carries the number of records as index.
+Samples are Sample_Period_Ms apart (10 s by default); events are placed between the samples.
+
+Usage:
+    log_decode.py capture.bin [--period 10]
+"""
+import argparse
+import sys
+
+SOF = 0x7E
+REPLY_TOPIC = 0x7B
+COMMAND_DUMP_LOG = 0x01
+
+EVENT_NAMES = {
+    0: "BOOT",
+    1: "FAN_OFF",
+    2: "FAN_ON",
+    3: "EMERGENCY_OFF",
+    4: "EMERGENCY_ON",
+    5: "LINK_DOWN",
+    6: "LINK_UP",
+    7: "WATCHDOG_RESET",
+    8: "RATE_ALARM_OFF",
+    9: "RATE_ALARM_ON",
+}
+
+
+def crc8(data):
+    crc = 0
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x07) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+def parse_frames(data):
+    """Yield (source, topic, payload) of every frame with a good CRC."""
+    i = 0
+    while i + 5 <= len(data):
+        if data[i] != SOF:
+            i += 1
+            continue
+        source, topic, length = data[i + 1], data[i + 2], data[i + 3]
+        end = i + 4 + length
+        if end >= len(data):
+            break
+        if crc8(data[i + 1:end]) == data[end]:
+            yield source, topic, data[i + 4:end]
+            i = end + 1
+        else:
+            i += 1
+
+
+def collect_records(data):
+    records = {}
+    total = None
+    for _, topic, payload in parse_frames(data):
+        if topic != REPLY_TOPIC or len(payload) < 3 or payload[0] != COMMAND_DUMP_LOG:
+            continue
+        index = payload[1] | (payload[2] << 8)
+        body = payload[3:]
+        if not body:
+            total = index
+            continue
+        for k in range(0, len(body) - 1, 2):
+            records[index + k // 2] = (body[k], body[k + 1])
+    count = total if total is not None else (max(records) + 1 if records else 0)
+    missing = [n for n in range(count) if n not in records]
+    return [records[n] for n in range(count) if n in records], missing
+
+
+def nibble(value):
+    return value - 16 if value & 0x08 else value
+
+
+def decode(records, period, out):
+    time = 0.0
+    temperature = None
+    for tag, data in records:
+        kind = tag & 0xC0
+        if kind == 0x00:
+            temperature = data
+            out.write("%8.0f s  %3d C\n" % (time, temperature))
+            time += period
+        elif kind == 0x40:
+            for delta in (data >> 4, data & 0x0F):
+                if delta == 0x08:
+                    continue
+                if temperature is None:
+                    out.write("%8.0f s  ? C (no absolute sample yet)\n" % time)
+                else:
+                    temperature += nibble(delta)
+                    out.write("%8.0f s  %3d C\n" % (time, temperature))
+                time += period
+        elif kind == 0x80:
+            out.write("%8.0f s  event %s\n" % (time, EVENT_NAMES.get(data, "EVENT_%d" % data)))
+            if data == 0:
+                # A reset restarts the sampling
+                temperature = None
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("capture", help="raw bytes captured from the bus")
+    parser.add_argument("--period", type=float, default=10.0, help="sample period in seconds")
+    args = parser.parse_args()
+
+    with open(args.capture, "rb") as f:
+        data = f.read()
+
+    records, missing = collect_records(data)
+    if missing:
+        sys.stderr.write("warning: %d records missing from the capture\n" % len(missing))
+    decode(records, args.period, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+"""
+File Name: prof_decode.py
+Date: 19/10/2026
+Description: Host-side decoder for the profiler table read over the link (PROFILER.c).
+Author: Youssef Zaki
+
+Send one GET command per section to the node (PROFILER_ENABLE = 1 build):
+    ADDRESS, SOF=0x7E, SOURCE=0x7F, TOPIC=0x7C, LEN=2, PAYLOAD=0x20 <id>, CRC8
+(the address character has the ninth bit set) and capture the bytes of the bus. Every row comes
+back as a link frame
+    SOF SOURCE TOPIC=0x7B LEN=14 PAYLOAD CRC8
+with PAYLOAD = 0x20 <id:u8> <status:u8> <cycles_per_count:u8> <calls:u16> <min:u16> <max:u16> <total:u32>
+(little endian, times in counts of cycles_per_count CPU cycles).
+
+Usage:
+    prof_decode.py capture.bin [--source 1]
+"""
+import argparse
+import struct
+import sys
+
+SOF = 0x7E
+REPLY_TOPIC = 0x7B
+COMMAND_GET = 0x20
+STATUS_OK = 0x00
+
+# Profiler_SectionId (PROFILER.h)
+SECTION_NAMES = {
+    0: "LM35_GetTemperature",
+    1: "LCD_IntegerToString",
+    2: "Link_Poll",
+    3: "DcMotor_Rotate",
+    4: "Rate_Update",
+}
+
+
+def crc8(data):
+    crc = 0
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x07) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+def parse_frames(data):
+    """Yield (source, topic, payload) of every frame with a good CRC."""
+    i = 0
+    while i + 5 <= len(data):
+        if data[i] != SOF:
+            i += 1
+            continue
+        source, topic, length = data[i + 1], data[i + 2], data[i + 3]
+        end = i + 4 + length
+        if end >= len(data):
+            break
+        if crc8(data[i + 1:end]) == data[end]:
+            yield source, topic, data[i + 4:end]
+            i = end + 1
+        else:
+            i += 1
+
+
+def collect_rows(data, source):
+    """Keep the last reply of every section of the source node."""
+    rows = {}
+    for frame_source, topic, payload in parse_frames(data):
+        if frame_source != source or topic != REPLY_TOPIC or len(payload) != 14 or payload[0] != COMMAND_GET:
+            continue
+        section, status, cycles, calls, low, high, total = struct.unpack_from("<BBBHHHI", payload, 1)
+        if status == STATUS_OK:
+            rows[section] = (cycles, calls, low, high, total)
+    return rows
+
+
+def write_table(rows, out):
+    out.write("id name calls min max avg total\n")
+    for section in sorted(rows):
+        cycles, calls, low, high, total = rows[section]
+        name = SECTION_NAMES.get(section, "SECTION_%d" % section)
+        if calls == 0:
+            out.write("%d %s 0 - - - -\n" % (section, name))
+        else:
+            out.write("%d %s %d %d %d %d %d\n" % (section, name, calls, low * cycles, high * cycles,
+                                                  total * cycles // calls, total * cycles))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("capture", help="raw bytes captured from the bus")
+    parser.add_argument("--source", type=lambda text: int(text, 0), default=1,
+                        help="node address of the profiled node (1 = MCU1, 0x10.. = MCU2)")
+    args = parser.parse_args()
+
+    with open(args.capture, "rb") as capture:
+        data = capture.read()
+
+    rows = collect_rows(data, args.source)
+    if not rows:
+        sys.stderr.write("warning: no profiler reply in the capture\n")
+    write_table(rows, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
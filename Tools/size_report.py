@@ -0,0 +1,105 @@
+#!/usr/bin/env python3
+"""
+File Name: size_report.py
+Date: 19/10/2026
+Description: SRAM usage report of the MCU1 / MCU2 builds (ATmega32, 2 KB SRAM).
+Author: Youssef Zaki
+
+Two reports:
+1. ELF report: SRAM taken by .data (initialized variables and string literals, copied from the
+   flash at startup) and .bss, read with avr-size. With --baseline the difference to an older
+   build is shown, e.g. the SRAM saved by moving the strings to PROGMEM:
+       size_report.py MCU1/Debug/MCU1.elf --baseline old/MCU1.elf
+2. Source report (--scan DIR, no build needed): every string literal that still lands in SRAM,
+   i.e. it is not wrapped in PSTR() and not a PROGMEM array, with its size in bytes:
+       size_report.py --scan MCU1
+"""
+import argparse
+import os
+import re
+import subprocess
+import sys
+
+SRAM_SIZE = 2048
+
+LITERAL = re.compile(r'"((?:[^"\\]|\\.)*)"')
+ESCAPE = re.compile(r'\\(x[0-9a-fA-F]+|[0-7]{1,3}|.)')
+
+
+def elf_sections(path, tool):
+    """Return {section: size} of an ELF file from 'avr-size -A'."""
+    output = subprocess.check_output([tool, "-A", path], universal_newlines=True)
+    sections = {}
+    for line in output.splitlines():
+        fields = line.split()
+        if len(fields) >= 2 and fields[0].startswith(".") and fields[1].isdigit():
+            sections[fields[0]] = int(fields[1])
+    return sections
+
+
+def sram_usage(sections):
+    data = sections.get(".data", 0)
+    bss = sections.get(".bss", 0) + sections.get(".noinit", 0)
+    return data, bss
+
+
+def literal_size(text):
+    """Bytes taken by a C string literal including the terminating zero."""
+    return len(ESCAPE.sub("x", text)) + 1
+
+
+def scan_sources(directory):
+    """Yield (file, line, literal, size) of the string literals which are copied in SRAM."""
+    for name in sorted(os.listdir(directory)):
+        if not name.endswith(".c"):
+            continue
+        with open(os.path.join(directory, name)) as f:
+            for number, line in enumerate(f, 1):
+                code = line.split("//")[0]
+                stripped = code.strip()
+                if stripped.startswith(("#", "*", "/*")) or "PROGMEM" in code:
+                    continue
+                for match in LITERAL.finditer(code):
+                    before = code[:match.start()].rstrip()
+                    if before.endswith("PSTR("):
+                        continue
+                    yield name, number, match.group(1), literal_size(match.group(1))
+
+
+def report_elf(args):
+    data, bss = sram_usage(elf_sections(args.elf, args.size_tool))
+    print("%s: .data %d + .bss %d = %d bytes of %d SRAM (%.1f%%)"
+          % (args.elf, data, bss, data + bss, SRAM_SIZE, 100.0 * (data + bss) / SRAM_SIZE))
+    if args.baseline:
+        old_data, old_bss = sram_usage(elf_sections(args.baseline, args.size_tool))
+        print("%s: .data %d + .bss %d = %d bytes" % (args.baseline, old_data, old_bss, old_data + old_bss))
+        print("SRAM saved: %d bytes" % ((old_data + old_bss) - (data + bss)))
+
+
+def report_scan(directory):
+    total = 0
+    for name, number, text, size in scan_sources(directory):
+        print('%s:%d: %3d bytes "%s"' % (name, number, size, text))
+        total += size
+    print("%s: %d bytes of string literals in SRAM" % (directory, total))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("elf", nargs="?", help="ELF file of the build")
+    parser.add_argument("--baseline", help="ELF file of an older build to compare with")
+    parser.add_argument("--scan", metavar="DIR", help="list the string literals of DIR/*.c which are in SRAM")
+    parser.add_argument("--size-tool", default="avr-size", help="avr-size executable")
+    args = parser.parse_args()
+
+    if args.scan:
+        report_scan(args.scan)
+    if args.elf:
+        report_elf(args)
+    if not args.scan and not args.elf:
+        parser.print_usage()
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
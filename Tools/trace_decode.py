@@ -0,0 +1,180 @@
+#!/usr/bin/env python3
+"""
+File Name: trace_decode.py
+Date: 19/10/2026
+Description: Host-side decoder for the trace blocks sent by Trace_StreamTask (TRACE.c).
+Author: Youssef Zaki
+
+Capture the bytes of the bus. Every block is the payload of a link frame to the service PC
+    SOF SOURCE TOPIC=0x78 LEN PAYLOAD CRC8
+(little endian):
+    block  = <records:u8> <dropped:u8> <ticks:u16> record * records
+    record = <id:u8> <arg:u16> <time_stamp:u16>
+
+TICKS is SysTick_GetTicks() (ms, wraps at 16 bits) when the block was sent. A node sends an empty
+block at least every 10 s, so TICKS is unwrapped from block to block of the same source.
+The time stamp of a record is SysTick_GetFineTime(): Timer0 counts of SYSTICK_CYCLES_PER_COUNT
+cycles that wrap at 16 bits. A record is placed at the last time before its block with the same
+16-bit value, so it must be sent less than one wrap period (524 ms at 1 MHz with a /8 pre-scalar)
+after it was logged; records far apart in time are not a problem.
+
+Usage:
+    trace_decode.py capture.bin [--f-cpu 1000000] [--cycles-per-count 8] [--source 1]
+                                [--vcd out.vcd] [--chrome out.json]
+"""
+import argparse
+import json
+import struct
+import sys
+
+SOF = 0x7E
+TRACE_TOPIC = 0x78
+HEADER_SIZE = 4
+RECORD_SIZE = 5
+
+EVENT_NAMES = {
+    0: "ISR_ENTRY",
+    1: "UART_TX",
+    2: "UART_RX",
+    3: "ADC_SAMPLE",
+    4: "STATE_CHANGE",
+    5: "PWM_UPDATE",
+    6: "LINK_STATE",
+    7: "BOOT_DONE",
+}
+
+ISR_NAMES = {
+    0: "ADC",
+    1: "TIMER1_OVF",
+    2: "TIMER1_COMPA",
+}
+
+
+def crc8(data):
+    crc = 0
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x07) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+def parse_frames(data):
+    """Yield (source, topic, payload) of every frame with a good CRC."""
+    i = 0
+    while i + 5 <= len(data):
+        if data[i] != SOF:
+            i += 1
+            continue
+        source, topic, length = data[i + 1], data[i + 2], data[i + 3]
+        end = i + 4 + length
+        if end >= len(data):
+            break
+        if crc8(data[i + 1:end]) == data[end]:
+            yield source, topic, data[i + 4:end]
+            i = end + 1
+        else:
+            i += 1
+
+
+def parse_blocks(data, source):
+    """Yield (ticks, dropped, records) of every trace block of the source node."""
+    for frame_source, topic, payload in parse_frames(data):
+        if frame_source != source or topic != TRACE_TOPIC or len(payload) < HEADER_SIZE:
+            continue
+        count, dropped, ticks = struct.unpack_from("<BBH", payload, 0)
+        if len(payload) != HEADER_SIZE + count * RECORD_SIZE:
+            continue
+        records = [struct.unpack_from("<BHH", payload, HEADER_SIZE + n * RECORD_SIZE) for n in range(count)]
+        yield ticks, dropped, records
+
+
+def unwrap(blocks, counts_per_tick, us_per_count):
+    """Convert the 16-bit time stamps into a monotonic time in microseconds."""
+    previous = None
+    base = 0
+    for ticks, dropped, records in blocks:
+        if previous is not None and ticks < previous:
+            base += 0x10000
+        previous = ticks
+        # Latest fine time the records can have: the end of the tick in which the block was sent
+        reference = (base + ticks + 1) * counts_per_tick
+        for n, (event_id, arg, stamp) in enumerate(records):
+            counts = reference - ((reference - stamp) & 0xFFFF)
+            yield counts * us_per_count, event_id, arg, dropped if n == 0 else 0
+
+
+def describe(event_id, arg):
+    name = EVENT_NAMES.get(event_id, "EVENT_%d" % event_id)
+    if event_id == 0:
+        return name, ISR_NAMES.get(arg, str(arg))
+    if event_id in (1, 2):
+        return name, "0x%02X" % (arg & 0xFF)
+    return name, str(arg)
+
+
+def write_timeline(events, out):
+    for time_us, event_id, arg, dropped in events:
+        if dropped:
+            out.write("%12.1f us  -- %d record(s) dropped --\n" % (time_us, dropped))
+        name, value = describe(event_id, arg)
+        out.write("%12.1f us  %-13s %s\n" % (time_us, name, value))
+
+
+def write_vcd(events, path):
+    """One wire per event type (pulses on each event) plus the last argument as a 16-bit bus."""
+    ids = sorted({event_id for _, event_id, _, _ in events})
+    codes = {event_id: chr(33 + 2 * i) for i, event_id in enumerate(ids)}
+    buses = {event_id: chr(34 + 2 * i) for i, event_id in enumerate(ids)}
+    with open(path, "w") as vcd:
+        vcd.write("$timescale 1us $end\n$scope module trace $end\n")
+        for event_id in ids:
+            name = EVENT_NAMES.get(event_id, "EVENT_%d" % event_id)
+            vcd.write("$var wire 1 %s %s $end\n" % (codes[event_id], name))
+            vcd.write("$var wire 16 %s %s_ARG $end\n" % (buses[event_id], name))
+        vcd.write("$upscope $end\n$enddefinitions $end\n#0\n")
+        for event_id in ids:
+            vcd.write("0%s\n" % codes[event_id])
+        for time_us, event_id, arg, _ in events:
+            vcd.write("#%d\n1%s\nb%s %s\n" % (int(time_us), codes[event_id], format(arg, "016b"), buses[event_id]))
+            vcd.write("#%d\n0%s\n" % (int(time_us) + 1, codes[event_id]))
+
+
+def write_chrome(events, path):
+    """Chrome trace (chrome://tracing, Perfetto) instant events, one thread per event type."""
+    trace = []
+    for time_us, event_id, arg, _ in events:
+        name, value = describe(event_id, arg)
+        trace.append({"name": name, "ph": "i", "s": "t", "ts": time_us,
+                      "pid": 1, "tid": event_id, "args": {"value": value}})
+    with open(path, "w") as chrome:
+        json.dump({"traceEvents": trace, "displayTimeUnit": "ms"}, chrome)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("capture", help="raw bytes captured from the bus")
+    parser.add_argument("--f-cpu", type=float, default=1000000.0)
+    parser.add_argument("--cycles-per-count", type=int, default=8)
+    parser.add_argument("--source", type=lambda text: int(text, 0), default=1,
+                        help="node address of the traced node (1 = MCU1, 0x10.. = MCU2)")
+    parser.add_argument("--vcd", help="write a VCD file")
+    parser.add_argument("--chrome", help="write a Chrome trace JSON file")
+    args = parser.parse_args()
+
+    with open(args.capture, "rb") as capture:
+        data = capture.read()
+
+    us_per_count = args.cycles_per_count * 1e6 / args.f_cpu
+    counts_per_tick = int(args.f_cpu / args.cycles_per_count / 1000)
+    events = list(unwrap(parse_blocks(data, args.source), counts_per_tick, us_per_count))
+
+    write_timeline(events, sys.stdout)
+    if args.vcd:
+        write_vcd(events, args.vcd)
+    if args.chrome:
+        write_chrome(events, args.chrome)
+
+
+if __name__ == "__main__":
+    main()